@@ -0,0 +1,585 @@
+#ifndef ASYNCLOG_H
+#define ASYNCLOG_H
+/**
+ * @file      asynclog.h
+ * @brief     Logging with deferred formatting on a background writer thread
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * LOG_DEBUG(), LOG_INFO(), LOG_WARN() and LOG_ERROR() take a printf format
+ * and its arguments. Messages below ASYNCLOG_LEVEL (info by default) compile
+ * to nothing, their arguments are not even evaluated, so loaders can keep
+ * per-vertex diagnostics and build them in with -DASYNCLOG_LEVEL=0.
+ *
+ * The calling thread only copies the format pointer and the raw arguments
+ * into a slot of a lock free ring, strings are copied since they may not
+ * outlive the call. A writer thread formats the slots and writes them,
+ * debug and info to stdout, warnings and errors to stderr, a newline is
+ * appended to every message. When the ring is full debug and info messages
+ * are dropped and counted instead of blocking, the writer reports the
+ * count. Warnings and errors wait for a free slot, they are never lost.
+ *
+ * The format must be a string literal. Up to ASYNCLOG_MAX_ARGS arguments and
+ * ASYNCLOG_STRING_BYTES of string arguments are kept per message, longer
+ * strings are truncated. %n is not supported.
+ *
+ * Used from C and C++, header only. Exactly one translation unit of a
+ * program defines ASYNCLOG_IMPLEMENTATION before including it:
+ *
+ *   #define ASYNCLOG_IMPLEMENTATION
+ *   #include "asynclog.h"
+ *
+ * The writer starts with the first message and drains the ring at exit,
+ * link with -lpthread.
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#define ASYNCLOG_LEVEL_DEBUG 0
+#define ASYNCLOG_LEVEL_INFO  1
+#define ASYNCLOG_LEVEL_WARN  2
+#define ASYNCLOG_LEVEL_ERROR 3
+#define ASYNCLOG_LEVEL_NONE  4
+
+#ifndef ASYNCLOG_LEVEL
+#define ASYNCLOG_LEVEL ASYNCLOG_LEVEL_INFO
+#endif
+
+#if ASYNCLOG_LEVEL <= ASYNCLOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) asyncLog(ASYNCLOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) ((void)0)
+#endif
+
+#if ASYNCLOG_LEVEL <= ASYNCLOG_LEVEL_INFO
+#define LOG_INFO(...) asyncLog(ASYNCLOG_LEVEL_INFO, __VA_ARGS__)
+#else
+#define LOG_INFO(...) ((void)0)
+#endif
+
+#if ASYNCLOG_LEVEL <= ASYNCLOG_LEVEL_WARN
+#define LOG_WARN(...) asyncLog(ASYNCLOG_LEVEL_WARN, __VA_ARGS__)
+#else
+#define LOG_WARN(...) ((void)0)
+#endif
+
+#if ASYNCLOG_LEVEL <= ASYNCLOG_LEVEL_ERROR
+#define LOG_ERROR(...) asyncLog(ASYNCLOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+#define LOG_ERROR(...) ((void)0)
+#endif
+
+/**
+ * @brief queue one message, use the LOG_ macros instead
+ */
+void asyncLog(int level, const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+/**
+ * @brief write out every queued message and stop the writer, called at exit
+ *
+ * Messages logged afterwards are written synchronously.
+ */
+void asyncLogShutdown(void);
+
+#ifdef ASYNCLOG_IMPLEMENTATION
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* slots in the ring, a power of two */
+#define ASYNCLOG_CAPACITY 4096U
+
+#define ASYNCLOG_MAX_ARGS     8
+#define ASYNCLOG_STRING_BYTES 160
+
+/* longest formatted message, longer ones are truncated */
+#define ASYNCLOG_LINE_BYTES 1024
+
+/* writer sleep when the ring is empty */
+#define ASYNCLOG_IDLE_NS 1000000L
+
+enum AsyncLogType
+{
+    ASYNCLOG_NONE, // %% or unsupported
+    ASYNCLOG_INT,
+    ASYNCLOG_UINT,
+    ASYNCLOG_LONG,
+    ASYNCLOG_ULONG,
+    ASYNCLOG_LLONG,
+    ASYNCLOG_ULLONG,
+    ASYNCLOG_SIZE,
+    ASYNCLOG_PTRDIFF,
+    ASYNCLOG_DOUBLE,
+    ASYNCLOG_LDOUBLE,
+    ASYNCLOG_STRING,
+    ASYNCLOG_POINTER
+};
+
+/* one conversion of the format */
+struct AsyncLogSpec
+{
+    const char       *start;  // at the %
+    size_t            length; // up to and including the conversion character
+    int               nStars; // * width and precision, each takes an int argument
+    enum AsyncLogType type;
+};
+
+union AsyncLogArg
+{
+    long long          i;
+    unsigned long long u;
+    long double        ld;
+    const void        *p;
+    size_t             offset; // of a string in AsyncLogRecord::strings
+};
+
+struct AsyncLogRecord
+{
+    uint64_t          sequence; // ring position this slot is ready for, see asyncLog()
+    const char       *format;
+    int               level;
+    uint32_t          nArgs;
+    union AsyncLogArg args[ASYNCLOG_MAX_ARGS];
+    char              strings[ASYNCLOG_STRING_BYTES];
+};
+
+static struct
+{
+    struct AsyncLogRecord slots[ASYNCLOG_CAPACITY];
+    uint64_t              enqueue; // next position producers claim
+    uint64_t              dequeue; // next position the writer reads, writer only
+    uint64_t              dropped;
+    int                   isRunning;
+    int                   shouldStop;
+    pthread_t             writer;
+} asyncLogRing;
+
+static pthread_once_t asyncLogOnce = PTHREAD_ONCE_INIT;
+
+/* @return the character after the conversion, NULL at the end of the format */
+static const char *asyncLogNextSpec(const char *at, struct AsyncLogSpec *spec)
+{
+    int length = 0; // 1 h, 2 hh, 3 l, 4 ll, 5 L, 6 z, 7 j, 8 t
+
+    at = strchr(at, '%');
+    if (NULL == at)
+        return NULL;
+
+    spec->start  = at++;
+    spec->nStars = 0;
+    spec->type   = ASYNCLOG_NONE;
+
+    while ('\0' != *at && NULL != strchr("-+ #0'", *at))
+        ++at;
+    if ('*' == *at)
+    {
+        ++spec->nStars;
+        ++at;
+    }
+    while (*at >= '0' && *at <= '9')
+        ++at;
+    if ('.' == *at)
+    {
+        ++at;
+        if ('*' == *at)
+        {
+            ++spec->nStars;
+            ++at;
+        }
+        while (*at >= '0' && *at <= '9')
+            ++at;
+    }
+
+    switch (*at)
+    {
+        case 'h':
+            length = 'h' == at[1] ? 2 : 1;
+            at += length;
+            break;
+        case 'l':
+            length = 'l' == at[1] ? 4 : 3;
+            at += length - 2;
+            break;
+        case 'L':
+        case 'q':
+            length = 'L' == *at ? 5 : 4;
+            ++at;
+            break;
+        case 'z':
+            length = 6;
+            ++at;
+            break;
+        case 'j':
+            length = 7;
+            ++at;
+            break;
+        case 't':
+            length = 8;
+            ++at;
+            break;
+        default:
+            break;
+    }
+
+    switch (*at)
+    {
+        case 'd':
+        case 'i':
+        case 'c':
+            spec->type = 3 == length ? ASYNCLOG_LONG : 4 == length || 7 == length ? ASYNCLOG_LLONG : 6 == length ? ASYNCLOG_SIZE : 8 == length ? ASYNCLOG_PTRDIFF : ASYNCLOG_INT;
+            break;
+        case 'u':
+        case 'x':
+        case 'X':
+        case 'o':
+            spec->type = 3 == length ? ASYNCLOG_ULONG : 4 == length || 7 == length ? ASYNCLOG_ULLONG : 6 == length ? ASYNCLOG_SIZE : 8 == length ? ASYNCLOG_PTRDIFF : ASYNCLOG_UINT;
+            break;
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            spec->type = 5 == length ? ASYNCLOG_LDOUBLE : ASYNCLOG_DOUBLE;
+            break;
+        case 's':
+            spec->type = ASYNCLOG_STRING;
+            break;
+        case 'p':
+            spec->type = ASYNCLOG_POINTER;
+            break;
+        default:
+            break;
+    }
+
+    if ('\0' != *at)
+        ++at;
+    spec->length = (size_t)(at - spec->start);
+    return at;
+}
+
+/* turn a record back into text, runs on the writer */
+static void asyncLogFormat(const struct AsyncLogRecord *record, char *line, size_t size)
+{
+    const char         *at    = record->format;
+    size_t              used  = 0U;
+    uint32_t            arg   = 0U;
+    struct AsyncLogSpec spec;
+
+    line[0] = '\0';
+    for (const char *next = asyncLogNextSpec(at, &spec); used + 1U < size; next = asyncLogNextSpec(at, &spec))
+    {
+        size_t literal = NULL != next ? (size_t)(spec.start - at) : strlen(at);
+        if (literal > size - used - 1U)
+            literal = size - used - 1U;
+        memcpy(line + used, at, literal);
+        used += literal;
+        line[used] = '\0';
+        if (NULL == next || used + 1U >= size)
+            break;
+
+        char piece[32];
+        int  stars[2] = {0, 0};
+        int  written  = 0;
+
+        if (spec.length >= sizeof(piece) || arg + (uint32_t)spec.nStars + (ASYNCLOG_NONE != spec.type) > record->nArgs)
+        {
+            /* arguments beyond ASYNCLOG_MAX_ARGS were not kept, show the conversion as is */
+            written = snprintf(line + used, size - used, "%.*s", (int)spec.length, spec.start);
+        }
+        else
+        {
+            memcpy(piece, spec.start, spec.length);
+            piece[spec.length] = '\0';
+            for (int star = 0; star < spec.nStars; ++star)
+                stars[star] = (int)record->args[arg++].i;
+
+#define ASYNCLOG_PRINT(value)                                                                         \
+    (0 == spec.nStars   ? snprintf(line + used, size - used, piece, value)                            \
+     : 1 == spec.nStars ? snprintf(line + used, size - used, piece, stars[0], value)                  \
+                        : snprintf(line + used, size - used, piece, stars[0], stars[1], value))
+
+            const union AsyncLogArg *value = &record->args[arg];
+            switch (spec.type)
+            {
+                case ASYNCLOG_INT:
+                    written = ASYNCLOG_PRINT((int)value->i);
+                    break;
+                case ASYNCLOG_UINT:
+                    written = ASYNCLOG_PRINT((unsigned)value->u);
+                    break;
+                case ASYNCLOG_LONG:
+                    written = ASYNCLOG_PRINT((long)value->i);
+                    break;
+                case ASYNCLOG_ULONG:
+                    written = ASYNCLOG_PRINT((unsigned long)value->u);
+                    break;
+                case ASYNCLOG_LLONG:
+                    written = ASYNCLOG_PRINT(value->i);
+                    break;
+                case ASYNCLOG_ULLONG:
+                    written = ASYNCLOG_PRINT(value->u);
+                    break;
+                case ASYNCLOG_SIZE:
+                    written = ASYNCLOG_PRINT((size_t)value->u);
+                    break;
+                case ASYNCLOG_PTRDIFF:
+                    written = ASYNCLOG_PRINT((ptrdiff_t)value->i);
+                    break;
+                case ASYNCLOG_DOUBLE:
+                    written = ASYNCLOG_PRINT((double)value->ld);
+                    break;
+                case ASYNCLOG_LDOUBLE:
+                    written = ASYNCLOG_PRINT(value->ld);
+                    break;
+                case ASYNCLOG_STRING:
+                    written = ASYNCLOG_PRINT(record->strings + value->offset);
+                    break;
+                case ASYNCLOG_POINTER:
+                    written = ASYNCLOG_PRINT(value->p);
+                    break;
+                default:
+                    written = snprintf(line + used, size - used, "%s", '%' == spec.start[spec.length - 1U] ? "%" : "");
+                    break;
+            }
+#undef ASYNCLOG_PRINT
+            if (ASYNCLOG_NONE != spec.type)
+                ++arg;
+        }
+
+        used += written > 0 ? (size_t)written : 0U;
+        if (used >= size)
+            used = size - 1U;
+        at = next;
+    }
+}
+
+static void asyncLogWrite(const struct AsyncLogRecord *record)
+{
+    char line[ASYNCLOG_LINE_BYTES];
+
+    asyncLogFormat(record, line, sizeof(line));
+    fprintf(record->level >= ASYNCLOG_LEVEL_WARN ? stderr : stdout, "%s\n", line);
+}
+
+static void *asyncLogWriter(void *arg)
+{
+    uint64_t reported = 0U;
+
+    (void)arg;
+    for (;;)
+    {
+        struct AsyncLogRecord *slot = &asyncLogRing.slots[asyncLogRing.dequeue & (ASYNCLOG_CAPACITY - 1U)];
+
+        if (__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) == asyncLogRing.dequeue + 1U)
+        {
+            asyncLogWrite(slot);
+            /* hand the slot to the producer one lap ahead */
+            __atomic_store_n(&slot->sequence, asyncLogRing.dequeue + ASYNCLOG_CAPACITY, __ATOMIC_RELEASE);
+            ++asyncLogRing.dequeue;
+            continue;
+        }
+
+        uint64_t dropped = __atomic_load_n(&asyncLogRing.dropped, __ATOMIC_RELAXED);
+        if (dropped != reported)
+        {
+            fprintf(stderr, "[%s] %llu messages dropped, the ring was full\n", __func__, (unsigned long long)(dropped - reported));
+            reported = dropped;
+        }
+
+        fflush(stdout);
+        fflush(stderr);
+
+        /* producers claimed every position before the stop request was seen, none is left unwritten */
+        if (__atomic_load_n(&asyncLogRing.shouldStop, __ATOMIC_ACQUIRE) && __atomic_load_n(&asyncLogRing.enqueue, __ATOMIC_ACQUIRE) == asyncLogRing.dequeue)
+            break;
+
+        struct timespec idle = {0, ASYNCLOG_IDLE_NS};
+        nanosleep(&idle, NULL);
+    }
+    return NULL;
+}
+
+static void asyncLogStart(void)
+{
+    for (uint32_t idx = 0U; idx < ASYNCLOG_CAPACITY; ++idx)
+        asyncLogRing.slots[idx].sequence = idx;
+
+    if (0 != pthread_create(&asyncLogRing.writer, NULL, asyncLogWriter, NULL))
+    {
+        fprintf(stderr, "[%s] failed to start the writer, logging synchronously\n", __func__);
+        return;
+    }
+    asyncLogRing.isRunning = 1;
+    atexit(asyncLogShutdown);
+}
+
+void asyncLogShutdown(void)
+{
+    if (!__atomic_load_n(&asyncLogRing.isRunning, __ATOMIC_ACQUIRE))
+        return;
+
+    __atomic_store_n(&asyncLogRing.shouldStop, 1, __ATOMIC_RELEASE);
+    pthread_join(asyncLogRing.writer, NULL);
+    __atomic_store_n(&asyncLogRing.isRunning, 0, __ATOMIC_RELEASE);
+}
+
+/* pull the arguments the format describes off the va_list, strings are copied */
+static void asyncLogCapture(struct AsyncLogRecord *record, va_list args)
+{
+    const char         *at      = record->format;
+    size_t              strings = 0U;
+    struct AsyncLogSpec spec;
+
+    record->nArgs = 0U;
+    while (NULL != (at = asyncLogNextSpec(at, &spec)))
+    {
+        if (record->nArgs + (uint32_t)spec.nStars + 1U > ASYNCLOG_MAX_ARGS)
+            return;
+
+        for (int star = 0; star < spec.nStars; ++star)
+            record->args[record->nArgs++].i = va_arg(args, int);
+
+        union AsyncLogArg *arg = &record->args[record->nArgs];
+        switch (spec.type)
+        {
+            case ASYNCLOG_INT:
+                arg->i = va_arg(args, int);
+                break;
+            case ASYNCLOG_UINT:
+                arg->u = va_arg(args, unsigned);
+                break;
+            case ASYNCLOG_LONG:
+                arg->i = va_arg(args, long);
+                break;
+            case ASYNCLOG_ULONG:
+                arg->u = va_arg(args, unsigned long);
+                break;
+            case ASYNCLOG_LLONG:
+                arg->i = va_arg(args, long long);
+                break;
+            case ASYNCLOG_ULLONG:
+                arg->u = va_arg(args, unsigned long long);
+                break;
+            case ASYNCLOG_SIZE:
+                arg->u = va_arg(args, size_t);
+                break;
+            case ASYNCLOG_PTRDIFF:
+                arg->i = va_arg(args, ptrdiff_t);
+                break;
+            case ASYNCLOG_DOUBLE:
+                arg->ld = va_arg(args, double);
+                break;
+            case ASYNCLOG_LDOUBLE:
+                arg->ld = va_arg(args, long double);
+                break;
+            case ASYNCLOG_STRING:
+            {
+                const char *string = va_arg(args, const char *);
+                size_t      length = 0U;
+
+                if (NULL == string)
+                    string = "(null)";
+                if (strings < ASYNCLOG_STRING_BYTES)
+                {
+                    length = strnlen(string, ASYNCLOG_STRING_BYTES - strings - 1U);
+                    memcpy(record->strings + strings, string, length);
+                    record->strings[strings + length] = '\0';
+                    arg->offset                       = strings;
+                    strings += length + 1U;
+                }
+                else
+                {
+                    /* out of room, point at the terminator of the last string */
+                    arg->offset = ASYNCLOG_STRING_BYTES - 1U;
+                }
+                break;
+            }
+            case ASYNCLOG_POINTER:
+                arg->p = va_arg(args, const void *);
+                break;
+            default:
+                continue;
+        }
+        ++record->nArgs;
+    }
+}
+
+void asyncLog(int level, const char *format, ...)
+{
+    struct AsyncLogRecord *slot     = NULL;
+    uint64_t               position = 0U;
+    va_list                args;
+
+    pthread_once(&asyncLogOnce, asyncLogStart);
+
+    if (!__atomic_load_n(&asyncLogRing.isRunning, __ATOMIC_ACQUIRE))
+    {
+        /* before the writer started or after shutdown, format right here */
+        struct AsyncLogRecord record;
+        record.format = format;
+        record.level  = level;
+        va_start(args, format);
+        asyncLogCapture(&record, args);
+        va_end(args);
+        asyncLogWrite(&record);
+        return;
+    }
+
+    /*
+     * Bounded multi producer ring: a slot whose sequence equals the position
+     * is free for that position, claiming the position is one compare and
+     * swap. The slot is published by storing position + 1, the writer frees
+     * it again by storing position + capacity.
+     */
+    position = __atomic_load_n(&asyncLogRing.enqueue, __ATOMIC_RELAXED);
+    for (;;)
+    {
+        slot             = &asyncLogRing.slots[position & (ASYNCLOG_CAPACITY - 1U)];
+        int64_t distance = (int64_t)(__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) - position);
+        if (0 == distance)
+        {
+            if (__atomic_compare_exchange_n(&asyncLogRing.enqueue, &position, position + 1U, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                break;
+        }
+        else if (distance < 0)
+        {
+            if (level < ASYNCLOG_LEVEL_WARN)
+            {
+                __atomic_fetch_add(&asyncLogRing.dropped, 1U, __ATOMIC_RELAXED);
+                return;
+            }
+            sched_yield();
+            position = __atomic_load_n(&asyncLogRing.enqueue, __ATOMIC_RELAXED);
+        }
+        else
+        {
+            position = __atomic_load_n(&asyncLogRing.enqueue, __ATOMIC_RELAXED);
+        }
+    }
+
+    slot->format = format;
+    slot->level  = level;
+    va_start(args, format);
+    asyncLogCapture(slot, args);
+    va_end(args);
+    __atomic_store_n(&slot->sequence, position + 1U, __ATOMIC_RELEASE);
+}
+
+#endif /* ASYNCLOG_IMPLEMENTATION */
+
+#endif
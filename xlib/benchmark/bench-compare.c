@@ -0,0 +1,160 @@
+/**
+ * @file      bench-compare.c
+ * @brief     Compare a benchmark report against a stored baseline
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * Usage: bench-compare [-t percent] [-d ms] baseline.json current.json
+ *
+ * Every timing of the baseline is compared with the same timing of the
+ * current report, sample reports of benchmark.h and kernel reports of micro
+ * alike. A timing regresses when it grew by more than percent (10 by
+ * default) and, for frame timings, by more than ms (0.05 by default, keeps
+ * tiny phases from flagging on noise). Exits with 1 when anything regressed,
+ * so it can gate a build.
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LEN_LINE    256
+#define LEN_NAME    64
+#define MAX_METRICS 64
+
+struct Metric
+{
+    char   name[LEN_NAME * 2]; // section.key
+    double value;
+};
+
+struct Report
+{
+    char          renderer[LEN_LINE];
+    struct Metric metrics[MAX_METRICS];
+    int           nMetrics;
+};
+
+/*
+  Reads the layout written by benchmark.h, one value per line: numbers
+  become metrics named after their section, "frame_ms.p95".
+ */
+static int readReport(const char *path, struct Report *report)
+{
+    char  buffer[LEN_LINE];
+    char  section[LEN_NAME] = "";
+    FILE *pFile             = fopen(path, "r");
+
+    memset(report, 0, sizeof(struct Report));
+    if (NULL == pFile)
+    {
+        fprintf(stderr, "[%s] cannot read %s\n", __func__, path);
+        return -1;
+    }
+
+    while (fgets(buffer, sizeof(buffer), pFile))
+    {
+        char   key[LEN_NAME];
+        char   text[LEN_LINE];
+        double value;
+
+        if (1 == sscanf(buffer, " \"%63[^\"]\": {", key) && strchr(buffer, '{'))
+        {
+            snprintf(section, sizeof(section), "%s", key);
+        }
+        else if (strchr(buffer, '}'))
+        {
+            section[0] = '\0';
+        }
+        else if (2 == sscanf(buffer, " \"%63[^\"]\": \"%255[^\"]\"", key, text))
+        {
+            if (0 == strcmp(key, "renderer"))
+                snprintf(report->renderer, sizeof(report->renderer), "%s", text);
+        }
+        else if (2 == sscanf(buffer, " \"%63[^\"]\": %lf", key, &value) && MAX_METRICS > report->nMetrics)
+        {
+            struct Metric *metric = &report->metrics[report->nMetrics++];
+            snprintf(metric->name, sizeof(metric->name), "%s%s%s", section, section[0] ? "." : "", key);
+            metric->value = value;
+        }
+    }
+
+    fclose(pFile);
+    return 0;
+}
+
+static const struct Metric *findMetric(const struct Report *report, const char *name)
+{
+    for (int idx = 0; idx < report->nMetrics; ++idx)
+    {
+        if (0 == strcmp(report->metrics[idx].name, name))
+            return &report->metrics[idx];
+    }
+    return NULL;
+}
+
+int main(int argc, char *argv[])
+{
+    double        threshold = 10.0; // percent
+    double        minDelta  = 0.05; // milliseconds
+    int           arg       = 1;
+    int           nRegressions = 0;
+    struct Report baseline, current;
+
+    for (; arg + 1 < argc && '-' == argv[arg][0]; arg += 2)
+    {
+        if (0 == strcmp(argv[arg], "-t"))
+            threshold = atof(argv[arg + 1]);
+        else if (0 == strcmp(argv[arg], "-d"))
+            minDelta = atof(argv[arg + 1]);
+        else
+            break;
+    }
+
+    if (arg + 2 != argc)
+    {
+        fprintf(stderr, "usage: %s [-t percent] [-d ms] baseline.json current.json\n", argv[0]);
+        return 2;
+    }
+
+    if (0 != readReport(argv[arg], &baseline) || 0 != readReport(argv[arg + 1], &current))
+        return 2;
+
+    if (0 != strcmp(baseline.renderer, current.renderer))
+        printf("warning: renderer changed from \"%s\" to \"%s\"\n", baseline.renderer, current.renderer);
+
+    printf("%-40s %14s %14s %9s\n", "metric", "baseline", "current", "change");
+    for (int idx = 0; idx < baseline.nMetrics; ++idx)
+    {
+        const struct Metric *base = &baseline.metrics[idx];
+        const struct Metric *now  = findMetric(&current, base->name);
+
+        /* only timings, lower is better */
+        if (NULL == strstr(base->name, "_ms") && NULL == strstr(base->name, "_ns"))
+            continue;
+
+        if (NULL == now)
+        {
+            printf("%-40s %14.4f %14s\n", base->name, base->value, "missing");
+            continue;
+        }
+
+        double change    = base->value > 0.0 ? (now->value - base->value) / base->value * 100.0 : 0.0;
+        int    noise     = NULL != strstr(base->name, "_ms") && now->value - base->value <= minDelta;
+        int    regressed = change > threshold && !noise;
+
+        printf("%-40s %14.4f %14.4f %+8.1f%%%s\n", base->name, base->value, now->value, change, regressed ? "  REGRESSION" : "");
+        nRegressions += regressed;
+    }
+
+    if (nRegressions)
+        printf("%d timing(s) regressed by more than %.1f%%\n", nRegressions, threshold);
+    return nRegressions ? 1 : 0;
+}
@@ -0,0 +1,244 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+/**
+ * @file      benchmark.h
+ * @brief     Fixed workload benchmark mode shared by the samples
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * A sample runs in benchmark mode when BENCHMARK_FRAMES is set in its
+ * environment. It then renders BENCHMARK_WARMUP frames (10 by default)
+ * followed by BENCHMARK_FRAMES measured frames, writes the report as JSON to
+ * BENCHMARK_OUTPUT (stdout when unset) and exits. Samples advance their
+ * animation by a constant step per frame and srand() is seeded with a fixed
+ * value, so every run renders the same sequence of images however fast the
+ * machine is. Used from C and C++, header only.
+ *
+ *   struct Benchmark bench;
+ *   benchmarkInit(&bench, "vmath-cube");
+ *   ...
+ *   benchmarkBeginFrame(&bench);
+ *   benchmarkPhase(&bench, "update");
+ *   update();
+ *   benchmarkPhase(&bench, "render");
+ *   display();
+ *   benchmarkPhase(&bench, "swap");
+ *   glXSwapBuffers(dpy, w);
+ *   if (benchmarkEndFrame(&bench))
+ *       quit = true;
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <GL/gl.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* phases timed per frame, later ones are ignored */
+#define BENCHMARK_MAX_PHASES 8
+
+/* unmeasured frames rendered first, shader compilation and uploads settle in them */
+#define BENCHMARK_DEFAULT_WARMUP 10
+
+/* seed of srand() in benchmark mode */
+#define BENCHMARK_SEED 1234U
+
+struct BenchmarkPhase
+{
+    const char *name;    // string literal, never copied
+    double      totalMs; // over all measured frames
+};
+
+struct Benchmark
+{
+    int                   enabled;
+    const char           *sample;
+    const char           *output;
+    uint32_t              nFrames; // measured frames to render
+    uint32_t              warmup;
+    uint32_t              frame;   // frames rendered so far, warmup included
+    double               *frameMs; // time of every measured frame
+    double                cpuStart; // process CPU time when measuring started
+    double                cpuMs;    // process CPU time of the measured frames
+    struct BenchmarkPhase phases[BENCHMARK_MAX_PHASES];
+    uint32_t              nPhases;
+    int                   phase; // running phase, -1 for none
+    double                frameStart;
+    double                phaseStart;
+};
+
+static inline double benchmarkClock(clockid_t clock)
+{
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+/**
+ * @brief read the environment, a disabled benchmark costs nothing per frame
+ * @return non zero in benchmark mode
+ */
+static inline int benchmarkInit(struct Benchmark *bench, const char *sample)
+{
+    const char *frames = getenv("BENCHMARK_FRAMES");
+    const char *warmup = getenv("BENCHMARK_WARMUP");
+
+    memset(bench, 0, sizeof(struct Benchmark));
+    bench->sample = sample;
+    bench->phase  = -1;
+
+    if (NULL == frames || 0 >= atoi(frames))
+        return 0;
+
+    bench->enabled = 1;
+    bench->nFrames = (uint32_t)atoi(frames);
+    bench->warmup  = NULL != warmup && 0 <= atoi(warmup) ? (uint32_t)atoi(warmup) : BENCHMARK_DEFAULT_WARMUP;
+    bench->output  = getenv("BENCHMARK_OUTPUT");
+    bench->frameMs = (double *)calloc(bench->nFrames, sizeof(double));
+    if (NULL == bench->frameMs)
+    {
+        fprintf(stderr, "[%s] out of memory, benchmark disabled\n", __func__);
+        bench->enabled = 0;
+        return 0;
+    }
+
+    srand(BENCHMARK_SEED);
+    fprintf(stderr, "[%s] %s: %u frames after %u warmup frames\n", __func__, sample, bench->nFrames, bench->warmup);
+    return 1;
+}
+
+static inline void benchmarkBeginFrame(struct Benchmark *bench)
+{
+    if (!bench->enabled)
+        return;
+
+    bench->frameStart = benchmarkClock(CLOCK_MONOTONIC);
+    if (bench->frame == bench->warmup)
+        bench->cpuStart = benchmarkClock(CLOCK_PROCESS_CPUTIME_ID);
+}
+
+/**
+ * @brief end the running phase and start the named one, NULL only ends
+ */
+static inline void benchmarkPhase(struct Benchmark *bench, const char *name)
+{
+    uint32_t idx;
+    double   time;
+
+    if (!bench->enabled)
+        return;
+
+    time = benchmarkClock(CLOCK_MONOTONIC);
+    if (0 <= bench->phase && bench->frame >= bench->warmup)
+        bench->phases[bench->phase].totalMs += time - bench->phaseStart;
+
+    bench->phase      = -1;
+    bench->phaseStart = time;
+    if (NULL == name)
+        return;
+
+    for (idx = 0; idx < bench->nPhases && 0 != strcmp(bench->phases[idx].name, name); ++idx)
+        ;
+    if (idx == bench->nPhases && BENCHMARK_MAX_PHASES > bench->nPhases)
+    {
+        bench->phases[idx].name    = name;
+        bench->phases[idx].totalMs = 0.0;
+        bench->nPhases++;
+    }
+    bench->phase = idx < bench->nPhases ? (int)idx : -1;
+}
+
+static inline int benchmarkCompare(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return x < y ? -1 : x > y;
+}
+
+/* nearest rank percentile of sorted values */
+static inline double benchmarkPercentile(const double *sorted, uint32_t count, double percent)
+{
+    uint32_t rank = (uint32_t)(percent / 100.0 * count + 0.999999);
+    return sorted[rank > 0 ? (rank <= count ? rank - 1 : count - 1) : 0];
+}
+
+static inline int benchmarkWriteReport(struct Benchmark *bench)
+{
+    const char *renderer = (const char *)glGetString(GL_RENDERER);
+    FILE       *pFile    = NULL != bench->output ? fopen(bench->output, "w") : stdout;
+    double      mean     = 0.0;
+    uint32_t    idx;
+
+    if (NULL == pFile)
+    {
+        fprintf(stderr, "[%s] cannot write %s\n", __func__, bench->output);
+        return -1;
+    }
+
+    for (idx = 0; idx < bench->nFrames; ++idx)
+        mean += bench->frameMs[idx] / bench->nFrames;
+    qsort(bench->frameMs, bench->nFrames, sizeof(double), benchmarkCompare);
+
+    /* one value per line, bench-compare reads it line by line */
+    fprintf(pFile, "{\n");
+    fprintf(pFile, "  \"sample\": \"%s\",\n", bench->sample);
+    fprintf(pFile, "  \"renderer\": \"%s\",\n", NULL != renderer ? renderer : "unknown");
+    fprintf(pFile, "  \"frames\": %u,\n", bench->nFrames);
+    fprintf(pFile, "  \"frame_ms\": {\n");
+    fprintf(pFile, "    \"min\": %.4f,\n", bench->frameMs[0]);
+    fprintf(pFile, "    \"median\": %.4f,\n", benchmarkPercentile(bench->frameMs, bench->nFrames, 50.0));
+    fprintf(pFile, "    \"mean\": %.4f,\n", mean);
+    fprintf(pFile, "    \"p95\": %.4f,\n", benchmarkPercentile(bench->frameMs, bench->nFrames, 95.0));
+    fprintf(pFile, "    \"p99\": %.4f,\n", benchmarkPercentile(bench->frameMs, bench->nFrames, 99.0));
+    fprintf(pFile, "    \"max\": %.4f\n", bench->frameMs[bench->nFrames - 1]);
+    fprintf(pFile, "  },\n");
+    fprintf(pFile, "  \"cpu_ms\": %.4f,\n", bench->cpuMs / bench->nFrames);
+    fprintf(pFile, "  \"phase_ms\": {");
+    for (idx = 0; idx < bench->nPhases; ++idx)
+        fprintf(pFile, "%s\n    \"%s\": %.4f", idx ? "," : "", bench->phases[idx].name, bench->phases[idx].totalMs / bench->nFrames);
+    fprintf(pFile, "\n  }\n}\n");
+
+    if (stdout != pFile && 0 != fclose(pFile))
+    {
+        fprintf(stderr, "[%s] cannot write %s\n", __func__, bench->output);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief close the frame
+ * @return non zero once the last measured frame is done and the report written
+ */
+static inline int benchmarkEndFrame(struct Benchmark *bench)
+{
+    double time;
+
+    if (!bench->enabled)
+        return 0;
+
+    benchmarkPhase(bench, NULL);
+    time = benchmarkClock(CLOCK_MONOTONIC);
+    if (bench->frame >= bench->warmup)
+        bench->frameMs[bench->frame - bench->warmup] = time - bench->frameStart;
+
+    if (++bench->frame < bench->warmup + bench->nFrames)
+        return 0;
+
+    bench->cpuMs = benchmarkClock(CLOCK_PROCESS_CPUTIME_ID) - bench->cpuStart;
+    benchmarkWriteReport(bench);
+    free(bench->frameMs);
+    bench->frameMs = NULL;
+    bench->enabled = 0;
+    return 1;
+}
+
+#endif
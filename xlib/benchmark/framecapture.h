@@ -0,0 +1,533 @@
+#ifndef FRAMECAPTURE_H
+#define FRAMECAPTURE_H
+/**
+ * @file      framecapture.h
+ * @brief     Frame capture through a ring of pixel pack buffers
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * With FRAMECAPTURE set in the environment every frame is read back and
+ * written by a worker thread:
+ *
+ *   FRAMECAPTURE=frame-%05u.png   numbered PNG files, printf pattern
+ *   FRAMECAPTURE=capture.y4m      one YUV 4:2:0 stream, also to a pipe
+ *
+ *   mkfifo capture.y4m
+ *   ffmpeg -i capture.y4m capture.mp4 &
+ *   FRAMECAPTURE=capture.y4m BENCHMARK_FRAMES=600 ./fractal
+ *
+ * glReadPixels() into a pixel pack buffer only queues the copy, the buffer
+ * is mapped FRAMECAPTURE_LATENCY frames later when the GPU has finished it,
+ * so the render thread never waits for the readback. The mapped pointer is
+ * handed to the writer as is and the buffer unmapped once written, frames
+ * are not copied on the render thread. The render thread only waits when
+ * the writer is FRAMECAPTURE_BUFFERS - FRAMECAPTURE_LATENCY frames behind,
+ * frames are never dropped; the waits are counted in the final report.
+ * FRAMECAPTURE_FPS sets the Y4M frame rate, 60 by default.
+ *
+ * The captured size is fixed at frameCaptureInit(), Y4M needs even sizes
+ * and drops the last row or column otherwise. PNG files are stored without
+ * compression, writing them costs little more than the copy to disk.
+ * GL entry points are resolved through glXGetProcAddressARB(), samples with
+ * and without GLEW use it the same way. Used from C and C++, header only,
+ * include after the GL headers and link with -lpthread.
+ *
+ *   struct FrameCapture capture;
+ *   frameCaptureInit(&capture, width, height);
+ *   ...
+ *   render();
+ *   frameCaptureFrame(&capture);
+ *   glXSwapBuffers(dpy, w);
+ *   ...
+ *   frameCaptureShutdown(&capture);
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <GL/glx.h>
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* pixel pack buffers in the ring */
+#define FRAMECAPTURE_BUFFERS 6
+
+/* frames between the readback and mapping its buffer */
+#define FRAMECAPTURE_LATENCY 2
+
+#define FRAMECAPTURE_PATH_LENGTH 256
+
+#ifndef GL_PIXEL_PACK_BUFFER
+#define GL_PIXEL_PACK_BUFFER 0x88EB
+#endif
+#ifndef GL_STREAM_READ
+#define GL_STREAM_READ 0x88E1
+#endif
+#ifndef GL_READ_ONLY
+#define GL_READ_ONLY 0x88B8
+#endif
+
+typedef void(GLAPIENTRY *FrameCaptureGenBuffers)(GLsizei n, GLuint *buffers);
+typedef void(GLAPIENTRY *FrameCaptureDeleteBuffers)(GLsizei n, const GLuint *buffers);
+typedef void(GLAPIENTRY *FrameCaptureBindBuffer)(GLenum target, GLuint buffer);
+typedef void(GLAPIENTRY *FrameCaptureBufferData)(GLenum target, ptrdiff_t size, const void *data, GLenum usage);
+typedef void *(GLAPIENTRY *FrameCaptureMapBuffer)(GLenum target, GLenum access);
+typedef GLboolean(GLAPIENTRY *FrameCaptureUnmapBuffer)(GLenum target);
+
+enum FrameCaptureFormat
+{
+    FRAMECAPTURE_PNG,
+    FRAMECAPTURE_Y4M
+};
+
+struct FrameCapture
+{
+    int                     enabled;
+    enum FrameCaptureFormat format;
+    char                    path[FRAMECAPTURE_PATH_LENGTH];
+    uint32_t                width;
+    uint32_t                height;
+    uint32_t                fps;
+    FILE                   *pStream;  // Y4M output, NULL for PNG
+    uint8_t                *pScratch; // writer's row or YUV planes
+
+    GLuint       buffers[FRAMECAPTURE_BUFFERS];
+    const void  *pixels[FRAMECAPTURE_BUFFERS]; // mapped RGBA, bottom row first
+    uint32_t     issued;                       // frames read back
+    uint32_t     mapped;                       // frames handed to the writer
+    uint32_t     unmapped;                     // frames whose buffer is free again
+    uint32_t     written;                      // frames the writer finished, guarded by lock
+    uint32_t     failed;                       // frames the writer could not write
+    uint32_t     waits;                        // frames the render thread waited for the writer
+    int          stop;
+    pthread_t    writer;
+    pthread_mutex_t lock;
+    pthread_cond_t  cond;
+
+    FrameCaptureGenBuffers    genBuffers;
+    FrameCaptureDeleteBuffers deleteBuffers;
+    FrameCaptureBindBuffer    bindBuffer;
+    FrameCaptureBufferData    bufferData;
+    FrameCaptureMapBuffer     mapBuffer;
+    FrameCaptureUnmapBuffer   unmapBuffer;
+};
+
+/**
+ * @brief zlib stream of stored blocks inside one IDAT chunk
+ */
+struct FrameCapturePng
+{
+    FILE    *pFile;
+    uint32_t crc;
+    uint32_t adler1;
+    uint32_t adler2;
+    uint32_t rawLeft;   // uncompressed bytes still to come
+    uint32_t blockLeft; // bytes left in the current stored block
+};
+
+static inline uint32_t frameCaptureCrc(uint32_t crc, const uint8_t *data, size_t size)
+{
+    static uint32_t table[256];
+    static int      isReady = 0;
+
+    if (!__atomic_load_n(&isReady, __ATOMIC_ACQUIRE))
+    {
+        for (uint32_t n = 0U; n < 256U; ++n)
+        {
+            uint32_t c = n;
+            for (int k = 0; k < 8; ++k) c = (c & 1U) ? 0xEDB88320U ^ (c >> 1) : c >> 1;
+            table[n] = c;
+        }
+        __atomic_store_n(&isReady, 1, __ATOMIC_RELEASE);
+    }
+
+    for (size_t idx = 0U; idx < size; ++idx) crc = table[(crc ^ data[idx]) & 0xFFU] ^ (crc >> 8);
+    return crc;
+}
+
+static inline void frameCapturePngBytes(struct FrameCapturePng *png, const uint8_t *data, size_t size)
+{
+    png->crc = frameCaptureCrc(png->crc, data, size);
+    fwrite(data, 1, size, png->pFile);
+}
+
+static inline void frameCaptureBigEndian(uint8_t *out, uint32_t value)
+{
+    out[0] = (uint8_t)(value >> 24);
+    out[1] = (uint8_t)(value >> 16);
+    out[2] = (uint8_t)(value >> 8);
+    out[3] = (uint8_t)value;
+}
+
+/* length and type of a chunk, the CRC starts with the type */
+static inline void frameCapturePngChunk(struct FrameCapturePng *png, const char *type, uint32_t length)
+{
+    uint8_t header[4];
+    frameCaptureBigEndian(header, length);
+    fwrite(header, 1, 4, png->pFile);
+    png->crc = 0xFFFFFFFFU;
+    frameCapturePngBytes(png, (const uint8_t *)type, 4);
+}
+
+static inline void frameCapturePngEnd(struct FrameCapturePng *png)
+{
+    uint8_t crc[4];
+    frameCaptureBigEndian(crc, png->crc ^ 0xFFFFFFFFU);
+    fwrite(crc, 1, 4, png->pFile);
+}
+
+/* image bytes, split into stored blocks of at most 65535 bytes */
+static inline void frameCapturePngRaw(struct FrameCapturePng *png, const uint8_t *data, uint32_t size)
+{
+    while (0U < size)
+    {
+        if (0U == png->blockLeft)
+        {
+            uint32_t block  = png->rawLeft < 65535U ? png->rawLeft : 65535U;
+            uint8_t  hdr[5] = {(uint8_t)(block == png->rawLeft), (uint8_t)block, (uint8_t)(block >> 8), (uint8_t)~block, (uint8_t)(~block >> 8)};
+            frameCapturePngBytes(png, hdr, sizeof(hdr));
+            png->blockLeft = block;
+        }
+
+        uint32_t n = size < png->blockLeft ? size : png->blockLeft;
+        frameCapturePngBytes(png, data, n);
+        for (uint32_t idx = 0U; idx < n; ++idx)
+        {
+            png->adler1 = (png->adler1 + data[idx]) % 65521U;
+            png->adler2 = (png->adler2 + png->adler1) % 65521U;
+        }
+        png->blockLeft -= n;
+        png->rawLeft -= n;
+        data += n;
+        size -= n;
+    }
+}
+
+static inline int frameCaptureWritePng(struct FrameCapture *capture, uint32_t frame, const uint8_t *pixels)
+{
+    static const uint8_t   signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    struct FrameCapturePng png;
+    char                   path[FRAMECAPTURE_PATH_LENGTH + 16];
+    uint32_t               rowBytes = 1U + capture->width * 3U;
+    uint32_t               nBlocks  = 0U;
+    uint8_t                ihdr[13] = {0};
+
+    snprintf(path, sizeof(path), capture->path, frame);
+    memset(&png, 0, sizeof(png));
+    png.pFile = fopen(path, "wb");
+    if (NULL == png.pFile)
+    {
+        fprintf(stderr, "[%s] cannot write %s\n", __func__, path);
+        return -1;
+    }
+
+    png.rawLeft = rowBytes * capture->height;
+    png.adler1  = 1U;
+    nBlocks     = (png.rawLeft + 65534U) / 65535U;
+
+    fwrite(signature, 1, sizeof(signature), png.pFile);
+    frameCaptureBigEndian(&ihdr[0], capture->width);
+    frameCaptureBigEndian(&ihdr[4], capture->height);
+    ihdr[8] = 8; // bits per channel
+    ihdr[9] = 2; // RGB
+    frameCapturePngChunk(&png, "IHDR", sizeof(ihdr));
+    frameCapturePngBytes(&png, ihdr, sizeof(ihdr));
+    frameCapturePngEnd(&png);
+
+    /* zlib header, stored blocks, adler32 */
+    frameCapturePngChunk(&png, "IDAT", 2U + nBlocks * 5U + png.rawLeft + 4U);
+    frameCapturePngBytes(&png, (const uint8_t *)"\x78\x01", 2);
+    for (uint32_t y = 0U; y < capture->height; ++y)
+    {
+        /* GL rows start at the bottom, filter type 0 per row */
+        const uint8_t *src = pixels + (size_t)(capture->height - 1U - y) * capture->width * 4U;
+        uint8_t       *dst = capture->pScratch;
+        *dst++             = 0U;
+        for (uint32_t x = 0U; x < capture->width; ++x, src += 4, dst += 3)
+        {
+            dst[0] = src[0];
+            dst[1] = src[1];
+            dst[2] = src[2];
+        }
+        frameCapturePngRaw(&png, capture->pScratch, rowBytes);
+    }
+    uint8_t adler[4];
+    frameCaptureBigEndian(adler, (png.adler2 << 16) | png.adler1);
+    frameCapturePngBytes(&png, adler, sizeof(adler));
+    frameCapturePngEnd(&png);
+
+    frameCapturePngChunk(&png, "IEND", 0U);
+    frameCapturePngEnd(&png);
+
+    if (0 != fclose(png.pFile))
+    {
+        fprintf(stderr, "[%s] cannot write %s\n", __func__, path);
+        return -1;
+    }
+    return 0;
+}
+
+/* BT.601 limited range, chroma averaged over 2x2 pixels */
+static inline int frameCaptureWriteY4m(struct FrameCapture *capture, const uint8_t *pixels)
+{
+    uint32_t w = capture->width, h = capture->height, stride = capture->width * 4U;
+    uint8_t *yPlane = capture->pScratch;
+    uint8_t *uPlane = yPlane + (size_t)w * h;
+    uint8_t *vPlane = uPlane + (size_t)w * h / 4U;
+
+    for (uint32_t y = 0U; y < h; y += 2U)
+    {
+        const uint8_t *row0 = pixels + (size_t)(h - 1U - y) * stride;
+        const uint8_t *row1 = row0 - stride;
+        uint8_t       *y0   = yPlane + (size_t)y * w;
+        uint8_t       *y1   = y0 + w;
+
+        for (uint32_t x = 0U; x < w; x += 2U)
+        {
+            const uint8_t *p[4] = {row0 + x * 4U, row0 + x * 4U + 4U, row1 + x * 4U, row1 + x * 4U + 4U};
+            int            r = 0, g = 0, b = 0;
+            for (int k = 0; k < 4; ++k)
+            {
+                uint8_t *out = (k < 2 ? y0 : y1) + x + (k & 1);
+                *out         = (uint8_t)(16 + ((66 * p[k][0] + 129 * p[k][1] + 25 * p[k][2] + 128) >> 8));
+                r += p[k][0];
+                g += p[k][1];
+                b += p[k][2];
+            }
+            r = (r + 2) / 4;
+            g = (g + 2) / 4;
+            b = (b + 2) / 4;
+            *uPlane++ = (uint8_t)(128 + ((-38 * r - 74 * g + 112 * b + 128) >> 8));
+            *vPlane++ = (uint8_t)(128 + ((112 * r - 94 * g - 18 * b + 128) >> 8));
+        }
+    }
+
+    fputs("FRAME\n", capture->pStream);
+    if (1 != fwrite(capture->pScratch, (size_t)w * h * 3U / 2U, 1, capture->pStream))
+    {
+        fprintf(stderr, "[%s] cannot write %s\n", __func__, capture->path);
+        return -1;
+    }
+    return 0;
+}
+
+static inline void *frameCaptureWriter(void *arg)
+{
+    struct FrameCapture *capture = (struct FrameCapture *)arg;
+
+    pthread_mutex_lock(&capture->lock);
+    for (;;)
+    {
+        while (capture->written == capture->mapped && !capture->stop) pthread_cond_wait(&capture->cond, &capture->lock);
+        if (capture->written == capture->mapped)
+            break;
+
+        uint32_t       frame  = capture->written;
+        const uint8_t *pixels = (const uint8_t *)capture->pixels[frame % FRAMECAPTURE_BUFFERS];
+        pthread_mutex_unlock(&capture->lock);
+
+        int result = NULL == pixels ? -1 : FRAMECAPTURE_Y4M == capture->format ? frameCaptureWriteY4m(capture, pixels) : frameCaptureWritePng(capture, frame, pixels);
+
+        pthread_mutex_lock(&capture->lock);
+        if (0 != result)
+            ++capture->failed;
+        ++capture->written;
+        pthread_cond_broadcast(&capture->cond);
+    }
+    pthread_mutex_unlock(&capture->lock);
+    return NULL;
+}
+
+/**
+ * @brief read FRAMECAPTURE and start the writer, with the context current
+ * @return 0 also when capture is disabled, -1 when it was requested but cannot run
+ */
+static inline int frameCaptureInit(struct FrameCapture *capture, uint32_t width, uint32_t height)
+{
+    const char *path = getenv("FRAMECAPTURE");
+    const char *fps  = getenv("FRAMECAPTURE_FPS");
+    size_t      length;
+
+    memset(capture, 0, sizeof(struct FrameCapture));
+    if (NULL == path || '\0' == path[0])
+        return 0;
+
+    length = strlen(path);
+    if (FRAMECAPTURE_PATH_LENGTH <= length)
+    {
+        fprintf(stderr, "[%s] path too long: %s\n", __func__, path);
+        return -1;
+    }
+    memcpy(capture->path, path, length + 1U);
+    capture->format = 4U <= length && 0 == strcmp(path + length - 4U, ".y4m") ? FRAMECAPTURE_Y4M : FRAMECAPTURE_PNG;
+    capture->width  = FRAMECAPTURE_Y4M == capture->format ? width & ~1U : width;
+    capture->height = FRAMECAPTURE_Y4M == capture->format ? height & ~1U : height;
+    capture->fps    = NULL != fps && 0 < atoi(fps) ? (uint32_t)atoi(fps) : 60U;
+    if (0U == capture->width || 0U == capture->height)
+    {
+        fprintf(stderr, "[%s] cannot capture %ux%u\n", __func__, width, height);
+        return -1;
+    }
+
+    capture->genBuffers    = (FrameCaptureGenBuffers)glXGetProcAddressARB((const GLubyte *)"glGenBuffers");
+    capture->deleteBuffers = (FrameCaptureDeleteBuffers)glXGetProcAddressARB((const GLubyte *)"glDeleteBuffers");
+    capture->bindBuffer    = (FrameCaptureBindBuffer)glXGetProcAddressARB((const GLubyte *)"glBindBuffer");
+    capture->bufferData    = (FrameCaptureBufferData)glXGetProcAddressARB((const GLubyte *)"glBufferData");
+    capture->mapBuffer     = (FrameCaptureMapBuffer)glXGetProcAddressARB((const GLubyte *)"glMapBuffer");
+    capture->unmapBuffer   = (FrameCaptureUnmapBuffer)glXGetProcAddressARB((const GLubyte *)"glUnmapBuffer");
+    if (NULL == capture->genBuffers || NULL == capture->deleteBuffers || NULL == capture->bindBuffer || NULL == capture->bufferData || NULL == capture->mapBuffer ||
+        NULL == capture->unmapBuffer)
+    {
+        fprintf(stderr, "[%s] buffer objects not supported, capture disabled\n", __func__);
+        return -1;
+    }
+
+    /* a PNG row with its filter byte, or the three planes of a Y4M frame */
+    capture->pScratch = (uint8_t *)malloc(FRAMECAPTURE_Y4M == capture->format ? (size_t)capture->width * capture->height * 3U / 2U : 1U + capture->width * 3U);
+    if (NULL == capture->pScratch)
+    {
+        fprintf(stderr, "[%s] out of memory\n", __func__);
+        return -1;
+    }
+
+    if (FRAMECAPTURE_Y4M == capture->format)
+    {
+        capture->pStream = fopen(capture->path, "wb");
+        if (NULL == capture->pStream)
+        {
+            fprintf(stderr, "[%s] cannot write %s\n", __func__, capture->path);
+            free(capture->pScratch);
+            capture->pScratch = NULL;
+            return -1;
+        }
+        fprintf(capture->pStream, "YUV4MPEG2 W%u H%u F%u:1 Ip A1:1 C420jpeg\n", capture->width, capture->height, capture->fps);
+    }
+
+    capture->genBuffers(FRAMECAPTURE_BUFFERS, capture->buffers);
+    for (int idx = 0; idx < FRAMECAPTURE_BUFFERS; ++idx)
+    {
+        capture->bindBuffer(GL_PIXEL_PACK_BUFFER, capture->buffers[idx]);
+        capture->bufferData(GL_PIXEL_PACK_BUFFER, (ptrdiff_t)capture->width * capture->height * 4, NULL, GL_STREAM_READ);
+    }
+    capture->bindBuffer(GL_PIXEL_PACK_BUFFER, 0U);
+
+    pthread_mutex_init(&capture->lock, NULL);
+    pthread_cond_init(&capture->cond, NULL);
+    if (0 != pthread_create(&capture->writer, NULL, frameCaptureWriter, capture))
+    {
+        fprintf(stderr, "[%s] cannot start the writer\n", __func__);
+        capture->deleteBuffers(FRAMECAPTURE_BUFFERS, capture->buffers);
+        pthread_cond_destroy(&capture->cond);
+        pthread_mutex_destroy(&capture->lock);
+        if (NULL != capture->pStream)
+            fclose(capture->pStream);
+        free(capture->pScratch);
+        memset(capture, 0, sizeof(struct FrameCapture));
+        return -1;
+    }
+
+    capture->enabled = 1;
+    fprintf(stderr, "[%s] capturing %ux%u to %s\n", __func__, capture->width, capture->height, capture->path);
+    return 0;
+}
+
+/* unmap the buffers of frames the writer finished */
+static inline void frameCaptureRecycle(struct FrameCapture *capture)
+{
+    uint32_t written;
+
+    pthread_mutex_lock(&capture->lock);
+    written = capture->written;
+    pthread_mutex_unlock(&capture->lock);
+
+    for (; capture->unmapped < written; ++capture->unmapped)
+    {
+        uint32_t slot = capture->unmapped % FRAMECAPTURE_BUFFERS;
+        if (NULL != capture->pixels[slot])
+        {
+            capture->bindBuffer(GL_PIXEL_PACK_BUFFER, capture->buffers[slot]);
+            capture->unmapBuffer(GL_PIXEL_PACK_BUFFER);
+            capture->pixels[slot] = NULL;
+        }
+    }
+}
+
+/* map the oldest frame read back and hand it to the writer */
+static inline void frameCaptureMapNext(struct FrameCapture *capture)
+{
+    uint32_t slot = capture->mapped % FRAMECAPTURE_BUFFERS;
+
+    capture->bindBuffer(GL_PIXEL_PACK_BUFFER, capture->buffers[slot]);
+    capture->pixels[slot] = capture->mapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+
+    pthread_mutex_lock(&capture->lock);
+    ++capture->mapped;
+    pthread_cond_broadcast(&capture->cond);
+    pthread_mutex_unlock(&capture->lock);
+}
+
+/**
+ * @brief queue the readback of the back buffer, to be called before the swap
+ */
+static inline void frameCaptureFrame(struct FrameCapture *capture)
+{
+    if (!capture->enabled)
+        return;
+
+    frameCaptureRecycle(capture);
+    while (capture->mapped + FRAMECAPTURE_LATENCY <= capture->issued) frameCaptureMapNext(capture);
+
+    /* every buffer still waits for the writer */
+    if (capture->issued - capture->unmapped == FRAMECAPTURE_BUFFERS)
+    {
+        ++capture->waits;
+        pthread_mutex_lock(&capture->lock);
+        while (capture->written == capture->unmapped) pthread_cond_wait(&capture->cond, &capture->lock);
+        pthread_mutex_unlock(&capture->lock);
+        frameCaptureRecycle(capture);
+    }
+
+    capture->bindBuffer(GL_PIXEL_PACK_BUFFER, capture->buffers[capture->issued % FRAMECAPTURE_BUFFERS]);
+    glReadPixels(0, 0, (GLsizei)capture->width, (GLsizei)capture->height, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    capture->bindBuffer(GL_PIXEL_PACK_BUFFER, 0U);
+    ++capture->issued;
+}
+
+/**
+ * @brief write the frames still in flight, stop the writer and print a summary
+ */
+static inline void frameCaptureShutdown(struct FrameCapture *capture)
+{
+    if (!capture->enabled)
+        return;
+
+    /* the GPU may still be copying the last frames, mapping waits for it */
+    while (capture->mapped < capture->issued) frameCaptureMapNext(capture);
+
+    pthread_mutex_lock(&capture->lock);
+    capture->stop = 1;
+    pthread_cond_broadcast(&capture->cond);
+    pthread_mutex_unlock(&capture->lock);
+    pthread_join(capture->writer, NULL);
+    frameCaptureRecycle(capture);
+
+    capture->deleteBuffers(FRAMECAPTURE_BUFFERS, capture->buffers);
+    pthread_cond_destroy(&capture->cond);
+    pthread_mutex_destroy(&capture->lock);
+    if (NULL != capture->pStream && 0 != fclose(capture->pStream))
+        ++capture->failed;
+    free(capture->pScratch);
+
+    fprintf(stderr, "[%s] %u frames to %s, %u failed, waited for the writer %u times\n", __func__, capture->issued, capture->path, capture->failed, capture->waits);
+    capture->enabled = 0;
+}
+
+#endif
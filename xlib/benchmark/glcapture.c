@@ -0,0 +1,765 @@
+/**
+ * @file      glcapture.c
+ * @brief     LD_PRELOAD shim writing one frame of GL commands to a trace for glreplay
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * Usage: LD_PRELOAD=/path/to/glcapture.so ./sample
+ *
+ *   GLCAPTURE_FRAME   capture the frame after this many glXSwapBuffers calls
+ *   GLCAPTURE_OUTPUT  prefix of trace files, "capture" by default
+ *
+ * Sending SIGUSR1 captures the next frame, so a sample can first be brought
+ * into the state of interest with its keys:
+ *
+ *   kill -USR1 $(pidof shadow)
+ *
+ * Every capture is written to <prefix>-<frame>.gltrace in the working
+ * directory. Display lists are recorded as they are compiled and texture
+ * names as they are bound. When a capture starts, the pixels of every
+ * texture are read back and the fixed function state is queried, so the
+ * trace replays without the frames before it. Layout is in gltrace.h.
+ *
+ * Only the fixed function subset in GLTRACE_COMMANDS is recorded. Samples
+ * using buffers and shaders through GLEW cannot be captured, a warning is
+ * printed when one of their calls is seen. Wrappers are exported and
+ * handed out by glXGetProcAddress the same way as in glcount.
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#define _GNU_SOURCE
+#define GL_GLEXT_PROTOTYPES
+#include <GL/gl.h>
+#include <GL/glext.h>
+#include <GL/glx.h>
+
+#include <dlfcn.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gltrace.h"
+
+#define GLCAPTURE_EXPORT __attribute__((visibility("default")))
+
+/* objects recorded between captures */
+#define MAX_LISTS    1024
+#define MAX_TEXTURES 1024
+
+/* levels read back per texture */
+#define MAX_LEVELS 16
+
+/* growable array of command words */
+struct Stream
+{
+    uint32_t *words;
+    size_t    nWords;
+    size_t    capacity;
+    uint32_t  nCommands;
+};
+
+struct List
+{
+    GLuint        name;
+    struct Stream commands; // as compiled, without glNewList and glEndList
+};
+
+static struct List        lists[MAX_LISTS];
+static uint32_t           nLists;
+static struct List       *compiling; // list between glNewList and glEndList
+static GLuint             textures[MAX_TEXTURES];
+static uint32_t           nTextures;
+static GLint              unpackAlignment = 4;
+static struct Stream      blocks[N_TRACE_BLOCKS];
+static struct TraceHeader header;
+static int                capturing;
+static uint32_t           captureFrame; // frame being captured
+static uint32_t           nFrames;      // glXSwapBuffers calls so far
+static uint32_t           requestedFrame;
+static const char        *prefix = "capture";
+static int                initialized;
+static int                warnedUnsupported;
+
+static volatile sig_atomic_t isRequested;
+
+static void onRequest(int signal)
+{
+    (void)signal;
+    isRequested = 1;
+}
+
+static void initialize(void)
+{
+    const char      *value;
+    struct sigaction action;
+
+    initialized = 1;
+    if (NULL != (value = getenv("GLCAPTURE_FRAME")))
+        requestedFrame = (uint32_t)atoi(value);
+    if (NULL != (value = getenv("GLCAPTURE_OUTPUT")))
+        prefix = value;
+
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = onRequest;
+    action.sa_flags   = SA_RESTART;
+    sigaction(SIGUSR1, &action, NULL);
+}
+
+/* real entry point behind the wrapper, the driver's when it has one */
+static void *resolve(const char *name)
+{
+    static __GLXextFuncPtr (*getProcAddress)(const GLubyte *);
+    void *proc = NULL;
+
+    if (NULL == getProcAddress)
+        getProcAddress = (__GLXextFuncPtr(*)(const GLubyte *))dlsym(RTLD_NEXT, "glXGetProcAddressARB");
+    if (NULL != getProcAddress)
+        proc = (void *)getProcAddress((const GLubyte *)name);
+    if (NULL == proc)
+        proc = dlsym(RTLD_NEXT, name);
+    if (NULL == proc)
+        fprintf(stderr, "[%s] %s not found\n", __func__, name);
+    return proc;
+}
+
+static void warnUnsupported(const char *name)
+{
+    if (!capturing || warnedUnsupported)
+        return;
+    warnedUnsupported = 1;
+    fprintf(stderr, "[glcapture] %s is not captured, traces of this sample hold its fixed function calls only\n", name);
+}
+
+static void reserve(struct Stream *stream, size_t nWords)
+{
+    if (stream->nWords + nWords <= stream->capacity)
+        return;
+
+    size_t    capacity = stream->capacity ? stream->capacity : 4096U;
+    uint32_t *words;
+    while (capacity < stream->nWords + nWords) { capacity *= 2U; }
+
+    words = (uint32_t *)realloc(stream->words, capacity * sizeof(uint32_t));
+    if (NULL == words)
+    {
+        fprintf(stderr, "[%s] out of memory\n", __func__);
+        exit(EXIT_FAILURE);
+    }
+    stream->words    = words;
+    stream->capacity = capacity;
+}
+
+static void pushBytes(struct Stream *stream, const void *data, size_t size)
+{
+    size_t nWords = (size + 3U) / 4U;
+
+    if (0U == size)
+        return;
+    reserve(stream, nWords);
+    stream->words[stream->nWords + nWords - 1U] = 0U; // padding
+    memcpy(&stream->words[stream->nWords], data, size);
+    stream->nWords += nWords;
+}
+
+static void pushWord(struct Stream *stream, uint32_t word)
+{
+    pushBytes(stream, &word, sizeof(word));
+}
+
+static void append(struct Stream *stream, const struct Stream *other)
+{
+    pushBytes(stream, other->words, other->nWords * sizeof(uint32_t));
+    stream->nCommands += other->nCommands;
+}
+
+/* arguments follow the format of op, arrays and blobs as a count and a pointer */
+static void encode(struct Stream *stream, enum TraceOp op, va_list ap)
+{
+    size_t start = stream->nWords;
+
+    pushWord(stream, op);
+    for (const char *format = traceFormats[op]; '\0' != *format; ++format)
+    {
+        switch (*format)
+        {
+            case 'i':
+                pushWord(stream, (uint32_t)va_arg(ap, int));
+                break;
+            case 'f':
+            {
+                GLfloat value = (GLfloat)va_arg(ap, double);
+                pushBytes(stream, &value, sizeof(value));
+                break;
+            }
+            case 'd':
+            {
+                GLdouble value = va_arg(ap, double);
+                pushBytes(stream, &value, sizeof(value));
+                break;
+            }
+            case 'F':
+            case 'D':
+            case 'B':
+            {
+                uint32_t    count  = (uint32_t)va_arg(ap, int);
+                const void *values = va_arg(ap, const void *);
+                size_t      size   = 'F' == *format ? sizeof(GLfloat) : 'D' == *format ? sizeof(GLdouble) : 1U;
+                if (NULL == values)
+                    count = 0U;
+                pushWord(stream, count);
+                if (count)
+                    pushBytes(stream, values, count * size);
+                break;
+            }
+        }
+    }
+    stream->words[start] = op | (uint32_t)((stream->nWords - start - 1U) << 8);
+    stream->nCommands++;
+}
+
+static void put(struct Stream *stream, enum TraceOp op, ...)
+{
+    va_list ap;
+    va_start(ap, op);
+    encode(stream, op, ap);
+    va_end(ap);
+}
+
+/* record into the list being compiled and the frame being captured */
+static void emit(enum TraceOp op, ...)
+{
+    va_list ap;
+
+    if (NULL != compiling && TRACE_glEndList != op)
+    {
+        va_start(ap, op);
+        encode(&compiling->commands, op, ap);
+        va_end(ap);
+    }
+    if (capturing)
+    {
+        va_start(ap, op);
+        encode(&blocks[TRACE_BLOCK_FRAME], op, ap);
+        va_end(ap);
+    }
+}
+
+static int lightValues(GLenum pname)
+{
+    return GL_SPOT_DIRECTION == pname ? 3 : GL_AMBIENT == pname || GL_DIFFUSE == pname || GL_SPECULAR == pname || GL_POSITION == pname ? 4 : 1;
+}
+
+static int materialValues(GLenum pname)
+{
+    return GL_COLOR_INDEXES == pname ? 3 : GL_SHININESS == pname ? 1 : 4;
+}
+
+/* size of client pixels as read by the driver, row length and skips are not supported */
+static int pixelBytes(GLsizei width, GLsizei height, GLenum format, GLenum type, const void *pixels)
+{
+    size_t components = GL_RGBA == format || GL_BGRA == format ? 4U : GL_RGB == format || GL_BGR == format ? 3U : GL_LUMINANCE_ALPHA == format || GL_RG == format ? 2U : 1U;
+    size_t pixel      = 0U;
+
+    if (NULL == pixels || 0 >= width || 0 >= height)
+        return 0;
+
+    switch (type)
+    {
+        case GL_UNSIGNED_SHORT_5_6_5:
+        case GL_UNSIGNED_SHORT_4_4_4_4:
+        case GL_UNSIGNED_SHORT_5_5_5_1:
+            pixel = 2U;
+            break;
+        case GL_UNSIGNED_INT_8_8_8_8:
+        case GL_UNSIGNED_INT_8_8_8_8_REV:
+        case GL_UNSIGNED_INT_2_10_10_10_REV:
+            pixel = 4U;
+            break;
+        case GL_UNSIGNED_SHORT:
+        case GL_SHORT:
+        case GL_HALF_FLOAT:
+            pixel = 2U * components;
+            break;
+        case GL_UNSIGNED_INT:
+        case GL_INT:
+        case GL_FLOAT:
+            pixel = 4U * components;
+            break;
+        default:
+            pixel = components;
+            break;
+    }
+
+    size_t row = (width * pixel + unpackAlignment - 1U) / unpackAlignment * unpackAlignment;
+    return (int)(row * (height - 1) + width * pixel);
+}
+
+static void beginList(GLuint name)
+{
+    uint32_t idx = 0U;
+    while (idx < nLists && lists[idx].name != name) { ++idx; }
+    if (idx == nLists)
+    {
+        if (MAX_LISTS == nLists)
+        {
+            fprintf(stderr, "[%s] more than %d display lists, list %u is not recorded\n", __func__, MAX_LISTS, name);
+            return;
+        }
+        lists[nLists++].name = name;
+    }
+    lists[idx].commands.nWords    = 0U;
+    lists[idx].commands.nCommands = 0U;
+    compiling                     = &lists[idx];
+}
+
+static void endList(void)
+{
+    compiling = NULL;
+}
+
+static void addTexture(GLenum target, GLuint texture)
+{
+    if (GL_TEXTURE_2D != target || 0U == texture)
+        return;
+
+    for (uint32_t idx = 0U; idx < nTextures; ++idx)
+    {
+        if (textures[idx] == texture)
+            return;
+    }
+    if (MAX_TEXTURES == nTextures)
+    {
+        fprintf(stderr, "[%s] more than %d textures, texture %u is not recorded\n", __func__, MAX_TEXTURES, texture);
+        return;
+    }
+    textures[nTextures++] = texture;
+}
+
+static void pixelStore(GLenum pname, GLint param)
+{
+    if (GL_UNPACK_ALIGNMENT == pname)
+        unpackAlignment = param;
+}
+
+#define GLCAPTURE_WRAP(name, params, args, format, record, replay, hook) \
+    typedef void (*name##Proc) params;                                   \
+    static name##Proc real_##name;                                       \
+    static void       wrap_##name params                                 \
+    {                                                                    \
+        if (!initialized)                                                \
+            initialize();                                                \
+        if (NULL == real_##name)                                         \
+            real_##name = (name##Proc)resolve(#name);                    \
+        real_##name args;                                                \
+        if (NULL != compiling || capturing)                              \
+            emit record;                                                 \
+        hook;                                                            \
+    }                                                                    \
+    GLCAPTURE_EXPORT void name params                                    \
+    {                                                                    \
+        wrap_##name args;                                                \
+    }
+
+GLTRACE_COMMANDS(GLCAPTURE_WRAP)
+
+/* a frame deleting objects it draws cannot loop, deletions are never traced */
+static void deleteLists(GLuint list, GLsizei range)
+{
+    for (uint32_t idx = 0U; idx < nLists;)
+    {
+        if (lists[idx].name >= list && lists[idx].name < list + (GLuint)range)
+        {
+            free(lists[idx].commands.words);
+            lists[idx] = lists[--nLists];
+            memset(&lists[nLists], 0, sizeof(struct List));
+        }
+        else
+        {
+            ++idx;
+        }
+    }
+}
+
+static void deleteTextures(GLsizei n, const GLuint *names)
+{
+    for (GLsizei name = 0; name < n; ++name)
+    {
+        for (uint32_t idx = 0U; idx < nTextures; ++idx)
+        {
+            if (textures[idx] == names[name])
+            {
+                textures[idx] = textures[--nTextures];
+                break;
+            }
+        }
+    }
+}
+
+/*
+  Entry points watched but not traced: deletions update what is recorded,
+  buffer and shader calls mean a capture is incomplete.
+ */
+#define GLCAPTURE_UNTRACED(X)                                                                                                                  \
+    X(glDeleteLists, (GLuint list, GLsizei range), (list, range), deleteLists(list, range))                                                  \
+    X(glDeleteTextures, (GLsizei n, const GLuint *names), (n, names), deleteTextures(n, names))                                              \
+    X(glDrawArrays, (GLenum mode, GLint first, GLsizei count), (mode, first, count), warnUnsupported("glDrawArrays"))                        \
+    X(glDrawElements, (GLenum mode, GLsizei count, GLenum type, const void *indices), (mode, count, type, indices),                           \
+      warnUnsupported("glDrawElements"))                                                                                                     \
+    X(glBindBuffer, (GLenum target, GLuint buffer), (target, buffer), warnUnsupported("glBindBuffer"))                                      \
+    X(glUseProgram, (GLuint program), (program), warnUnsupported("glUseProgram"))
+
+#define GLCAPTURE_WRAP_UNTRACED(name, params, args, hook) \
+    typedef void (*name##Proc) params;                    \
+    static name##Proc real_##name;                        \
+    static void       wrap_##name params                  \
+    {                                                     \
+        if (!initialized)                                 \
+            initialize();                                 \
+        if (NULL == real_##name)                          \
+            real_##name = (name##Proc)resolve(#name);     \
+        real_##name args;                                 \
+        hook;                                             \
+    }                                                     \
+    GLCAPTURE_EXPORT void name params                     \
+    {                                                     \
+        wrap_##name args;                                 \
+    }
+
+GLCAPTURE_UNTRACED(GLCAPTURE_WRAP_UNTRACED)
+
+/* pixels and parameters of every recorded texture, then the compiled display lists */
+static void captureResources(struct Stream *stream)
+{
+    GLint binding = 0, packAlignment = 4;
+
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &binding);
+    glGetIntegerv(GL_PACK_ALIGNMENT, &packAlignment);
+    if (NULL == real_glBindTexture)
+        real_glBindTexture = (glBindTextureProc)resolve("glBindTexture");
+    if (NULL == real_glPixelStorei)
+        real_glPixelStorei = (glPixelStoreiProc)resolve("glPixelStorei");
+    real_glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    put(stream, TRACE_glPixelStorei, GL_UNPACK_ALIGNMENT, 1);
+
+    for (uint32_t idx = 0U; idx < nTextures; ++idx)
+    {
+        static const GLenum parameters[] = {GL_TEXTURE_MIN_FILTER, GL_TEXTURE_MAG_FILTER, GL_TEXTURE_WRAP_S, GL_TEXTURE_WRAP_T};
+
+        if (!glIsTexture(textures[idx]))
+            continue;
+        real_glBindTexture(GL_TEXTURE_2D, textures[idx]);
+        put(stream, TRACE_glBindTexture, GL_TEXTURE_2D, textures[idx]);
+        for (size_t parameter = 0; parameter < sizeof(parameters) / sizeof(parameters[0]); ++parameter)
+        {
+            GLint value = 0;
+            glGetTexParameteriv(GL_TEXTURE_2D, parameters[parameter], &value);
+            put(stream, TRACE_glTexParameteri, GL_TEXTURE_2D, parameters[parameter], value);
+        }
+
+        for (GLint level = 0; level < MAX_LEVELS; ++level)
+        {
+            GLint width = 0, height = 0, internalFormat = GL_RGBA;
+            glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_WIDTH, &width);
+            glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_HEIGHT, &height);
+            glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_INTERNAL_FORMAT, &internalFormat);
+            if (0 >= width || 0 >= height)
+                break;
+
+            size_t   size   = (size_t)width * height * 4U;
+            GLubyte *pixels = (GLubyte *)malloc(size);
+            if (NULL == pixels)
+            {
+                fprintf(stderr, "[%s] out of memory reading texture %u\n", __func__, textures[idx]);
+                break;
+            }
+            glGetTexImage(GL_TEXTURE_2D, level, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+            put(stream, TRACE_glTexImage2D, GL_TEXTURE_2D, level, internalFormat, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, (int)size, pixels);
+            free(pixels);
+        }
+    }
+
+    real_glBindTexture(GL_TEXTURE_2D, binding);
+    real_glPixelStorei(GL_PACK_ALIGNMENT, packAlignment);
+
+    for (uint32_t idx = 0U; idx < nLists; ++idx)
+    {
+        put(stream, TRACE_glNewList, lists[idx].name, GL_COMPILE);
+        append(stream, &lists[idx].commands);
+        put(stream, TRACE_glEndList);
+    }
+}
+
+static void captureCapability(struct Stream *stream, GLenum cap)
+{
+    put(stream, glIsEnabled(cap) ? TRACE_glEnable : TRACE_glDisable, cap);
+}
+
+/* fixed function state at the start of the frame, values kept in eye space are set with an identity modelview */
+static void captureState(struct Stream *stream, GLint viewport[4])
+{
+    static const GLenum capabilities[] = {GL_LIGHTING,  GL_DEPTH_TEST,    GL_CULL_FACE,      GL_BLEND,       GL_STENCIL_TEST,        GL_ALPHA_TEST,  GL_TEXTURE_2D,
+                                          GL_NORMALIZE, GL_RESCALE_NORMAL, GL_COLOR_MATERIAL, GL_SCISSOR_TEST, GL_POLYGON_OFFSET_FILL, GL_LINE_SMOOTH, GL_DITHER};
+    static const GLenum lightFloats[]  = {GL_SPOT_EXPONENT, GL_SPOT_CUTOFF, GL_CONSTANT_ATTENUATION, GL_LINEAR_ATTENUATION, GL_QUADRATIC_ATTENUATION};
+    static const GLenum lightVectors[] = {GL_AMBIENT, GL_DIFFUSE, GL_SPECULAR, GL_POSITION, GL_SPOT_DIRECTION};
+    static const GLenum materials[]    = {GL_AMBIENT, GL_DIFFUSE, GL_SPECULAR, GL_EMISSION, GL_SHININESS};
+    static const GLenum faces[]        = {GL_FRONT, GL_BACK};
+    static const GLenum matrixModes[]  = {GL_TEXTURE, GL_PROJECTION, GL_MODELVIEW};
+    static const GLenum matrices[]     = {GL_TEXTURE_MATRIX, GL_PROJECTION_MATRIX, GL_MODELVIEW_MATRIX};
+    GLint               values[4]      = {0};
+    GLfloat             floats[16]     = {0.0f};
+    GLdouble            doubles[4]     = {0.0};
+    GLboolean           booleans[4]    = {0};
+    GLint               nLights = 0, nPlanes = 0, depth = 0, mode = 0;
+
+    glGetIntegerv(GL_MODELVIEW_STACK_DEPTH, &depth);
+    if (1 != depth)
+        fprintf(stderr, "[glcapture] modelview stack is %d deep at the start of the frame, only its top is captured\n", depth);
+    glGetIntegerv(GL_ATTRIB_STACK_DEPTH, &depth);
+    if (0 != depth)
+        fprintf(stderr, "[glcapture] attribute stack is %d deep at the start of the frame, it is not captured\n", depth);
+
+    /* material tracking would overwrite the materials set below */
+    put(stream, TRACE_glDisable, GL_COLOR_MATERIAL);
+    put(stream, TRACE_glMatrixMode, GL_MODELVIEW);
+    put(stream, TRACE_glLoadIdentity);
+
+    glGetIntegerv(GL_MAX_LIGHTS, &nLights);
+    for (GLint light = 0; light < nLights && light < 8; ++light)
+    {
+        for (size_t idx = 0; idx < sizeof(lightVectors) / sizeof(lightVectors[0]); ++idx)
+        {
+            glGetLightfv(GL_LIGHT0 + light, lightVectors[idx], floats);
+            put(stream, TRACE_glLightfv, GL_LIGHT0 + light, lightVectors[idx], lightValues(lightVectors[idx]), floats);
+        }
+        for (size_t idx = 0; idx < sizeof(lightFloats) / sizeof(lightFloats[0]); ++idx)
+        {
+            glGetLightfv(GL_LIGHT0 + light, lightFloats[idx], floats);
+            put(stream, TRACE_glLightf, GL_LIGHT0 + light, lightFloats[idx], (double)floats[0]);
+        }
+        captureCapability(stream, GL_LIGHT0 + light);
+    }
+
+    glGetIntegerv(GL_MAX_CLIP_PLANES, &nPlanes);
+    for (GLint plane = 0; plane < nPlanes && plane < 6; ++plane)
+    {
+        glGetClipPlane(GL_CLIP_PLANE0 + plane, doubles);
+        put(stream, TRACE_glClipPlane, GL_CLIP_PLANE0 + plane, 4, doubles);
+        captureCapability(stream, GL_CLIP_PLANE0 + plane);
+    }
+
+    glGetFloatv(GL_LIGHT_MODEL_AMBIENT, floats);
+    put(stream, TRACE_glLightModelfv, GL_LIGHT_MODEL_AMBIENT, 4, floats);
+    glGetIntegerv(GL_LIGHT_MODEL_LOCAL_VIEWER, values);
+    put(stream, TRACE_glLightModeli, GL_LIGHT_MODEL_LOCAL_VIEWER, values[0]);
+    glGetIntegerv(GL_LIGHT_MODEL_TWO_SIDE, values);
+    put(stream, TRACE_glLightModeli, GL_LIGHT_MODEL_TWO_SIDE, values[0]);
+
+    for (size_t face = 0; face < 2U; ++face)
+    {
+        for (size_t idx = 0; idx < sizeof(materials) / sizeof(materials[0]); ++idx)
+        {
+            glGetMaterialfv(faces[face], materials[idx], floats);
+            put(stream, TRACE_glMaterialfv, faces[face], materials[idx], materialValues(materials[idx]), floats);
+        }
+    }
+    glGetIntegerv(GL_COLOR_MATERIAL_FACE, &values[0]);
+    glGetIntegerv(GL_COLOR_MATERIAL_PARAMETER, &values[1]);
+    put(stream, TRACE_glColorMaterial, values[0], values[1]);
+
+    glGetIntegerv(GL_DEPTH_FUNC, values);
+    put(stream, TRACE_glDepthFunc, values[0]);
+    glGetBooleanv(GL_DEPTH_WRITEMASK, booleans);
+    put(stream, TRACE_glDepthMask, booleans[0]);
+    glGetDoublev(GL_DEPTH_CLEAR_VALUE, doubles);
+    put(stream, TRACE_glClearDepth, doubles[0]);
+    glGetFloatv(GL_COLOR_CLEAR_VALUE, floats);
+    put(stream, TRACE_glClearColor, (double)floats[0], (double)floats[1], (double)floats[2], (double)floats[3]);
+    glGetIntegerv(GL_STENCIL_CLEAR_VALUE, values);
+    put(stream, TRACE_glClearStencil, values[0]);
+
+    glGetIntegerv(GL_STENCIL_FUNC, &values[0]);
+    glGetIntegerv(GL_STENCIL_REF, &values[1]);
+    glGetIntegerv(GL_STENCIL_VALUE_MASK, &values[2]);
+    put(stream, TRACE_glStencilFunc, values[0], values[1], values[2]);
+    glGetIntegerv(GL_STENCIL_FAIL, &values[0]);
+    glGetIntegerv(GL_STENCIL_PASS_DEPTH_FAIL, &values[1]);
+    glGetIntegerv(GL_STENCIL_PASS_DEPTH_PASS, &values[2]);
+    put(stream, TRACE_glStencilOp, values[0], values[1], values[2]);
+    glGetIntegerv(GL_STENCIL_WRITEMASK, values);
+    put(stream, TRACE_glStencilMask, values[0]);
+
+    glGetIntegerv(GL_BLEND_SRC, &values[0]);
+    glGetIntegerv(GL_BLEND_DST, &values[1]);
+    put(stream, TRACE_glBlendFunc, values[0], values[1]);
+    glGetIntegerv(GL_ALPHA_TEST_FUNC, values);
+    glGetFloatv(GL_ALPHA_TEST_REF, floats);
+    put(stream, TRACE_glAlphaFunc, values[0], (double)floats[0]);
+    glGetBooleanv(GL_COLOR_WRITEMASK, booleans);
+    put(stream, TRACE_glColorMask, booleans[0], booleans[1], booleans[2], booleans[3]);
+
+    glGetIntegerv(GL_CULL_FACE_MODE, values);
+    put(stream, TRACE_glCullFace, values[0]);
+    glGetIntegerv(GL_FRONT_FACE, values);
+    put(stream, TRACE_glFrontFace, values[0]);
+    glGetIntegerv(GL_SHADE_MODEL, values);
+    put(stream, TRACE_glShadeModel, values[0]);
+    glGetIntegerv(GL_POLYGON_MODE, values);
+    put(stream, TRACE_glPolygonMode, GL_FRONT, values[0]);
+    put(stream, TRACE_glPolygonMode, GL_BACK, values[1]);
+    glGetFloatv(GL_LINE_WIDTH, floats);
+    put(stream, TRACE_glLineWidth, (double)floats[0]);
+    glGetFloatv(GL_POINT_SIZE, floats);
+    put(stream, TRACE_glPointSize, (double)floats[0]);
+
+    glGetIntegerv(GL_SCISSOR_BOX, values);
+    put(stream, TRACE_glScissor, values[0], values[1], values[2], values[3]);
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    put(stream, TRACE_glViewport, viewport[0], viewport[1], viewport[2], viewport[3]);
+
+    glGetTexEnviv(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, values);
+    put(stream, TRACE_glTexEnvi, GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, values[0]);
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, values);
+    put(stream, TRACE_glPixelStorei, GL_UNPACK_ALIGNMENT, values[0]);
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, values);
+    put(stream, TRACE_glBindTexture, GL_TEXTURE_2D, values[0]);
+
+    for (size_t idx = 0; idx < sizeof(capabilities) / sizeof(capabilities[0]); ++idx)
+        captureCapability(stream, capabilities[idx]);
+
+    /* after the materials, with tracking enabled the current color updates them as it did in the sample */
+    glGetFloatv(GL_CURRENT_COLOR, floats);
+    put(stream, TRACE_glColor4f, (double)floats[0], (double)floats[1], (double)floats[2], (double)floats[3]);
+    glGetFloatv(GL_CURRENT_NORMAL, floats);
+    put(stream, TRACE_glNormal3f, (double)floats[0], (double)floats[1], (double)floats[2]);
+    glGetFloatv(GL_CURRENT_TEXTURE_COORDS, floats);
+    put(stream, TRACE_glTexCoord2f, (double)floats[0], (double)floats[1]);
+
+    for (size_t idx = 0; idx < 3U; ++idx)
+    {
+        glGetFloatv(matrices[idx], floats);
+        put(stream, TRACE_glMatrixMode, matrixModes[idx]);
+        put(stream, TRACE_glLoadMatrixf, 16, floats);
+    }
+    glGetIntegerv(GL_MATRIX_MODE, &mode);
+    put(stream, TRACE_glMatrixMode, mode);
+}
+
+static void beginCapture(void)
+{
+    GLint viewport[4] = {0};
+
+    for (int block = 0; block < N_TRACE_BLOCKS; ++block)
+    {
+        blocks[block].nWords    = 0U;
+        blocks[block].nCommands = 0U;
+    }
+    captureResources(&blocks[TRACE_BLOCK_RESOURCES]);
+    captureState(&blocks[TRACE_BLOCK_STATE], viewport);
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, GLTRACE_MAGIC, sizeof(GLTRACE_MAGIC));
+    header.version = GLTRACE_VERSION;
+    header.frame   = nFrames;
+    header.width   = (uint32_t)(viewport[0] + viewport[2]);
+    header.height  = (uint32_t)(viewport[1] + viewport[3]);
+    captureFrame   = nFrames;
+    capturing      = 1;
+}
+
+static void endCapture(void)
+{
+    char  path[512];
+    FILE *pFile = NULL;
+    int   ok    = 1;
+
+    capturing = 0;
+    snprintf(path, sizeof(path), "%s-%u.gltrace", prefix, captureFrame);
+    for (int block = 0; block < N_TRACE_BLOCKS; ++block)
+    {
+        header.blockBytes[block]    = (uint32_t)(blocks[block].nWords * sizeof(uint32_t));
+        header.blockCommands[block] = blocks[block].nCommands;
+    }
+
+    pFile = fopen(path, "wb");
+    if (NULL == pFile)
+    {
+        fprintf(stderr, "[%s] cannot write %s\n", __func__, path);
+        return;
+    }
+    ok = 1 == fwrite(&header, sizeof(header), 1, pFile);
+    for (int block = 0; block < N_TRACE_BLOCKS && ok; ++block)
+        ok = blocks[block].nWords == fwrite(blocks[block].words, sizeof(uint32_t), blocks[block].nWords, pFile);
+    if (0 != fclose(pFile) || !ok)
+    {
+        fprintf(stderr, "[%s] cannot write %s\n", __func__, path);
+        return;
+    }
+
+    fprintf(stderr, "[glcapture] frame %u: %u commands, %u for state and %u for resources, %.1f KiB in %s\n", captureFrame, header.blockCommands[TRACE_BLOCK_FRAME],
+            header.blockCommands[TRACE_BLOCK_STATE], header.blockCommands[TRACE_BLOCK_RESOURCES],
+            (sizeof(header) + header.blockBytes[0] + header.blockBytes[1] + header.blockBytes[2]) / 1024.0, path);
+}
+
+GLCAPTURE_EXPORT void glXSwapBuffers(Display *dpy, GLXDrawable drawable)
+{
+    static void (*real)(Display *, GLXDrawable);
+
+    if (!initialized)
+        initialize();
+    if (NULL == real)
+        real = (void (*)(Display *, GLXDrawable))dlsym(RTLD_NEXT, "glXSwapBuffers");
+
+    real(dpy, drawable);
+    if (capturing)
+        endCapture();
+
+    /* the next frame starts here, with the state its trace begins from */
+    ++nFrames;
+    if (isRequested || nFrames == requestedFrame)
+    {
+        isRequested = 0;
+        beginCapture();
+    }
+}
+
+/* loaders get the wrapper of every entry point recorded here */
+static __GLXextFuncPtr wrapper(const GLubyte *procName)
+{
+#define GLCAPTURE_LOOKUP(name, params, args, format, record, replay, hook) \
+    if (0 == strcmp((const char *)procName, #name))                        \
+        return (__GLXextFuncPtr)wrap_##name;
+#define GLCAPTURE_LOOKUP_UNTRACED(name, params, args, hook) \
+    if (0 == strcmp((const char *)procName, #name))          \
+        return (__GLXextFuncPtr)wrap_##name;
+    GLTRACE_COMMANDS(GLCAPTURE_LOOKUP)
+    GLCAPTURE_UNTRACED(GLCAPTURE_LOOKUP_UNTRACED)
+    if (0 == strcmp((const char *)procName, "glXSwapBuffers"))
+        return (__GLXextFuncPtr)glXSwapBuffers;
+    return NULL;
+}
+
+GLCAPTURE_EXPORT __GLXextFuncPtr glXGetProcAddressARB(const GLubyte *procName)
+{
+    static __GLXextFuncPtr (*real)(const GLubyte *);
+    __GLXextFuncPtr proc = wrapper(procName);
+
+    if (NULL != proc)
+        return proc;
+    if (NULL == real)
+        real = (__GLXextFuncPtr(*)(const GLubyte *))dlsym(RTLD_NEXT, "glXGetProcAddressARB");
+    return real(procName);
+}
+
+GLCAPTURE_EXPORT __GLXextFuncPtr glXGetProcAddress(const GLubyte *procName)
+{
+    return glXGetProcAddressARB(procName);
+}
@@ -0,0 +1,441 @@
+/**
+ * @file      glcount.c
+ * @brief     LD_PRELOAD shim counting GL calls, redundant binds and driver time per frame
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * Usage: LD_PRELOAD=/path/to/glcount.so ./sample
+ *
+ * Every wrapped entry point is both exported under its own name, for samples
+ * linking libGL directly, and handed out by glXGetProcAddress, for samples
+ * loading through GLEW. glXSwapBuffers closes a frame. A bind of the object
+ * already bound counts as redundant, as does enabling an enabled capability.
+ * Time in the driver is the wall time of the real call, which for a
+ * pipelined driver is mostly validation and command building.
+ *
+ *   GLCOUNT_INTERVAL  print a frame summary every this many frames, 60 by default, 0 never
+ *   GLCOUNT_OUTPUT    write the calls of every frame per entry point as CSV
+ *   GLCOUNT_TIME      0 skips timing the calls, for immediate mode heavy samples
+ *
+ * The summary of the whole run is printed at exit. Bound objects are tracked
+ * for a single context on a single thread.
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#define _GNU_SOURCE
+#define GL_GLEXT_PROTOTYPES
+#include <GL/gl.h>
+#include <GL/glext.h>
+#include <GL/glx.h>
+
+#include <dlfcn.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define GLCOUNT_EXPORT __attribute__((visibility("default")))
+
+/* texture units and enable capabilities tracked for redundancy */
+#define MAX_UNITS 32
+#define MAX_CAPS  64
+
+/* object names are never 0xffffffff, bindings start unknown */
+#define UNKNOWN 0xffffffffU
+
+enum Category
+{
+    CATEGORY_DRAW,
+    CATEGORY_BIND,
+    CATEGORY_UNIFORM,
+    CATEGORY_STATE,
+    CATEGORY_UPLOAD,
+    CATEGORY_IMMEDIATE,
+    CATEGORY_SWAP,
+    N_CATEGORIES
+};
+
+static const char *categoryNames[N_CATEGORIES] = {"draws", "binds", "uniforms", "state", "uploads", "immediate", "swap"};
+
+/*
+  Wrapped entry points: name, parameters, arguments, category and a
+  statement run before the call that sets redundant.
+ */
+#define GLCOUNT_ENTRIES(X)                                                                                                                                                    \
+    X(glDrawArrays, (GLenum mode, GLint first, GLsizei count), (mode, first, count), CATEGORY_DRAW, )                                                                      \
+    X(glDrawElements, (GLenum mode, GLsizei count, GLenum type, const void *indices), (mode, count, type, indices), CATEGORY_DRAW, )                                         \
+    X(glDrawArraysInstanced, (GLenum mode, GLint first, GLsizei count, GLsizei instances), (mode, first, count, instances), CATEGORY_DRAW, )                                \
+    X(glDrawElementsInstanced, (GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei instances), (mode, count, type, indices, instances), CATEGORY_DRAW, ) \
+    X(glMultiDrawElementsIndirect, (GLenum mode, GLenum type, const void *indirect, GLsizei drawcount, GLsizei stride), (mode, type, indirect, drawcount, stride),        \
+      CATEGORY_DRAW, )                                                                                                                                                     \
+    X(glCallList, (GLuint list), (list), CATEGORY_DRAW, )                                                                                                                  \
+    X(glBegin, (GLenum mode), (mode), CATEGORY_DRAW, )                                                                                                                     \
+    X(glClear, (GLbitfield mask), (mask), CATEGORY_DRAW, )                                                                                                                 \
+    X(glUseProgram, (GLuint program), (program), CATEGORY_BIND, redundant = track(&bound.program, program))                                                               \
+    X(glActiveTexture, (GLenum texture), (texture), CATEGORY_BIND, redundant = track(&bound.unit, texture - GL_TEXTURE0))                                                 \
+    X(glBindTexture, (GLenum target, GLuint texture), (target, texture), CATEGORY_BIND, redundant = bindTexture(target, texture))                                         \
+    X(glBindBuffer, (GLenum target, GLuint buffer), (target, buffer), CATEGORY_BIND, redundant = bindBuffer(target, buffer))                                              \
+    X(glBindBufferRange, (GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size), (target, index, buffer, offset, size), CATEGORY_BIND, )          \
+    X(glBindVertexArray, (GLuint array), (array), CATEGORY_BIND, redundant = bindVertexArray(array))                                                                      \
+    X(glBindFramebuffer, (GLenum target, GLuint framebuffer), (target, framebuffer), CATEGORY_BIND, redundant = track(&bound.framebuffer, framebuffer))                   \
+    X(glUniform1i, (GLint location, GLint v0), (location, v0), CATEGORY_UNIFORM, )                                                                                        \
+    X(glUniform1f, (GLint location, GLfloat v0), (location, v0), CATEGORY_UNIFORM, )                                                                                      \
+    X(glUniform2f, (GLint location, GLfloat v0, GLfloat v1), (location, v0, v1), CATEGORY_UNIFORM, )                                                                      \
+    X(glUniform3f, (GLint location, GLfloat v0, GLfloat v1, GLfloat v2), (location, v0, v1, v2), CATEGORY_UNIFORM, )                                                      \
+    X(glUniform4f, (GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3), (location, v0, v1, v2, v3), CATEGORY_UNIFORM, )                                      \
+    X(glUniform1fv, (GLint location, GLsizei count, const GLfloat *value), (location, count, value), CATEGORY_UNIFORM, )                                                  \
+    X(glUniform3fv, (GLint location, GLsizei count, const GLfloat *value), (location, count, value), CATEGORY_UNIFORM, )                                                  \
+    X(glUniform4fv, (GLint location, GLsizei count, const GLfloat *value), (location, count, value), CATEGORY_UNIFORM, )                                                  \
+    X(glUniformMatrix3fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (location, count, transpose, value), CATEGORY_UNIFORM, )           \
+    X(glUniformMatrix4fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (location, count, transpose, value), CATEGORY_UNIFORM, )           \
+    X(glEnable, (GLenum cap), (cap), CATEGORY_STATE, redundant = setCapability(cap, 1))                                                                                   \
+    X(glDisable, (GLenum cap), (cap), CATEGORY_STATE, redundant = setCapability(cap, 0))                                                                                  \
+    X(glEnableVertexAttribArray, (GLuint index), (index), CATEGORY_STATE, )                                                                                               \
+    X(glDisableVertexAttribArray, (GLuint index), (index), CATEGORY_STATE, )                                                                                              \
+    X(glVertexAttribPointer, (GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void *pointer),                                        \
+      (index, size, type, normalized, stride, pointer), CATEGORY_STATE, )                                                                                                  \
+    X(glDepthFunc, (GLenum func), (func), CATEGORY_STATE, )                                                                                                                \
+    X(glBlendFunc, (GLenum sfactor, GLenum dfactor), (sfactor, dfactor), CATEGORY_STATE, )                                                                                \
+    X(glCullFace, (GLenum mode), (mode), CATEGORY_STATE, )                                                                                                                 \
+    X(glFrontFace, (GLenum mode), (mode), CATEGORY_STATE, )                                                                                                                \
+    X(glColorMask, (GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha), (red, green, blue, alpha), CATEGORY_STATE, )                                        \
+    X(glStencilFunc, (GLenum func, GLint ref, GLuint mask), (func, ref, mask), CATEGORY_STATE, )                                                                          \
+    X(glStencilOp, (GLenum fail, GLenum zfail, GLenum zpass), (fail, zfail, zpass), CATEGORY_STATE, )                                                                     \
+    X(glStencilMask, (GLuint mask), (mask), CATEGORY_STATE, )                                                                                                              \
+    X(glViewport, (GLint x, GLint y, GLsizei width, GLsizei height), (x, y, width, height), CATEGORY_STATE, )                                                             \
+    X(glMatrixMode, (GLenum mode), (mode), CATEGORY_STATE, )                                                                                                               \
+    X(glLoadIdentity, (void), (), CATEGORY_STATE, )                                                                                                                        \
+    X(glPushMatrix, (void), (), CATEGORY_STATE, )                                                                                                                          \
+    X(glPopMatrix, (void), (), CATEGORY_STATE, )                                                                                                                           \
+    X(glTranslatef, (GLfloat x, GLfloat y, GLfloat z), (x, y, z), CATEGORY_STATE, )                                                                                        \
+    X(glRotatef, (GLfloat angle, GLfloat x, GLfloat y, GLfloat z), (angle, x, y, z), CATEGORY_STATE, )                                                                     \
+    X(glScalef, (GLfloat x, GLfloat y, GLfloat z), (x, y, z), CATEGORY_STATE, )                                                                                            \
+    X(glMultMatrixf, (const GLfloat *m), (m), CATEGORY_STATE, )                                                                                                            \
+    X(glPushAttrib, (GLbitfield mask), (mask), CATEGORY_STATE, )                                                                                                          \
+    X(glPopAttrib, (void), (), CATEGORY_STATE, bound.nCaps = 0) /* restores enables behind our back */                                                                   \
+    X(glLightfv, (GLenum light, GLenum pname, const GLfloat *params), (light, pname, params), CATEGORY_STATE, )                                                           \
+    X(glMaterialfv, (GLenum face, GLenum pname, const GLfloat *params), (face, pname, params), CATEGORY_STATE, )                                                          \
+    X(glBufferData, (GLenum target, GLsizeiptr size, const void *data, GLenum usage), (target, size, data, usage), CATEGORY_UPLOAD, )                                     \
+    X(glBufferSubData, (GLenum target, GLintptr offset, GLsizeiptr size, const void *data), (target, offset, size, data), CATEGORY_UPLOAD, )                              \
+    X(glTexImage2D, (GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void *pixels),     \
+      (target, level, internalformat, width, height, border, format, type, pixels), CATEGORY_UPLOAD, )                                                                     \
+    X(glTexSubImage2D, (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void *pixels),        \
+      (target, level, xoffset, yoffset, width, height, format, type, pixels), CATEGORY_UPLOAD, )                                                                           \
+    X(glEnd, (void), (), CATEGORY_IMMEDIATE, )                                                                                                                             \
+    X(glVertex2f, (GLfloat x, GLfloat y), (x, y), CATEGORY_IMMEDIATE, )                                                                                                    \
+    X(glVertex3f, (GLfloat x, GLfloat y, GLfloat z), (x, y, z), CATEGORY_IMMEDIATE, )                                                                                      \
+    X(glNormal3f, (GLfloat nx, GLfloat ny, GLfloat nz), (nx, ny, nz), CATEGORY_IMMEDIATE, )                                                                                \
+    X(glColor3f, (GLfloat red, GLfloat green, GLfloat blue), (red, green, blue), CATEGORY_IMMEDIATE, )                                                                    \
+    X(glColor3ubv, (const GLubyte *v), (v), CATEGORY_IMMEDIATE, )                                                                                                          \
+    X(glTexCoord2f, (GLfloat s, GLfloat t), (s, t), CATEGORY_IMMEDIATE, )
+
+#define GLCOUNT_ENUM(name, params, args, category, hook) ENTRY_##name,
+enum Entry
+{
+    GLCOUNT_ENTRIES(GLCOUNT_ENUM) ENTRY_glXSwapBuffers,
+    N_ENTRIES
+};
+
+struct Counter
+{
+    uint64_t calls;
+    uint64_t redundant;
+    uint64_t ns;       // time in the real call
+    uint32_t frameMax; // most calls in one frame
+};
+
+struct Bound
+{
+    GLuint unit;
+    GLuint program;
+    GLuint vertexArray;
+    GLuint framebuffer;
+    GLuint textures[MAX_UNITS][4]; // 1D, 2D, 3D, 2D array
+    GLuint buffers[6];             // array, element, uniform, indirect, pixel unpack, pixel pack
+    GLenum caps[MAX_CAPS];
+    int    capStates[MAX_CAPS];
+    int    nCaps;
+};
+
+#define GLCOUNT_NAME(name, params, args, category, hook) #name,
+static const char *entryNames[N_ENTRIES] = {GLCOUNT_ENTRIES(GLCOUNT_NAME) "glXSwapBuffers"};
+
+#define GLCOUNT_CATEGORY(name, params, args, category, hook) category,
+static const enum Category entryCategories[N_ENTRIES] = {GLCOUNT_ENTRIES(GLCOUNT_CATEGORY) CATEGORY_SWAP};
+
+static struct Counter totals[N_ENTRIES];
+static uint32_t       frameCalls[N_ENTRIES];
+static uint32_t       frameRedundant;
+static uint64_t       frameNs;
+static uint64_t       nFrames;
+static struct Bound   bound;
+static int            initialized;
+static int            timing = 1;
+static uint32_t       interval = 60;
+static FILE          *pCsv;
+
+static uint64_t now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void initialize(void)
+{
+    const char *value;
+
+    initialized = 1;
+    memset(&bound, 0xff, sizeof(bound));
+    bound.unit  = 0U; // GL_TEXTURE0 is active in a new context
+    bound.nCaps = 0;
+
+    if (NULL != (value = getenv("GLCOUNT_INTERVAL")))
+        interval = (uint32_t)atoi(value);
+    if (NULL != (value = getenv("GLCOUNT_TIME")))
+        timing = 0 != atoi(value);
+    if (NULL != (value = getenv("GLCOUNT_OUTPUT")))
+    {
+        pCsv = fopen(value, "w");
+        if (NULL == pCsv)
+        {
+            fprintf(stderr, "[%s] cannot write %s\n", __func__, value);
+            return;
+        }
+        fprintf(pCsv, "frame,driver_us");
+        for (int entry = 0; entry < N_ENTRIES; ++entry)
+            fprintf(pCsv, ",%s", entryNames[entry]);
+        fprintf(pCsv, "\n");
+    }
+}
+
+/* real entry point behind the wrapper, the driver's when it has one */
+static void *resolve(const char *name)
+{
+    static __GLXextFuncPtr (*getProcAddress)(const GLubyte *);
+    void *proc = NULL;
+
+    if (NULL == getProcAddress)
+        getProcAddress = (__GLXextFuncPtr(*)(const GLubyte *))dlsym(RTLD_NEXT, "glXGetProcAddressARB");
+    if (NULL != getProcAddress)
+        proc = (void *)getProcAddress((const GLubyte *)name);
+    if (NULL == proc)
+        proc = dlsym(RTLD_NEXT, name);
+    if (NULL == proc)
+        fprintf(stderr, "[%s] %s not found\n", __func__, name);
+    return proc;
+}
+
+static int track(GLuint *slot, GLuint object)
+{
+    int redundant = *slot == object;
+    *slot         = object;
+    return redundant;
+}
+
+static int bindTexture(GLenum target, GLuint texture)
+{
+    int index = GL_TEXTURE_1D == target ? 0 : GL_TEXTURE_2D == target ? 1 : GL_TEXTURE_3D == target ? 2 : GL_TEXTURE_2D_ARRAY == target ? 3 : -1;
+    if (0 > index || bound.unit >= MAX_UNITS)
+        return 0;
+    return track(&bound.textures[bound.unit][index], texture);
+}
+
+static int bindBuffer(GLenum target, GLuint buffer)
+{
+    static const GLenum targets[] = {GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER, GL_UNIFORM_BUFFER, GL_DRAW_INDIRECT_BUFFER, GL_PIXEL_UNPACK_BUFFER, GL_PIXEL_PACK_BUFFER};
+    for (int index = 0; index < 6; ++index)
+    {
+        if (targets[index] == target)
+            return track(&bound.buffers[index], buffer);
+    }
+    return 0;
+}
+
+static int bindVertexArray(GLuint array)
+{
+    /* the element buffer binding belongs to the vertex array */
+    if (bound.vertexArray != array)
+        bound.buffers[1] = UNKNOWN;
+    return track(&bound.vertexArray, array);
+}
+
+static int setCapability(GLenum cap, int enabled)
+{
+    int idx = 0;
+    while (idx < bound.nCaps && bound.caps[idx] != cap) { ++idx; }
+    if (idx == bound.nCaps)
+    {
+        if (MAX_CAPS == bound.nCaps)
+            return 0;
+        bound.caps[bound.nCaps]        = cap;
+        bound.capStates[bound.nCaps++] = -1;
+    }
+
+    int redundant        = bound.capStates[idx] == enabled;
+    bound.capStates[idx] = enabled;
+    return redundant;
+}
+
+static void record(enum Entry entry, int redundant, uint64_t ns)
+{
+    frameCalls[entry]++;
+    frameRedundant += redundant;
+    frameNs += ns;
+    totals[entry].calls++;
+    totals[entry].redundant += redundant;
+    totals[entry].ns += ns;
+}
+
+static void endFrame(void)
+{
+    uint32_t byCategory[N_CATEGORIES] = {0};
+
+    for (int entry = 0; entry < N_ENTRIES; ++entry)
+    {
+        byCategory[entryCategories[entry]] += frameCalls[entry];
+        if (frameCalls[entry] > totals[entry].frameMax)
+            totals[entry].frameMax = frameCalls[entry];
+    }
+
+    if (NULL != pCsv)
+    {
+        fprintf(pCsv, "%lu,%.1f", (unsigned long)nFrames, frameNs * 1e-3);
+        for (int entry = 0; entry < N_ENTRIES; ++entry)
+            fprintf(pCsv, ",%u", frameCalls[entry]);
+        fprintf(pCsv, "\n");
+    }
+
+    if (0 != interval && 0 == nFrames % interval)
+    {
+        fprintf(stderr, "[glcount] frame %lu: %u draws, %u binds (%u redundant), %u uniforms, %u state, %u immediate, %.3f ms in driver\n", (unsigned long)nFrames,
+                byCategory[CATEGORY_DRAW], byCategory[CATEGORY_BIND], frameRedundant, byCategory[CATEGORY_UNIFORM], byCategory[CATEGORY_STATE], byCategory[CATEGORY_IMMEDIATE],
+                frameNs * 1e-6);
+    }
+
+    memset(frameCalls, 0, sizeof(frameCalls));
+    frameRedundant = 0;
+    frameNs        = 0;
+    nFrames++;
+}
+
+#define GLCOUNT_WRAP(name, params, args, category, hook)                     \
+    typedef void (*name##Proc) params;                                        \
+    static name##Proc real_##name;                                            \
+    static void       wrap_##name params                                      \
+    {                                                                         \
+        int      redundant = 0;                                               \
+        uint64_t start     = 0;                                               \
+        if (!initialized)                                                     \
+            initialize();                                                     \
+        if (NULL == real_##name)                                              \
+            real_##name = (name##Proc)resolve(#name);                         \
+        hook;                                                                 \
+        if (timing)                                                           \
+            start = now();                                                    \
+        real_##name args;                                                     \
+        record(ENTRY_##name, redundant, timing ? now() - start : 0);          \
+    }                                                                         \
+    GLCOUNT_EXPORT void name params                                           \
+    {                                                                         \
+        wrap_##name args;                                                     \
+    }
+
+GLCOUNT_ENTRIES(GLCOUNT_WRAP)
+
+GLCOUNT_EXPORT void glXSwapBuffers(Display *dpy, GLXDrawable drawable)
+{
+    static void (*real)(Display *, GLXDrawable);
+    uint64_t start = now();
+
+    if (!initialized)
+        initialize();
+    if (NULL == real)
+        real = (void (*)(Display *, GLXDrawable))dlsym(RTLD_NEXT, "glXSwapBuffers");
+
+    real(dpy, drawable);
+    record(ENTRY_glXSwapBuffers, 0, now() - start);
+    endFrame();
+}
+
+/* loaders get the wrapper of every entry point counted here */
+static __GLXextFuncPtr wrapper(const GLubyte *procName)
+{
+#define GLCOUNT_LOOKUP(name, params, args, category, hook) \
+    if (0 == strcmp((const char *)procName, #name))        \
+        return (__GLXextFuncPtr)wrap_##name;
+    GLCOUNT_ENTRIES(GLCOUNT_LOOKUP)
+    if (0 == strcmp((const char *)procName, "glXSwapBuffers"))
+        return (__GLXextFuncPtr)glXSwapBuffers;
+    return NULL;
+}
+
+GLCOUNT_EXPORT __GLXextFuncPtr glXGetProcAddressARB(const GLubyte *procName)
+{
+    static __GLXextFuncPtr (*real)(const GLubyte *);
+    __GLXextFuncPtr proc = wrapper(procName);
+
+    if (NULL != proc)
+        return proc;
+    if (NULL == real)
+        real = (__GLXextFuncPtr(*)(const GLubyte *))dlsym(RTLD_NEXT, "glXGetProcAddressARB");
+    return real(procName);
+}
+
+GLCOUNT_EXPORT __GLXextFuncPtr glXGetProcAddress(const GLubyte *procName)
+{
+    return glXGetProcAddressARB(procName);
+}
+
+static int byTime(const void *a, const void *b)
+{
+    const struct Counter *x = &totals[*(const int *)a], *y = &totals[*(const int *)b];
+    return x->ns != y->ns ? (x->ns < y->ns ? 1 : -1) : (x->calls < y->calls) - (x->calls > y->calls);
+}
+
+__attribute__((destructor)) static void printSummary(void)
+{
+    int      order[N_ENTRIES];
+    uint64_t totalNs = 0;
+    double   frames  = nFrames ? (double)nFrames : 1.0;
+
+    if (!initialized)
+        return;
+
+    for (int entry = 0; entry < N_ENTRIES; ++entry)
+    {
+        order[entry] = entry;
+        totalNs += totals[entry].ns;
+    }
+    qsort(order, N_ENTRIES, sizeof(int), byTime);
+
+    fprintf(stderr, "[glcount] %lu frames, %.3f ms per frame in the driver\n", (unsigned long)nFrames, totalNs * 1e-6 / frames);
+    fprintf(stderr, "%-28s %10s %10s %10s %10s %10s %7s\n", "entry point", "calls", "per frame", "max", "redundant", "ns/call", "time");
+    for (int idx = 0; idx < N_ENTRIES; ++idx)
+    {
+        const struct Counter *counter = &totals[order[idx]];
+        if (0 == counter->calls)
+            continue;
+        fprintf(stderr, "%-28s %10lu %10.1f %10u %9.1f%% %10.0f %6.1f%%\n", entryNames[order[idx]], (unsigned long)counter->calls, counter->calls / frames, counter->frameMax,
+                100.0 * counter->redundant / counter->calls, (double)counter->ns / counter->calls, totalNs ? 100.0 * counter->ns / totalNs : 0.0);
+    }
+
+    for (int category = 0; category < N_CATEGORIES; ++category)
+    {
+        uint64_t calls = 0;
+        for (int entry = 0; entry < N_ENTRIES; ++entry)
+            calls += entryCategories[entry] == (enum Category)category ? totals[entry].calls : 0;
+        fprintf(stderr, "%s%s %.1f", category ? ", " : "per frame: ", categoryNames[category], calls / frames);
+    }
+    fprintf(stderr, "\n");
+
+    if (NULL != pCsv)
+        fclose(pCsv);
+}
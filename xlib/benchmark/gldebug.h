@@ -0,0 +1,333 @@
+#ifndef GLDEBUG_H
+#define GLDEBUG_H
+/**
+ * @file      gldebug.h
+ * @brief     KHR_debug output reporting performance warnings per call site
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * With GL_DEBUG=1 in the environment a sample creates a debug context and
+ * installs a debug message callback. Only performance warnings and errors
+ * are let through, everything else is disabled in the driver with
+ * glDebugMessageControl() so it costs nothing.
+ *
+ * Output is synchronous, the callback runs inside the GL call that caused
+ * the message. The first return address in the sample's own code is the
+ * call site, messages are aggregated per call site and message id. The
+ * first message of a site is printed right away, later ones at most once
+ * per GLDEBUG_INTERVAL_MS with the number suppressed in between, and the
+ * totals are printed at exit. Sites are printed as backtrace_symbols()
+ * shows them, `addr2line -f -e <sample> <offset>` resolves them to a line.
+ * Used from C and C++ samples loading GL through GLEW, header only.
+ *
+ *   struct DebugOutput debug;
+ *   ctxt = debugOutputCreateContext(&debug, dpy, vi);
+ *   glXMakeCurrent(dpy, w, ctxt);
+ *   glewInit();
+ *   debugOutputInstall(&debug);
+ *   ...
+ *   debugOutputReport(&debug, stderr);
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <GL/glew.h>
+#include <GL/glx.h>
+#include <X11/Xlib.h>
+
+#include <execinfo.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* distinct call sites tracked, messages from further sites are only counted */
+#define GLDEBUG_MAX_SITES 64
+
+/* minimum time between two messages printed for the same site */
+#define GLDEBUG_INTERVAL_MS 1000.0
+
+/* frames walked from the callback to find the sample's code, drivers nest a few deep */
+#define GLDEBUG_MAX_FRAMES 32
+
+#define GLDEBUG_MESSAGE_LENGTH 256
+
+/* bounds of the executable's code, provided by the GNU linker */
+extern char __executable_start;
+extern char etext;
+
+struct DebugSite
+{
+    void    *pc;        // return address into the sample, NULL when not found
+    GLuint   id;        // driver specific message id
+    GLenum   type;
+    GLenum   severity;
+    uint32_t count;
+    uint32_t suppressed; // since the last message printed
+    double   lastPrintMs;
+    char     message[GLDEBUG_MESSAGE_LENGTH]; // first message, truncated
+};
+
+struct DebugOutput
+{
+    int              enabled;
+    int              installed;
+    uint32_t         nSites;
+    uint32_t         dropped; // messages of sites beyond GLDEBUG_MAX_SITES
+    struct DebugSite sites[GLDEBUG_MAX_SITES];
+};
+
+static inline double debugOutputClock()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static inline const char *debugOutputTypeName(GLenum type)
+{
+    return GL_DEBUG_TYPE_PERFORMANCE == type ? "performance" : GL_DEBUG_TYPE_ERROR == type ? "error" : "other";
+}
+
+static inline const char *debugOutputSeverityName(GLenum severity)
+{
+    switch (severity)
+    {
+        case GL_DEBUG_SEVERITY_HIGH:
+            return "high";
+        case GL_DEBUG_SEVERITY_MEDIUM:
+            return "medium";
+        case GL_DEBUG_SEVERITY_LOW:
+            return "low";
+        default:
+            return "notification";
+    }
+}
+
+static inline int debugOutputInExecutable(void *pc)
+{
+    return (char *)pc >= &__executable_start && (char *)pc < &etext;
+}
+
+/*
+ * The stack reads callback, driver frames, then the sample's GL call. The
+ * callback and this function are in the executable too, so skip them and
+ * the driver before taking the first frame in the executable.
+ */
+static inline void *debugOutputCallSite()
+{
+    void *frames[GLDEBUG_MAX_FRAMES];
+    int   nFrames = backtrace(frames, GLDEBUG_MAX_FRAMES);
+    int   frame   = 0;
+
+    while (frame < nFrames && debugOutputInExecutable(frames[frame]))
+        ++frame;
+    while (frame < nFrames && !debugOutputInExecutable(frames[frame]))
+        ++frame;
+    return frame < nFrames ? frames[frame] : NULL;
+}
+
+static inline void debugOutputPrint(const struct DebugSite *site, FILE *pFile)
+{
+    char **symbol = NULL;
+
+    if (NULL != site->pc)
+        symbol = backtrace_symbols((void *const *)&site->pc, 1);
+    fprintf(pFile, "[gldebug] %s %s 0x%x at %s", debugOutputTypeName(site->type), debugOutputSeverityName(site->severity), site->id, NULL != symbol ? symbol[0] : "unknown site");
+    if (site->suppressed)
+        fprintf(pFile, " (%u more since last report)", site->suppressed);
+    fprintf(pFile, ": %s\n", site->message);
+    free(symbol);
+}
+
+static void GLAPIENTRY debugOutputCallback(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar *message, const void *userParam)
+{
+    struct DebugOutput *debug = (struct DebugOutput *)userParam;
+    struct DebugSite   *site  = NULL;
+    void               *pc    = NULL;
+    double              time  = 0.0;
+
+    (void)source;
+    (void)length;
+
+    pc = debugOutputCallSite();
+    for (uint32_t idx = 0U; idx < debug->nSites; ++idx)
+    {
+        if (debug->sites[idx].pc == pc && debug->sites[idx].id == id)
+        {
+            site = &debug->sites[idx];
+            break;
+        }
+    }
+
+    if (NULL == site)
+    {
+        if (GLDEBUG_MAX_SITES == debug->nSites)
+        {
+            ++debug->dropped;
+            return;
+        }
+        site = &debug->sites[debug->nSites++];
+        memset(site, 0, sizeof(struct DebugSite));
+        site->pc       = pc;
+        site->id       = id;
+        site->type     = type;
+        site->severity = severity;
+        snprintf(site->message, GLDEBUG_MESSAGE_LENGTH, "%s", message);
+    }
+
+    ++site->count;
+    time = debugOutputClock();
+    if (1U == site->count || time - site->lastPrintMs >= GLDEBUG_INTERVAL_MS)
+    {
+        debugOutputPrint(site, stderr);
+        site->suppressed  = 0U;
+        site->lastPrintMs = time;
+    }
+    else
+    {
+        ++site->suppressed;
+    }
+}
+
+/* a rejected attribute list is reported as an X error, which would end the sample */
+static inline int debugOutputIgnoreXError(Display *dpy, XErrorEvent *event)
+{
+    (void)dpy;
+    (void)event;
+    return 0;
+}
+
+/**
+ * @brief read GL_DEBUG and create the context, a debug context when enabled
+ *
+ * Falls back to the regular context when GLX_ARB_create_context is missing
+ * or the server rejects the attributes.
+ */
+static inline GLXContext debugOutputCreateContext(struct DebugOutput *debug, Display *dpy, XVisualInfo *vi)
+{
+    const char *env = getenv("GL_DEBUG");
+
+    memset(debug, 0, sizeof(struct DebugOutput));
+    debug->enabled = NULL != env && 0 != atoi(env);
+    if (!debug->enabled)
+        return glXCreateContext(dpy, vi, NULL, GL_TRUE);
+
+    PFNGLXCREATECONTEXTATTRIBSARBPROC glXCreateContextAttribsARB = (PFNGLXCREATECONTEXTATTRIBSARBPROC)glXGetProcAddressARB((const GLubyte *)"glXCreateContextAttribsARB");
+    GLXFBConfig                      *configs                    = NULL;
+    GLXContext                        ctxt                       = NULL;
+    int                               nConfigs                   = 0;
+
+    /* the context must be created from the config of the visual the window uses */
+    configs = glXGetFBConfigs(dpy, vi->screen, &nConfigs);
+    for (int idx = 0; NULL != glXCreateContextAttribsARB && idx < nConfigs; ++idx)
+    {
+        int visualId = 0;
+        glXGetFBConfigAttrib(dpy, configs[idx], GLX_VISUAL_ID, &visualId);
+        if ((VisualID)visualId == vi->visualid)
+        {
+            /* no version requested, the server picks the highest compatibility version as glXCreateContext() does */
+            int attributes[] = {GLX_CONTEXT_FLAGS_ARB, GLX_CONTEXT_DEBUG_BIT_ARB, GLX_CONTEXT_PROFILE_MASK_ARB, GLX_CONTEXT_COMPATIBILITY_PROFILE_BIT_ARB, None};
+            int (*handler)(Display *, XErrorEvent *) = XSetErrorHandler(debugOutputIgnoreXError);
+            ctxt                                     = glXCreateContextAttribsARB(dpy, configs[idx], NULL, True, attributes);
+            XSync(dpy, False);
+            XSetErrorHandler(handler);
+            break;
+        }
+    }
+    if (NULL != configs)
+        XFree(configs);
+
+    if (NULL == ctxt)
+    {
+        fprintf(stderr, "[%s] debug context not available, messages depend on the driver\n", __func__);
+        return glXCreateContext(dpy, vi, NULL, GL_TRUE);
+    }
+    return ctxt;
+}
+
+/**
+ * @brief install the callback, to be called once glewInit() succeeded
+ * @return 0 on success or when disabled, -1 without KHR_debug
+ */
+static inline int debugOutputInstall(struct DebugOutput *debug)
+{
+    GLint flags = 0;
+
+    if (!debug->enabled)
+        return 0;
+
+    if (!GLEW_VERSION_4_3 && !GLEW_KHR_debug)
+    {
+        fprintf(stderr, "[%s] KHR_debug is not supported, debug output disabled\n", __func__);
+        debug->enabled = 0;
+        return -1;
+    }
+
+    glGetIntegerv(GL_CONTEXT_FLAGS, &flags);
+    if (0 == (flags & GL_CONTEXT_FLAG_DEBUG_BIT))
+        fprintf(stderr, "[%s] not a debug context, the driver may hold back messages\n", __func__);
+
+    glEnable(GL_DEBUG_OUTPUT);
+    glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+
+    /* filter in the driver, disabled messages are never generated */
+    glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, NULL, GL_FALSE);
+    glDebugMessageControl(GL_DONT_CARE, GL_DEBUG_TYPE_PERFORMANCE, GL_DONT_CARE, 0, NULL, GL_TRUE);
+    glDebugMessageControl(GL_DONT_CARE, GL_DEBUG_TYPE_ERROR, GL_DONT_CARE, 0, NULL, GL_TRUE);
+    glDebugMessageCallback(debugOutputCallback, debug);
+
+    debug->installed = 1;
+    fprintf(stderr, "[%s] reporting performance warnings and errors\n", __func__);
+    return 0;
+}
+
+/**
+ * @brief totals per call site, sites with the most messages first
+ */
+static inline void debugOutputReport(struct DebugOutput *debug, FILE *pFile)
+{
+    if (!debug->installed)
+        return;
+
+    glDebugMessageCallback(NULL, NULL);
+    debug->installed = 0;
+
+    /* a few dozen sites at most, selection sort keeps the header free of a comparator */
+    for (uint32_t idx = 0U; idx < debug->nSites; ++idx)
+    {
+        uint32_t max = idx;
+        for (uint32_t other = idx + 1U; other < debug->nSites; ++other)
+        {
+            if (debug->sites[other].count > debug->sites[max].count)
+                max = other;
+        }
+        if (max != idx)
+        {
+            struct DebugSite site = debug->sites[idx];
+            debug->sites[idx]     = debug->sites[max];
+            debug->sites[max]     = site;
+        }
+    }
+
+    fprintf(pFile, "[%s] %u call sites\n", __func__, debug->nSites);
+    for (uint32_t idx = 0U; idx < debug->nSites; ++idx)
+    {
+        char **symbol = NULL;
+        if (NULL != debug->sites[idx].pc)
+            symbol = backtrace_symbols((void *const *)&debug->sites[idx].pc, 1);
+        fprintf(pFile, "    %8u  %-11s 0x%-6x %s: %s\n", debug->sites[idx].count, debugOutputTypeName(debug->sites[idx].type), debug->sites[idx].id, NULL != symbol ? symbol[0] : "unknown site",
+                debug->sites[idx].message);
+        free(symbol);
+    }
+    if (debug->dropped)
+        fprintf(pFile, "    %8u  messages from further sites\n", debug->dropped);
+}
+
+#endif
@@ -0,0 +1,280 @@
+/**
+ * @file      glreplay.c
+ * @brief     Replay a frame captured by glcapture in a loop
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * Usage: glreplay capture-600.gltrace
+ *
+ * Creates a window of the captured viewport, runs the resource block once and
+ * then the state and frame blocks every frame, so each frame renders the same
+ * image with the sample's own logic taken out of the loop. The average frame
+ * time is printed every second. With BENCHMARK_FRAMES set the replay runs
+ * as a fixed workload and writes a benchmark.h report, phases are the state
+ * restore, the frame and the swap, ready for bench-compare:
+ *
+ *   BENCHMARK_FRAMES=600 BENCHMARK_OUTPUT=replay.json benchmark/glreplay capture-600.gltrace
+ *
+ * Commands are decoded while replaying, which costs about as much as the
+ * application writing the same arguments.
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <GL/gl.h>
+#include <GL/glx.h>
+#include <X11/XKBlib.h>
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "gltrace.h"
+
+/* decoded arguments of the command being replayed */
+#define I(n)    (args.i[n])
+#define F(n)    (args.f[n])
+#define D(n)    (args.d[n])
+#define FV(n)   ((const GLfloat *)args.p[n])
+#define DV(n)   ((const GLdouble *)args.p[n])
+#define BLOB(n) (args.p[n])
+
+struct Trace
+{
+    struct TraceHeader header;
+    uint32_t          *words;
+    const uint32_t    *blocks[N_TRACE_BLOCKS];
+    uint32_t           blockWords[N_TRACE_BLOCKS];
+};
+
+/* check every command once, replaying then needs no bounds checks beyond decoding */
+static int validateBlock(const uint32_t *words, uint32_t nWords, uint32_t nCommands)
+{
+    struct TraceArgs args;
+    uint32_t         at = 0U, count = 0U;
+
+    while (at < nWords)
+    {
+        uint32_t op = GLTRACE_OPCODE(words[at]), n = GLTRACE_WORDS(words[at]);
+        if (op >= N_TRACE_OPS || n > nWords - at - 1U || 0 != traceDecode((enum TraceOp)op, &words[at + 1U], n, &args))
+        {
+            fprintf(stderr, "[%s] invalid command %u at word %u\n", __func__, op, at);
+            return -1;
+        }
+        at += 1U + n;
+        ++count;
+    }
+    if (count != nCommands)
+    {
+        fprintf(stderr, "[%s] %u commands, header says %u\n", __func__, count, nCommands);
+        return -1;
+    }
+    return 0;
+}
+
+static int readTrace(const char *path, struct Trace *trace)
+{
+    FILE    *pFile = fopen(path, "rb");
+    long     size  = 0;
+    uint32_t total = 0U;
+
+    memset(trace, 0, sizeof(struct Trace));
+    if (NULL == pFile)
+    {
+        fprintf(stderr, "[%s] cannot open %s\n", __func__, path);
+        return -1;
+    }
+
+    fseek(pFile, 0, SEEK_END);
+    size = ftell(pFile);
+    fseek(pFile, 0, SEEK_SET);
+    if (1 != fread(&trace->header, sizeof(struct TraceHeader), 1, pFile) || 0 != memcmp(trace->header.magic, GLTRACE_MAGIC, sizeof(GLTRACE_MAGIC)) ||
+        GLTRACE_VERSION != trace->header.version)
+    {
+        fprintf(stderr, "[%s] %s is not a version %u trace\n", __func__, path, GLTRACE_VERSION);
+        fclose(pFile);
+        return -1;
+    }
+
+    for (int block = 0; block < N_TRACE_BLOCKS; ++block)
+    {
+        trace->blockWords[block] = trace->header.blockBytes[block] / sizeof(uint32_t);
+        total += trace->blockWords[block];
+    }
+    if ((long)(sizeof(struct TraceHeader) + total * sizeof(uint32_t)) != size)
+    {
+        fprintf(stderr, "[%s] %s is truncated\n", __func__, path);
+        fclose(pFile);
+        return -1;
+    }
+
+    trace->words = (uint32_t *)malloc(total ? total * sizeof(uint32_t) : 1U);
+    if (NULL == trace->words || total != fread(trace->words, sizeof(uint32_t), total, pFile))
+    {
+        fprintf(stderr, "[%s] cannot read %s\n", __func__, path);
+        free(trace->words);
+        trace->words = NULL;
+        fclose(pFile);
+        return -1;
+    }
+    fclose(pFile);
+
+    total = 0U;
+    for (int block = 0; block < N_TRACE_BLOCKS; ++block)
+    {
+        trace->blocks[block] = trace->words + total;
+        total += trace->blockWords[block];
+        if (0 != validateBlock(trace->blocks[block], trace->blockWords[block], trace->header.blockCommands[block]))
+        {
+            free(trace->words);
+            trace->words = NULL;
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static void runBlock(const uint32_t *words, uint32_t nWords)
+{
+    struct TraceArgs args;
+
+    for (uint32_t at = 0U; at < nWords; at += 1U + GLTRACE_WORDS(words[at]))
+    {
+        enum TraceOp op = (enum TraceOp)GLTRACE_OPCODE(words[at]);
+        traceDecode(op, &words[at + 1U], GLTRACE_WORDS(words[at]), &args);
+        switch (op)
+        {
+#define GLREPLAY_CALL(name, params, call, format, record, replay, hook) \
+    case TRACE_##name:                                                  \
+        replay;                                                         \
+        break;
+            GLTRACE_COMMANDS(GLREPLAY_CALL)
+            default:
+                break;
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    Display             *dpy              = NULL;
+    Window               w                = 0UL;
+    XVisualInfo         *vi               = NULL;
+    XSetWindowAttributes xattr            = {0};
+    GLXContext           glCtxt           = NULL;
+    Atom                 wm_delete_window = 0;
+    struct Trace         trace;
+    struct Benchmark     bench;
+    int                  isDone     = 0;
+    uint32_t             nFrames    = 0U;
+    double               lastReport = 0.0;
+
+    if (2 != argc)
+    {
+        fprintf(stderr, "usage: %s trace.gltrace\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    if (0 != readTrace(argv[1], &trace))
+        return EXIT_FAILURE;
+
+    printf("%s: frame %u, %ux%u, %u frame commands, %u state commands, %u resource commands\n", argv[1], trace.header.frame, trace.header.width, trace.header.height,
+           trace.header.blockCommands[TRACE_BLOCK_FRAME], trace.header.blockCommands[TRACE_BLOCK_STATE], trace.header.blockCommands[TRACE_BLOCK_RESOURCES]);
+
+    dpy = XOpenDisplay(NULL);
+    if (NULL == dpy)
+    {
+        fprintf(stderr, "Error: Could not open X display\n");
+        free(trace.words);
+        return EXIT_FAILURE;
+    }
+
+    // clang-format off
+    GLint glxAttributes[] = {
+        GLX_RGBA,
+        GLX_DOUBLEBUFFER,
+        GLX_DEPTH_SIZE, 24,
+        GLX_STENCIL_SIZE, 8,
+        GLX_RED_SIZE, 8,
+        GLX_GREEN_SIZE, 8,
+        GLX_BLUE_SIZE, 8,
+        None
+    };
+    // clang-format on
+
+    vi = glXChooseVisual(dpy, DefaultScreen(dpy), glxAttributes);
+    if (NULL == vi)
+    {
+        fprintf(stderr, "Error: No appropriate visual found\n");
+        XCloseDisplay(dpy);
+        free(trace.words);
+        return EXIT_FAILURE;
+    }
+
+    xattr.colormap   = XCreateColormap(dpy, DefaultRootWindow(dpy), vi->visual, AllocNone);
+    xattr.event_mask = KeyPressMask | StructureNotifyMask;
+    w = XCreateWindow(dpy, DefaultRootWindow(dpy), 0, 0, trace.header.width ? trace.header.width : 800U, trace.header.height ? trace.header.height : 600U, 0, vi->depth, InputOutput,
+                      vi->visual, CWColormap | CWEventMask, &xattr);
+    XStoreName(dpy, w, argv[1]);
+    wm_delete_window = XInternAtom(dpy, "WM_DELETE_WINDOW", False);
+    XSetWMProtocols(dpy, w, &wm_delete_window, 1);
+    XMapWindow(dpy, w);
+
+    /* the legacy context is a compatibility context, as the ffp samples use */
+    glCtxt = glXCreateContext(dpy, vi, NULL, GL_TRUE);
+    glXMakeCurrent(dpy, w, glCtxt);
+    XFree(vi);
+
+    runBlock(trace.blocks[TRACE_BLOCK_RESOURCES], trace.blockWords[TRACE_BLOCK_RESOURCES]);
+    benchmarkInit(&bench, argv[1]);
+    lastReport = benchmarkClock(CLOCK_MONOTONIC);
+
+    while (!isDone)
+    {
+        while (XPending(dpy))
+        {
+            XEvent event;
+            XNextEvent(dpy, &event);
+            if (ClientMessage == event.type && (Atom)event.xclient.data.l[0] == wm_delete_window)
+                isDone = 1;
+            if (KeyPress == event.type && XK_Escape == XkbKeycodeToKeysym(dpy, event.xkey.keycode, 0, 0))
+                isDone = 1;
+        }
+
+        benchmarkBeginFrame(&bench);
+        benchmarkPhase(&bench, "state");
+        runBlock(trace.blocks[TRACE_BLOCK_STATE], trace.blockWords[TRACE_BLOCK_STATE]);
+        benchmarkPhase(&bench, "frame");
+        runBlock(trace.blocks[TRACE_BLOCK_FRAME], trace.blockWords[TRACE_BLOCK_FRAME]);
+        benchmarkPhase(&bench, "swap");
+        glXSwapBuffers(dpy, w);
+        if (benchmarkEndFrame(&bench))
+            isDone = 1;
+
+        ++nFrames;
+        double time = benchmarkClock(CLOCK_MONOTONIC);
+        if (!bench.enabled && time - lastReport >= 1000.0)
+        {
+            printf("frames: %u | avg %.3f ms\n", nFrames, (time - lastReport) / nFrames);
+            fflush(stdout);
+            nFrames    = 0U;
+            lastReport = time;
+        }
+    }
+
+    glXMakeCurrent(dpy, None, NULL);
+    glXDestroyContext(dpy, glCtxt);
+    XDestroyWindow(dpy, w);
+    XFreeColormap(dpy, xattr.colormap);
+    XCloseDisplay(dpy);
+    free(trace.words);
+    return EXIT_SUCCESS;
+}
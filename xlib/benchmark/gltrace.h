@@ -0,0 +1,261 @@
+#ifndef GLTRACE_H
+#define GLTRACE_H
+/**
+ * @file      gltrace.h
+ * @brief     Binary format of single frame GL traces written by glcapture and read by glreplay
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * A trace is a TraceHeader followed by three blocks of commands:
+ *
+ *   resources  textures with their pixels read back and display lists, run once
+ *   state      fixed function state at the start of the frame, run before every frame
+ *   frame      the commands of the captured frame, up to glXSwapBuffers
+ *
+ * A command is one word holding the opcode in its low 8 bits and the number
+ * of argument words in the upper 24, followed by its arguments. Words are
+ * 32 bit in host byte order, traces are meant to be replayed on the same
+ * architecture. Arguments are laid out by the command's format string:
+ *
+ *   i  32 bit integer, enums, names, sizes, bitfields and booleans
+ *   f  float
+ *   d  double, two words
+ *   F  float array, count word followed by the floats
+ *   D  double array, count word followed by two words per double
+ *   B  blob, byte count word followed by the bytes padded to a word, 0 bytes for NULL
+ *
+ * Covered is the fixed function subset used by the ffp samples and by GLU
+ * underneath them, see GLTRACE_COMMANDS. Header only, used from C.
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <GL/gl.h>
+
+#include <stdint.h>
+#include <string.h>
+
+#define GLTRACE_MAGIC   "GLTRACE"
+#define GLTRACE_VERSION 1U
+
+/* most arguments of one command, glTexImage2D */
+#define GLTRACE_MAX_ARGS 9
+
+/* most doubles in a D argument, one matrix */
+#define GLTRACE_MAX_DOUBLES 16
+
+#define GLTRACE_OPCODE(word) ((word) & 0xffU)
+#define GLTRACE_WORDS(word)  ((word) >> 8)
+
+enum TraceBlock
+{
+    TRACE_BLOCK_RESOURCES,
+    TRACE_BLOCK_STATE,
+    TRACE_BLOCK_FRAME,
+    N_TRACE_BLOCKS
+};
+
+struct TraceHeader
+{
+    char     magic[8];
+    uint32_t version;
+    uint32_t frame;  // frame number in the captured run
+    uint32_t width;  // viewport at the start of the frame
+    uint32_t height;
+    uint32_t blockBytes[N_TRACE_BLOCKS];
+    uint32_t blockCommands[N_TRACE_BLOCKS];
+};
+
+/*
+  Traced entry points: name, parameters, arguments, format, arguments of
+  emit() in glcapture, call made by glreplay and a statement glcapture runs
+  after recording. Replay calls read the decoded arguments through I(), F(),
+  D(), FV(), DV() and BLOB().
+ */
+#define GLTRACE_COMMANDS(X)                                                                                                                                                         \
+    X(glBegin, (GLenum mode), (mode), "i", (TRACE_glBegin, mode), glBegin(I(0)), )                                                                                                 \
+    X(glEnd, (void), (), "", (TRACE_glEnd), glEnd(), )                                                                                                                             \
+    X(glVertex2f, (GLfloat x, GLfloat y), (x, y), "ff", (TRACE_glVertex2f, x, y), glVertex2f(F(0), F(1)), )                                                                        \
+    X(glVertex3f, (GLfloat x, GLfloat y, GLfloat z), (x, y, z), "fff", (TRACE_glVertex3f, x, y, z), glVertex3f(F(0), F(1), F(2)), )                                                \
+    X(glVertex3fv, (const GLfloat *v), (v), "F", (TRACE_glVertex3fv, 3, v), glVertex3fv(FV(0)), )                                                                                 \
+    X(glNormal3f, (GLfloat nx, GLfloat ny, GLfloat nz), (nx, ny, nz), "fff", (TRACE_glNormal3f, nx, ny, nz), glNormal3f(F(0), F(1), F(2)), )                                       \
+    X(glNormal3fv, (const GLfloat *v), (v), "F", (TRACE_glNormal3fv, 3, v), glNormal3fv(FV(0)), )                                                                                 \
+    X(glColor3f, (GLfloat red, GLfloat green, GLfloat blue), (red, green, blue), "fff", (TRACE_glColor3f, red, green, blue), glColor3f(F(0), F(1), F(2)), )                        \
+    X(glColor4f, (GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha), (red, green, blue, alpha), "ffff", (TRACE_glColor4f, red, green, blue, alpha),                         \
+      glColor4f(F(0), F(1), F(2), F(3)), )                                                                                                                                          \
+    X(glColor3fv, (const GLfloat *v), (v), "F", (TRACE_glColor3fv, 3, v), glColor3fv(FV(0)), )                                                                                    \
+    X(glColor4fv, (const GLfloat *v), (v), "F", (TRACE_glColor4fv, 4, v), glColor4fv(FV(0)), )                                                                                    \
+    X(glColor3ubv, (const GLubyte *v), (v), "iii", (TRACE_glColor3ubv, v[0], v[1], v[2]), glColor3ub(I(0), I(1), I(2)), )                                                         \
+    X(glTexCoord2f, (GLfloat s, GLfloat t), (s, t), "ff", (TRACE_glTexCoord2f, s, t), glTexCoord2f(F(0), F(1)), )                                                                  \
+    X(glMatrixMode, (GLenum mode), (mode), "i", (TRACE_glMatrixMode, mode), glMatrixMode(I(0)), )                                                                                  \
+    X(glLoadIdentity, (void), (), "", (TRACE_glLoadIdentity), glLoadIdentity(), )                                                                                                  \
+    X(glPushMatrix, (void), (), "", (TRACE_glPushMatrix), glPushMatrix(), )                                                                                                        \
+    X(glPopMatrix, (void), (), "", (TRACE_glPopMatrix), glPopMatrix(), )                                                                                                           \
+    X(glTranslatef, (GLfloat x, GLfloat y, GLfloat z), (x, y, z), "fff", (TRACE_glTranslatef, x, y, z), glTranslatef(F(0), F(1), F(2)), )                                         \
+    X(glTranslated, (GLdouble x, GLdouble y, GLdouble z), (x, y, z), "ddd", (TRACE_glTranslated, x, y, z), glTranslated(D(0), D(1), D(2)), )                                       \
+    X(glRotatef, (GLfloat angle, GLfloat x, GLfloat y, GLfloat z), (angle, x, y, z), "ffff", (TRACE_glRotatef, angle, x, y, z), glRotatef(F(0), F(1), F(2), F(3)), )               \
+    X(glRotated, (GLdouble angle, GLdouble x, GLdouble y, GLdouble z), (angle, x, y, z), "dddd", (TRACE_glRotated, angle, x, y, z), glRotated(D(0), D(1), D(2), D(3)), )           \
+    X(glScalef, (GLfloat x, GLfloat y, GLfloat z), (x, y, z), "fff", (TRACE_glScalef, x, y, z), glScalef(F(0), F(1), F(2)), )                                                      \
+    X(glScaled, (GLdouble x, GLdouble y, GLdouble z), (x, y, z), "ddd", (TRACE_glScaled, x, y, z), glScaled(D(0), D(1), D(2)), )                                                   \
+    X(glMultMatrixf, (const GLfloat *m), (m), "F", (TRACE_glMultMatrixf, 16, m), glMultMatrixf(FV(0)), )                                                                          \
+    X(glMultMatrixd, (const GLdouble *m), (m), "D", (TRACE_glMultMatrixd, 16, m), glMultMatrixd(DV(0)), )                                                                         \
+    X(glLoadMatrixf, (const GLfloat *m), (m), "F", (TRACE_glLoadMatrixf, 16, m), glLoadMatrixf(FV(0)), )                                                                          \
+    X(glLoadMatrixd, (const GLdouble *m), (m), "D", (TRACE_glLoadMatrixd, 16, m), glLoadMatrixd(DV(0)), )                                                                         \
+    X(glFrustum, (GLdouble left, GLdouble right, GLdouble bottom, GLdouble top, GLdouble zNear, GLdouble zFar), (left, right, bottom, top, zNear, zFar), "dddddd",                  \
+      (TRACE_glFrustum, left, right, bottom, top, zNear, zFar), glFrustum(D(0), D(1), D(2), D(3), D(4), D(5)), )                                                                    \
+    X(glOrtho, (GLdouble left, GLdouble right, GLdouble bottom, GLdouble top, GLdouble zNear, GLdouble zFar), (left, right, bottom, top, zNear, zFar), "dddddd",                    \
+      (TRACE_glOrtho, left, right, bottom, top, zNear, zFar), glOrtho(D(0), D(1), D(2), D(3), D(4), D(5)), )                                                                        \
+    X(glEnable, (GLenum cap), (cap), "i", (TRACE_glEnable, cap), glEnable(I(0)), )                                                                                                 \
+    X(glDisable, (GLenum cap), (cap), "i", (TRACE_glDisable, cap), glDisable(I(0)), )                                                                                              \
+    X(glShadeModel, (GLenum mode), (mode), "i", (TRACE_glShadeModel, mode), glShadeModel(I(0)), )                                                                                  \
+    X(glFrontFace, (GLenum mode), (mode), "i", (TRACE_glFrontFace, mode), glFrontFace(I(0)), )                                                                                     \
+    X(glCullFace, (GLenum mode), (mode), "i", (TRACE_glCullFace, mode), glCullFace(I(0)), )                                                                                        \
+    X(glDepthFunc, (GLenum func), (func), "i", (TRACE_glDepthFunc, func), glDepthFunc(I(0)), )                                                                                     \
+    X(glDepthMask, (GLboolean flag), (flag), "i", (TRACE_glDepthMask, flag), glDepthMask(I(0)), )                                                                                  \
+    X(glBlendFunc, (GLenum sfactor, GLenum dfactor), (sfactor, dfactor), "ii", (TRACE_glBlendFunc, sfactor, dfactor), glBlendFunc(I(0), I(1)), )                                   \
+    X(glAlphaFunc, (GLenum func, GLclampf ref), (func, ref), "if", (TRACE_glAlphaFunc, func, ref), glAlphaFunc(I(0), F(1)), )                                                      \
+    X(glColorMask, (GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha), (red, green, blue, alpha), "iiii", (TRACE_glColorMask, red, green, blue, alpha),             \
+      glColorMask(I(0), I(1), I(2), I(3)), )                                                                                                                                        \
+    X(glStencilFunc, (GLenum func, GLint ref, GLuint mask), (func, ref, mask), "iii", (TRACE_glStencilFunc, func, ref, mask), glStencilFunc(I(0), I(1), I(2)), )                   \
+    X(glStencilOp, (GLenum fail, GLenum zfail, GLenum zpass), (fail, zfail, zpass), "iii", (TRACE_glStencilOp, fail, zfail, zpass), glStencilOp(I(0), I(1), I(2)), )              \
+    X(glStencilMask, (GLuint mask), (mask), "i", (TRACE_glStencilMask, mask), glStencilMask(I(0)), )                                                                               \
+    X(glClearColor, (GLclampf red, GLclampf green, GLclampf blue, GLclampf alpha), (red, green, blue, alpha), "ffff", (TRACE_glClearColor, red, green, blue, alpha),               \
+      glClearColor(F(0), F(1), F(2), F(3)), )                                                                                                                                       \
+    X(glClearDepth, (GLclampd depth), (depth), "d", (TRACE_glClearDepth, depth), glClearDepth(D(0)), )                                                                             \
+    X(glClearStencil, (GLint s), (s), "i", (TRACE_glClearStencil, s), glClearStencil(I(0)), )                                                                                      \
+    X(glViewport, (GLint x, GLint y, GLsizei width, GLsizei height), (x, y, width, height), "iiii", (TRACE_glViewport, x, y, width, height), glViewport(I(0), I(1), I(2), I(3)), ) \
+    X(glScissor, (GLint x, GLint y, GLsizei width, GLsizei height), (x, y, width, height), "iiii", (TRACE_glScissor, x, y, width, height), glScissor(I(0), I(1), I(2), I(3)), )    \
+    X(glPushAttrib, (GLbitfield mask), (mask), "i", (TRACE_glPushAttrib, mask), glPushAttrib(I(0)), )                                                                              \
+    X(glPopAttrib, (void), (), "", (TRACE_glPopAttrib), glPopAttrib(), )                                                                                                           \
+    X(glClipPlane, (GLenum plane, const GLdouble *equation), (plane, equation), "iD", (TRACE_glClipPlane, plane, 4, equation), glClipPlane(I(0), DV(1)), )                         \
+    X(glLightf, (GLenum light, GLenum pname, GLfloat param), (light, pname, param), "iif", (TRACE_glLightf, light, pname, param), glLightf(I(0), I(1), F(2)), )                    \
+    X(glLightfv, (GLenum light, GLenum pname, const GLfloat *params), (light, pname, params), "iiF", (TRACE_glLightfv, light, pname, lightValues(pname), params),                   \
+      glLightfv(I(0), I(1), FV(2)), )                                                                                                                                               \
+    X(glLightModelfv, (GLenum pname, const GLfloat *params), (pname, params), "iF", (TRACE_glLightModelfv, pname, GL_LIGHT_MODEL_AMBIENT == pname ? 4 : 1, params),                \
+      glLightModelfv(I(0), FV(1)), )                                                                                                                                                \
+    X(glLightModeli, (GLenum pname, GLint param), (pname, param), "ii", (TRACE_glLightModeli, pname, param), glLightModeli(I(0), I(1)), )                                          \
+    X(glMaterialf, (GLenum face, GLenum pname, GLfloat param), (face, pname, param), "iif", (TRACE_glMaterialf, face, pname, param), glMaterialf(I(0), I(1), F(2)), )              \
+    X(glMaterialfv, (GLenum face, GLenum pname, const GLfloat *params), (face, pname, params), "iiF", (TRACE_glMaterialfv, face, pname, materialValues(pname), params),            \
+      glMaterialfv(I(0), I(1), FV(2)), )                                                                                                                                            \
+    X(glColorMaterial, (GLenum face, GLenum mode), (face, mode), "ii", (TRACE_glColorMaterial, face, mode), glColorMaterial(I(0), I(1)), )                                         \
+    X(glHint, (GLenum target, GLenum mode), (target, mode), "ii", (TRACE_glHint, target, mode), glHint(I(0), I(1)), )                                                              \
+    X(glPolygonMode, (GLenum face, GLenum mode), (face, mode), "ii", (TRACE_glPolygonMode, face, mode), glPolygonMode(I(0), I(1)), )                                               \
+    X(glLineWidth, (GLfloat width), (width), "f", (TRACE_glLineWidth, width), glLineWidth(F(0)), )                                                                                 \
+    X(glPointSize, (GLfloat size), (size), "f", (TRACE_glPointSize, size), glPointSize(F(0)), )                                                                                    \
+    X(glClear, (GLbitfield mask), (mask), "i", (TRACE_glClear, mask), glClear(I(0)), )                                                                                             \
+    X(glCallList, (GLuint list), (list), "i", (TRACE_glCallList, list), glCallList(I(0)), )                                                                                        \
+    X(glNewList, (GLuint list, GLenum mode), (list, mode), "ii", (TRACE_glNewList, list, mode), glNewList(I(0), I(1)), beginList(list))                                            \
+    X(glEndList, (void), (), "", (TRACE_glEndList), glEndList(), endList())                                                                                                        \
+    X(glBindTexture, (GLenum target, GLuint texture), (target, texture), "ii", (TRACE_glBindTexture, target, texture), glBindTexture(I(0), I(1)), addTexture(target, texture))     \
+    X(glTexParameteri, (GLenum target, GLenum pname, GLint param), (target, pname, param), "iii", (TRACE_glTexParameteri, target, pname, param),                                    \
+      glTexParameteri(I(0), I(1), I(2)), )                                                                                                                                          \
+    X(glTexParameterf, (GLenum target, GLenum pname, GLfloat param), (target, pname, param), "iif", (TRACE_glTexParameterf, target, pname, param),                                  \
+      glTexParameterf(I(0), I(1), F(2)), )                                                                                                                                          \
+    X(glTexEnvi, (GLenum target, GLenum pname, GLint param), (target, pname, param), "iii", (TRACE_glTexEnvi, target, pname, param), glTexEnvi(I(0), I(1), I(2)), )               \
+    X(glTexEnvf, (GLenum target, GLenum pname, GLfloat param), (target, pname, param), "iif", (TRACE_glTexEnvf, target, pname, param), glTexEnvf(I(0), I(1), F(2)), )             \
+    X(glPixelStorei, (GLenum pname, GLint param), (pname, param), "ii", (TRACE_glPixelStorei, pname, param), glPixelStorei(I(0), I(1)), pixelStore(pname, param))                 \
+    X(glTexImage2D, (GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void *pixels),             \
+      (target, level, internalformat, width, height, border, format, type, pixels), "iiiiiiiiB",                                                                                    \
+      (TRACE_glTexImage2D, target, level, internalformat, width, height, border, format, type, pixelBytes(width, height, format, type, pixels), pixels),                          \
+      glTexImage2D(I(0), I(1), I(2), I(3), I(4), I(5), I(6), I(7), BLOB(8)), )                                                                                                      \
+    X(glTexSubImage2D, (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void *pixels),               \
+      (target, level, xoffset, yoffset, width, height, format, type, pixels), "iiiiiiiiB",                                                                                          \
+      (TRACE_glTexSubImage2D, target, level, xoffset, yoffset, width, height, format, type, pixelBytes(width, height, format, type, pixels), pixels),                             \
+      glTexSubImage2D(I(0), I(1), I(2), I(3), I(4), I(5), I(6), I(7), BLOB(8)), )
+
+#define GLTRACE_ENUM(name, params, args, format, record, replay, hook) TRACE_##name,
+enum TraceOp
+{
+    GLTRACE_COMMANDS(GLTRACE_ENUM) N_TRACE_OPS
+};
+
+#define GLTRACE_FORMAT(name, params, args, format, record, replay, hook) format,
+static const char *const traceFormats[N_TRACE_OPS] = {GLTRACE_COMMANDS(GLTRACE_FORMAT)};
+
+#define GLTRACE_NAME(name, params, args, format, record, replay, hook) #name,
+static const char *const traceNames[N_TRACE_OPS] = {GLTRACE_COMMANDS(GLTRACE_NAME)};
+
+/**
+ * @brief arguments of one command, decoded by traceDecode()
+ */
+struct TraceArgs
+{
+    GLint       i[GLTRACE_MAX_ARGS];
+    GLfloat     f[GLTRACE_MAX_ARGS];
+    GLdouble    d[GLTRACE_MAX_ARGS];
+    const void *p[GLTRACE_MAX_ARGS];
+    GLdouble    doubles[GLTRACE_MAX_DOUBLES]; // D argument, copied for alignment
+};
+
+/**
+ * @brief point args at the arguments of a command
+ *
+ * @param words  argument words following the command word
+ * @param nWords number of argument words
+ * @return 0 on success, -1 when the arguments do not match the format
+ */
+static inline int traceDecode(enum TraceOp op, const uint32_t *words, uint32_t nWords, struct TraceArgs *args)
+{
+    const char *format = traceFormats[op];
+    uint32_t    at     = 0U;
+
+    for (int arg = 0; '\0' != format[arg]; ++arg)
+    {
+        uint32_t count = 0U;
+        switch (format[arg])
+        {
+            case 'i':
+            case 'f':
+                if (at + 1U > nWords)
+                    return -1;
+                memcpy(&args->i[arg], &words[at], sizeof(GLint));
+                memcpy(&args->f[arg], &words[at], sizeof(GLfloat));
+                at += 1U;
+                break;
+            case 'd':
+                if (at + 2U > nWords)
+                    return -1;
+                memcpy(&args->d[arg], &words[at], sizeof(GLdouble));
+                at += 2U;
+                break;
+            case 'F':
+                if (at >= nWords)
+                    return -1;
+                count = words[at++];
+                if (count > nWords - at)
+                    return -1;
+                args->p[arg] = &words[at];
+                at += count;
+                break;
+            case 'D':
+                if (at >= nWords)
+                    return -1;
+                count = words[at++];
+                if (count > GLTRACE_MAX_DOUBLES || 2U * count > nWords - at)
+                    return -1;
+                memcpy(args->doubles, &words[at], count * sizeof(GLdouble));
+                args->p[arg] = args->doubles;
+                at += 2U * count;
+                break;
+            case 'B':
+                if (at >= nWords)
+                    return -1;
+                count = words[at++];
+                if ((count + 3U) / 4U > nWords - at)
+                    return -1;
+                args->p[arg] = count ? &words[at] : NULL;
+                at += (count + 3U) / 4U;
+                break;
+            default:
+                return -1;
+        }
+    }
+    return at == nWords ? 0 : -1;
+}
+
+#endif
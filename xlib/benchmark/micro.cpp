@@ -0,0 +1,250 @@
+/**
+ * @file      micro.cpp
+ * @brief     Microbenchmarks of the CPU kernels shared by the samples
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * Usage: micro [filter] [-o report.json]
+ *
+ * Covers the vmath matrix and quaternion operations run per frame, the
+ * mandlebrot and julia iteration with HSBtoRGB from ffp/mandlebrot, and the
+ * OBJ reader and vertex welding of load-model on generated meshes of a few
+ * sizes. Compare reports with bench-compare.
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "mandlebrot.h"
+#include "microbench.h"
+#include "obj.h"
+#include "vmath.h"
+
+/* inputs cycled by the vmath kernels, small enough to stay in L1 */
+#define N_INPUTS 64
+
+/* pixels of one fractal line, the width of the mandlebrot sample */
+#define LINE_PIXELS 2880
+
+/* OBJ meshes are cylinders of this many columns and rows */
+static const int meshSizes[] = {32, 128, 384};
+
+static void benchVmath(MicroBench &bench)
+{
+    vmath::mat4       matrices[N_INPUTS];
+    vmath::vec4       vectors[N_INPUTS];
+    vmath::vec3       eyes[N_INPUTS];
+    vmath::quaternion quaternions[N_INPUTS];
+    uint32_t          idx = 0U;
+
+    for (int n = 0; n < N_INPUTS; ++n)
+    {
+        float t        = (float)n / N_INPUTS;
+        matrices[n]    = vmath::rotate(360.0f * t, 0.3f, 1.0f, 0.2f) * vmath::translate(t, 2.0f * t, -5.0f);
+        vectors[n]     = vmath::vec4(t, 1.0f - t, 0.5f, 1.0f);
+        eyes[n]        = vmath::vec3(5.0f * t, 3.0f, 5.0f - t);
+        quaternions[n] = vmath::normalize(vmath::quaternion(1.0f - t, t, 0.5f * t, 0.25f));
+    }
+
+    bench.run("vmath.mat4_multiply", 1.0, 3.0 * sizeof(vmath::mat4), [&] {
+        vmath::mat4 result = matrices[idx % N_INPUTS] * matrices[(idx + 1U) % N_INPUTS];
+        microKeep(result);
+        ++idx;
+    });
+
+    /* vmath only has the row vector product */
+    bench.run("vmath.vec4_mat4", 1.0, sizeof(vmath::mat4) + 2.0 * sizeof(vmath::vec4), [&] {
+        vmath::vec4 result = vectors[idx % N_INPUTS] * matrices[(idx + 1U) % N_INPUTS];
+        microKeep(result);
+        ++idx;
+    });
+
+    /* model matrix of the vmath samples, rebuilt every frame */
+    bench.run("vmath.rotate", 1.0, sizeof(vmath::mat4), [&] {
+        vmath::mat4 result = vmath::rotate((float)(idx % 360U), 0.0f, 1.0f, 0.0f);
+        microKeep(result);
+        ++idx;
+    });
+
+    bench.run("vmath.lookat", 1.0, sizeof(vmath::mat4), [&] {
+        vmath::mat4 result = vmath::lookat(eyes[idx % N_INPUTS], vmath::vec3(0.0f, 0.0f, 0.0f), vmath::vec3(0.0f, 1.0f, 0.0f));
+        microKeep(result);
+        ++idx;
+    });
+
+    bench.run("vmath.perspective", 1.0, sizeof(vmath::mat4), [&] {
+        vmath::mat4 result = vmath::perspective(30.0f + (float)(idx % N_INPUTS), 16.0f / 9.0f, 0.1f, 100.0f);
+        microKeep(result);
+        ++idx;
+    });
+
+    bench.run("vmath.quaternion_multiply", 1.0, 3.0 * sizeof(vmath::quaternion), [&] {
+        vmath::quaternion result = quaternions[idx % N_INPUTS] * quaternions[(idx + 1U) % N_INPUTS];
+        microKeep(result);
+        ++idx;
+    });
+
+    bench.run("vmath.quaternion_normalize", 1.0, 2.0 * sizeof(vmath::quaternion), [&] {
+        vmath::quaternion result = vmath::normalize(quaternions[idx % N_INPUTS]);
+        microKeep(result);
+        ++idx;
+    });
+
+    bench.run("vmath.quaternion_matrix", 1.0, sizeof(vmath::quaternion) + sizeof(vmath::mat4), [&] {
+        vmath::mat4 result = quaternions[idx % N_INPUTS].asMatrix();
+        microKeep(result);
+        ++idx;
+    });
+}
+
+static void benchFractal(MicroBench &bench)
+{
+    static uint32_t iterations[LINE_PIXELS];
+
+    /* inside the set, every call runs to MAX_ITERATIONS */
+    bench.run("fractal.mandle_pixel_inside", 1.0, 0.0, [&] {
+        uint32_t n = mandle(-0.1f, 0.1f);
+        microKeep(n);
+    });
+
+    /* the same row every call, crossing both the set and the escaping points around it */
+    bench.run("fractal.mandle_line", LINE_PIXELS, sizeof(iterations), [&] {
+        for (int x = 0; x < LINE_PIXELS; ++x) { iterations[x] = mandle(-2.2f + 3.2f * x / LINE_PIXELS, 0.25f); }
+        microKeep(iterations);
+    });
+
+    bench.run("fractal.julia_line", LINE_PIXELS, sizeof(iterations), [&] {
+        for (int x = 0; x < LINE_PIXELS; ++x) { iterations[x] = julia(-1.6f + 3.2f * x / LINE_PIXELS, 0.25f); }
+        microKeep(iterations);
+    });
+}
+
+static void benchColor(MicroBench &bench)
+{
+    uint32_t hue = 0U;
+
+    bench.run("color.hsb_to_rgb", 1.0, sizeof(RGB), [&] {
+        RGB rgb = HSBtoRGB((double)(hue++ % 3600U) * 0.1, 1.0, 1.0);
+        microKeep(rgb);
+    });
+}
+
+/*
+  Cylinder of columns x rows quads as v/vt/vn triangles. The seam column
+  shares positions with the first one but not tex-coords, so welding sees
+  both shared and split corners.
+ */
+static long writeCylinder(const char *path, int columns, int rows)
+{
+    FILE *pFile = fopen(path, "w");
+    if (nullptr == pFile)
+    {
+        fprintf(stderr, "[%s] cannot write %s\n", __func__, path);
+        return -1;
+    }
+
+    for (int row = 0; row <= rows; ++row)
+    {
+        for (int column = 0; column < columns; ++column)
+        {
+            float angle = 2.0f * (float)M_PI * column / columns;
+            fprintf(pFile, "v %f %f %f\n", cosf(angle), (float)row / rows, sinf(angle));
+        }
+    }
+    for (int row = 0; row <= rows; ++row)
+    {
+        for (int column = 0; column <= columns; ++column) { fprintf(pFile, "vt %f %f\n", (float)column / columns, (float)row / rows); }
+    }
+    fprintf(pFile, "vn 0 1 0\n");
+
+    for (int row = 0; row < rows; ++row)
+    {
+        for (int column = 0; column < columns; ++column)
+        {
+            /* 1 based, position column wraps, tex-coord column does not */
+            int v00 = row * columns + column + 1, v01 = row * columns + (column + 1) % columns + 1;
+            int v10 = v00 + columns, v11 = v01 + columns;
+            int t00 = row * (columns + 1) + column + 1, t01 = t00 + 1;
+            int t10 = t00 + columns + 1, t11 = t01 + columns + 1;
+            fprintf(pFile, "f %d/%d/1 %d/%d/1 %d/%d/1\n", v00, t00, v10, t10, v11, t11);
+            fprintf(pFile, "f %d/%d/1 %d/%d/1 %d/%d/1\n", v00, t00, v11, t11, v01, t01);
+        }
+    }
+
+    if (0 != fclose(pFile))
+    {
+        fprintf(stderr, "[%s] cannot write %s\n", __func__, path);
+        return -1;
+    }
+
+    struct stat info;
+    return 0 == stat(path, &info) ? (long)info.st_size : -1;
+}
+
+static int benchObj(MicroBench &bench)
+{
+    char path[] = "/tmp/microXXXXXX.obj";
+    int  fd     = mkstemps(path, 4);
+
+    if (-1 == fd)
+    {
+        fprintf(stderr, "[%s] cannot create a temporary OBJ file\n", __func__);
+        return -1;
+    }
+    close(fd);
+
+    for (int size : meshSizes)
+    {
+        long           fileSize = writeCylinder(path, size, size);
+        struct ObjMesh mesh;
+        if (0 > fileSize || 0 != readObj(path, &mesh))
+        {
+            unlink(path);
+            return -1;
+        }
+
+        double                   nTriangles = mesh.nIndices / 3U;
+        std::string              suffix     = "/" + std::to_string(mesh.nIndices / 3U);
+        std::vector<ModelVertex> vertices(mesh.nIndices);
+        std::vector<uint32_t>    indices(mesh.nIndices);
+
+        bench.run("obj.read" + suffix, nTriangles, (double)fileSize, [&] {
+            struct ObjMesh parsed;
+            readObj(path, &parsed);
+            microKeep(parsed);
+            freeObj(&parsed);
+        });
+
+        bench.run("obj.weld" + suffix, nTriangles, mesh.nIndices * (sizeof(struct Index) + sizeof(uint32_t)), [&] {
+            uint32_t nVertices = weldVertices(&mesh, vertices.data(), indices.data());
+            microKeep(nVertices);
+        });
+
+        freeObj(&mesh);
+    }
+
+    unlink(path);
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    MicroBench bench(argc, argv);
+
+    benchVmath(bench);
+    benchFractal(bench);
+    benchColor(bench);
+    if (0 != benchObj(bench))
+        return EXIT_FAILURE;
+
+    return 0 == bench.finish() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,210 @@
+#ifndef MICROBENCH_H
+#define MICROBENCH_H
+/**
+ * @file      microbench.h
+ * @brief     Timing of small CPU kernels with warmup and statistics
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * Each kernel is first run for MICRO_WARMUP_MS to fill caches and settle the
+ * clock, which also measures how many calls fit in MICRO_SAMPLE_MS. It is
+ * then timed over MICRO_SAMPLES batches of that many calls, the report gives
+ * min, median and spread of the time per call and the median item and byte
+ * throughput. Results can be written in the layout of benchmark.h so that
+ * bench-compare checks them against a baseline.
+ *
+ *   MicroBench bench(argc, argv);
+ *   bench.run("color.hsb_to_rgb", 1.0, 3.0, [&] { rgb = HSBtoRGB(hue++, 1.0, 1.0); microKeep(rgb); });
+ *   return bench.finish();
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <algorithm>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <time.h>
+#include <vector>
+
+/* time spent running a kernel before measuring it */
+#define MICRO_WARMUP_MS 100.0
+
+/* time of one measured batch of calls */
+#define MICRO_SAMPLE_MS 20.0
+
+/* measured batches, fewer for kernels slow enough to exceed MICRO_MAX_MS */
+#define MICRO_SAMPLES     15
+#define MICRO_MIN_SAMPLES 5
+#define MICRO_MAX_MS      3000.0
+
+/**
+ * @brief keep the compiler from discarding a result or hoisting its computation out of the loop
+ */
+template <typename T> static inline void microKeep(const T &value)
+{
+    asm volatile("" : : "r"(&value) : "memory");
+}
+
+struct MicroResult
+{
+    std::string name;
+    uint64_t    calls;    // calls per batch
+    double      minNs;    // per call
+    double      medianNs;
+    double      spread;   // standard deviation over median
+    double      items;    // per call
+    double      bytes;    // per call
+};
+
+class MicroBench
+{
+  public:
+    /**
+     * @brief usage: [filter] [-o report.json], only kernels whose name contains filter run
+     */
+    MicroBench(int argc, char *argv[]) : filter(nullptr), output(nullptr)
+    {
+        for (int arg = 1; arg < argc; ++arg)
+        {
+            if (0 == strcmp(argv[arg], "-o") && arg + 1 < argc)
+                output = argv[++arg];
+            else
+                filter = argv[arg];
+        }
+        printf("%-28s %12s %12s %7s %12s %12s\n", "kernel", "min ns", "median ns", "+-", "items/s", "bytes/s");
+    }
+
+    /**
+     * @brief time kernel() unless the filter excludes it
+     *
+     * @param items items processed by one call, 0 when not meaningful
+     * @param bytes bytes read and written by one call, 0 when not meaningful
+     */
+    template <typename Kernel> void run(const std::string &name, double items, double bytes, Kernel kernel)
+    {
+        if (nullptr != filter && std::string::npos == name.find(filter))
+            return;
+
+        /* warmup doubles the batch until the time is used up, the last batch gives the call time */
+        uint64_t calls   = 1U;
+        double   batchMs = 0.0;
+        double   start   = now();
+        while (true)
+        {
+            batchMs = batch(kernel, calls);
+            if (now() - start >= MICRO_WARMUP_MS)
+                break;
+            calls *= 2U;
+        }
+
+        double callMs = batchMs / calls;
+        calls         = std::max<uint64_t>(1U, (uint64_t)(MICRO_SAMPLE_MS / std::max(callMs, 1e-9)));
+
+        int nSamples = MICRO_SAMPLES;
+        while (nSamples > MICRO_MIN_SAMPLES && nSamples * calls * callMs > MICRO_MAX_MS) { --nSamples; }
+
+        std::vector<double> samples(nSamples);
+        for (double &sample : samples) { sample = batch(kernel, calls) * 1e6 / calls; }
+        std::sort(samples.begin(), samples.end());
+
+        MicroResult result;
+        double      mean = 0.0, variance = 0.0;
+        for (double sample : samples) { mean += sample / nSamples; }
+        for (double sample : samples) { variance += (sample - mean) * (sample - mean) / nSamples; }
+
+        result.name     = name;
+        result.calls    = calls;
+        result.minNs    = samples.front();
+        result.medianNs = samples[nSamples / 2];
+        result.spread   = sqrt(variance) / result.medianNs;
+        result.items    = items;
+        result.bytes    = bytes;
+        results.push_back(result);
+
+        printf("%-28s %12.2f %12.2f %6.1f%% %12s %12s\n", name.c_str(), result.minNs, result.medianNs, result.spread * 100.0, rate(items, result.medianNs).c_str(),
+               rate(bytes, result.medianNs).c_str());
+        fflush(stdout);
+    }
+
+    /**
+     * @brief write the report when requested
+     * @return 0 on success, -1 when the report cannot be written
+     */
+    int finish() const
+    {
+        if (nullptr == output)
+            return 0;
+
+        FILE *pFile = fopen(output, "w");
+        if (nullptr == pFile)
+        {
+            fprintf(stderr, "[%s] cannot write %s\n", __func__, output);
+            return -1;
+        }
+
+        /* one value per line, bench-compare reads it line by line */
+        fprintf(pFile, "{\n  \"sample\": \"micro\",\n  \"median_ns\": {");
+        for (size_t idx = 0; idx < results.size(); ++idx)
+            fprintf(pFile, "%s\n    \"%s\": %.4f", idx ? "," : "", results[idx].name.c_str(), results[idx].medianNs);
+        fprintf(pFile, "\n  },\n  \"items_per_s\": {");
+        for (size_t idx = 0; idx < results.size(); ++idx)
+            fprintf(pFile, "%s\n    \"%s\": %.1f", idx ? "," : "", results[idx].name.c_str(), results[idx].items * 1e9 / results[idx].medianNs);
+        fprintf(pFile, "\n  }\n}\n");
+
+        if (0 != fclose(pFile))
+        {
+            fprintf(stderr, "[%s] cannot write %s\n", __func__, output);
+            return -1;
+        }
+        return 0;
+    }
+
+  private:
+    static double now()
+    {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+    }
+
+    /* milliseconds taken by calls calls */
+    template <typename Kernel> static double batch(Kernel &kernel, uint64_t calls)
+    {
+        double start = now();
+        for (uint64_t call = 0; call < calls; ++call) { kernel(); }
+        return now() - start;
+    }
+
+    /* amount per second with a metric suffix, "-" when not meaningful */
+    static std::string rate(double amount, double ns)
+    {
+        const char *suffix[] = {"", "k", "M", "G", "T"};
+        double      value    = amount * 1e9 / ns;
+        int         unit     = 0;
+        char        text[32];
+
+        if (0.0 >= amount)
+            return "-";
+        while (value >= 1000.0 && unit < 4)
+        {
+            value /= 1000.0;
+            ++unit;
+        }
+        snprintf(text, sizeof(text), "%.2f%s/s", value, suffix[unit]);
+        return text;
+    }
+
+    std::vector<MicroResult> results;
+    const char              *filter;
+    const char              *output;
+};
+
+#endif
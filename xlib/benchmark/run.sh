@@ -0,0 +1,104 @@
+#!/usr/bin/env bash
+# Build and benchmark every sample on a software context, then compare with the baseline.
+#
+#   benchmark/run.sh [frames]          run all samples, reports go to benchmark/results
+#   BASELINE=1 benchmark/run.sh        store the reports as the new baseline instead
+#
+# The CPU kernel microbenchmarks (benchmark/micro) run last, into the same
+# results and baseline directories.
+#
+# Runs under Xvfb with Mesa llvmpipe when no display is available, so it
+# works on build machines without a GPU. Exits with 1 when a sample regressed.
+
+cd "$(dirname "$0")/.." || exit 2
+
+FRAMES=${1:-600}
+RESULTS=$PWD/benchmark/results
+BASELINE_DIR=$PWD/benchmark/baseline
+
+export BENCHMARK_FRAMES=$FRAMES
+export LIBGL_ALWAYS_SOFTWARE=1
+export GALLIUM_DRIVER=llvmpipe
+export vblank_mode=0
+export __GL_SYNC_TO_VBLANK=0
+
+# directory | build command | executable, run from the directory so relative assets resolve
+SAMPLES=(
+    "cube-gradient-rotate|make cube|./cube"
+    "cube-random|make cube|./cube"
+    "cube-shader|make cube|./cube"
+    "cube-texture-rotate|make cube|./cube"
+    "cube-transform|make cube|./cube"
+    "gl-ctxt|make gl-ctxt|./gl-ctxt"
+    "triangle-shader|make triangle|./triangle"
+    "triangle-texture|make triangle|./triangle"
+    "vmath|make vmath|./vmath"
+    "vmath-cube|make cube|./cube"
+    "vmath-vao|make vmath wall.ktx|./vmath"
+    "pp/01-Triangle|cmake -S . -B build && cmake --build build|./build/triangle"
+    "pp/02-Perspective|cmake -S . -B build && cmake --build build|./build/perspective"
+    "pp/03-Shadow|cmake -S . -B build && cmake --build build|./build/shadow"
+    "ffp/disco|g++ -O2 -o disco main.cpp stb.cpp -lX11 -lGL -lGLU|./disco"
+    "ffp/doughnut|g++ -O2 -o doughnut main.cpp -lX11 -lGL -lGLU|./doughnut"
+    "ffp/fractal|g++ -O2 -o fractal main.cpp -lX11 -lGL -lGLU -lpthread|./fractal"
+    "ffp/mandlebrot|make mandelbrot|./mandelbrot"
+    "ffp/shadow|g++ -O2 -o shadow main.cpp profiler.cpp -lX11 -lGL -lGLU -lpthread|./shadow"
+    "ffp/triangle|g++ -O2 -o triangle main.cpp -lX11 -lGL|./triangle"
+)
+
+# no display on a build machine: start a virtual one for the whole run
+if [ -z "${DISPLAY:-}" ]; then
+    if ! command -v xvfb-run > /dev/null; then
+        echo "no DISPLAY and xvfb-run not found" >&2
+        exit 2
+    fi
+    exec xvfb-run -a -s "-screen 0 1920x1200x24" "$0" "$@"
+fi
+
+make -C benchmark bench-compare > /dev/null || exit 2
+mkdir -p "$RESULTS" "$BASELINE_DIR"
+
+status=0
+
+# store report as the baseline or compare it with the stored one
+check() {
+    local name=$1 report=$2
+    if [ -n "${BASELINE:-}" ]; then
+        cp "$report" "$BASELINE_DIR/$name.json"
+        echo "   stored as baseline"
+    elif [ -f "$BASELINE_DIR/$name.json" ]; then
+        benchmark/bench-compare "$BASELINE_DIR/$name.json" "$report" || status=1
+    else
+        cat "$report"
+    fi
+}
+
+for entry in "${SAMPLES[@]}"; do
+    IFS='|' read -r dir build executable <<< "$entry"
+    name=${dir//\//-}
+    report=$RESULTS/$name.json
+
+    echo "== $dir"
+    if ! (cd "$dir" && eval "$build") > "$RESULTS/$name.build.log" 2>&1; then
+        echo "   build failed, see $RESULTS/$name.build.log"
+        status=1
+        continue
+    fi
+
+    if ! (cd "$dir" && BENCHMARK_OUTPUT=$report timeout 300 "$executable") > "$RESULTS/$name.log" 2>&1 || [ ! -s "$report" ]; then
+        echo "   run failed, see $RESULTS/$name.log"
+        status=1
+        continue
+    fi
+    check "$name" "$report"
+done
+
+echo "== micro"
+if make -C benchmark micro > "$RESULTS/micro.build.log" 2>&1 && benchmark/micro -o "$RESULTS/micro.json"; then
+    check micro "$RESULTS/micro.json"
+else
+    echo "   micro failed, see $RESULTS/micro.build.log"
+    status=1
+fi
+
+exit $status
@@ -0,0 +1,179 @@
+#ifndef STARTUP_H
+#define STARTUP_H
+/**
+ * @file      startup.h
+ * @brief     Timeline of the startup phases up to the first frame
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * A sample opens spans for the phases of its initialization on whichever
+ * thread runs them and marks the first frame once it is swapped. The time to
+ * first frame is printed with every span as an offset from startupInit(),
+ * spans on different lanes overlapping in time ran in parallel. With
+ * STARTUP_TRACE set the spans are also written there as a Chrome trace,
+ * one track per lane. Used from C and C++, header only.
+ *
+ *   struct StartupTrace startup;
+ *   startupInit(&startup);
+ *   uint32_t span = startupBegin(&startup, "main", "open display");
+ *   dpy = XOpenDisplay(NULL);
+ *   startupEnd(&startup, span);
+ *   ...
+ *   glXSwapBuffers(dpy, w);
+ *   startupFirstFrame(&startup);
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* spans recorded, later ones are ignored */
+#define STARTUP_MAX_SPANS 32
+
+/* lanes shown in the report and trace */
+#define STARTUP_MAX_LANES 4
+
+struct StartupSpan
+{
+    const char *lane; // string literal, thread the phase ran on
+    const char *name; // string literal, never copied
+    double      beginMs;
+    double      endMs; // 0 while running
+};
+
+struct StartupTrace
+{
+    double             originMs;
+    double             firstFrameMs; // 0 until the first frame was swapped
+    uint32_t           nSpans;       // claimed atomically, spans can be opened from any thread
+    struct StartupSpan spans[STARTUP_MAX_SPANS];
+};
+
+static inline double startupClock()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static inline void startupInit(struct StartupTrace *trace)
+{
+    memset(trace, 0, sizeof(struct StartupTrace));
+    trace->originMs = startupClock();
+}
+
+/**
+ * @brief milliseconds since startupInit()
+ */
+static inline double startupElapsedMs(const struct StartupTrace *trace)
+{
+    return startupClock() - trace->originMs;
+}
+
+/**
+ * @brief open a span, safe to call from several threads
+ * @return handle for startupEnd(), STARTUP_MAX_SPANS when the trace is full
+ */
+static inline uint32_t startupBegin(struct StartupTrace *trace, const char *lane, const char *name)
+{
+    uint32_t span = __atomic_fetch_add(&trace->nSpans, 1U, __ATOMIC_RELAXED);
+    if (span >= STARTUP_MAX_SPANS)
+        return STARTUP_MAX_SPANS;
+
+    trace->spans[span].lane    = lane;
+    trace->spans[span].name    = name;
+    trace->spans[span].beginMs = startupElapsedMs(trace);
+    return span;
+}
+
+static inline void startupEnd(struct StartupTrace *trace, uint32_t span)
+{
+    if (span < STARTUP_MAX_SPANS)
+        trace->spans[span].endMs = startupElapsedMs(trace);
+}
+
+static inline int startupWriteTrace(const struct StartupTrace *trace, const char *path)
+{
+    const char *lanes[STARTUP_MAX_LANES];
+    uint32_t    nLanes = 0U;
+    uint32_t    nSpans = trace->nSpans < STARTUP_MAX_SPANS ? trace->nSpans : STARTUP_MAX_SPANS;
+    FILE       *pFile  = fopen(path, "w");
+
+    if (NULL == pFile)
+    {
+        fprintf(stderr, "[%s] cannot write %s\n", __func__, path);
+        return -1;
+    }
+
+    fprintf(pFile, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    fprintf(pFile, "{\"name\":\"first frame\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":1,\"ts\":%.3f}", trace->firstFrameMs * 1e3);
+    for (uint32_t span = 0U; span < nSpans; ++span)
+    {
+        uint32_t lane  = 0U;
+        double   endMs = trace->spans[span].endMs;
+
+        /* spans still running are cut at the first frame */
+        if (0.0 == endMs)
+            endMs = trace->firstFrameMs;
+        if (endMs < trace->spans[span].beginMs)
+            endMs = trace->spans[span].beginMs;
+
+        while (lane < nLanes && 0 != strcmp(lanes[lane], trace->spans[span].lane))
+            ++lane;
+        if (lane == nLanes && nLanes < STARTUP_MAX_LANES)
+        {
+            lanes[nLanes++] = trace->spans[span].lane;
+            fprintf(pFile, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}", lane + 1U, trace->spans[span].lane);
+        }
+        fprintf(pFile, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", trace->spans[span].name, lane + 1U, trace->spans[span].beginMs * 1e3,
+                (endMs - trace->spans[span].beginMs) * 1e3);
+    }
+    fprintf(pFile, "\n]}\n");
+
+    if (0 != fclose(pFile))
+    {
+        fprintf(stderr, "[%s] cannot write %s\n", __func__, path);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief to be called right after the first swap, prints the timeline once
+ */
+static inline void startupFirstFrame(struct StartupTrace *trace)
+{
+    const char *output = getenv("STARTUP_TRACE");
+    uint32_t    nSpans = 0U;
+
+    if (0.0 != trace->firstFrameMs)
+        return;
+
+    trace->firstFrameMs = startupElapsedMs(trace);
+    nSpans              = __atomic_load_n(&trace->nSpans, __ATOMIC_ACQUIRE);
+    nSpans              = nSpans < STARTUP_MAX_SPANS ? nSpans : STARTUP_MAX_SPANS;
+
+    fprintf(stderr, "[%s] time to first frame: %.2f ms\n", __func__, trace->firstFrameMs);
+    for (uint32_t span = 0U; span < nSpans; ++span)
+    {
+        const struct StartupSpan *s = &trace->spans[span];
+        if (0.0 == s->endMs)
+            fprintf(stderr, "    %-8s %8.2f ms            running  %s\n", s->lane, s->beginMs, s->name);
+        else
+            fprintf(stderr, "    %-8s %8.2f ms  %8.2f ms  %s\n", s->lane, s->beginMs, s->endMs - s->beginMs, s->name);
+    }
+
+    if (NULL != output)
+        startupWriteTrace(trace, output);
+}
+
+#endif
@@ -24,6 +24,8 @@
 #include "X11/XKBlib.h"
 
 #include "shader.h"
+#include "../../benchmark/benchmark.h"
+#include "../../benchmark/gldebug.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <math.h>
 
@@ -174,8 +176,11 @@ int main()
     wm_delete_window = XInternAtom(dpy, "WM_DELETE_WINDOW", False);
     XSetWMProtocols(dpy, w, &wm_delete_window, 1);
 
+    /* debug context reporting performance warnings when GL_DEBUG is set */
+    struct DebugOutput debug;
+
     /* create opengl context */
-    ctxt = glXCreateContext(dpy, vi, nullptr, GL_TRUE);
+    ctxt = debugOutputCreateContext(&debug, dpy, vi);
     glXMakeCurrent(dpy, w, ctxt);
 
     /* initialize glew */
@@ -191,6 +196,8 @@ int main()
         return -1;
     }
 
+    debugOutputInstall(&debug);
+
     /* free XVisual as it is not required */
     XFree(vi);
     vi = nullptr;
@@ -237,6 +244,10 @@ int main()
     glm::mat4 Model      = glm::mat4(1.0f);
     glm::mat4 MVP        = Projection * View * Model;
 
+    /* fixed workload with timing report when BENCHMARK_FRAMES is set */
+    struct Benchmark bench;
+    benchmarkInit(&bench, "cube-gradient-rotate");
+
     while (!globalAbortFlag)
     {
         XEvent evt;
@@ -282,6 +293,8 @@ int main()
         }
 
         if (!shouldDraw) continue;
+        benchmarkBeginFrame(&bench);
+        benchmarkPhase(&bench, "update");
         static GLfloat x, y = 3.0, z;
         static GLdouble theta = 3;
         theta += 0.005;
@@ -291,6 +304,7 @@ int main()
         View = glm::lookAt(glm::vec3(x, y, z), glm::vec3(0, 0, 0), glm::vec3(0, 1, 0));
         MVP  = Projection * View * Model;
 
+        benchmarkPhase(&bench, "render");
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
         glUseProgram(program);
@@ -298,7 +312,10 @@ int main()
         glBindVertexArray(vertexArrayBuffer);
 
         glDrawElements(GL_TRIANGLES, 72, GL_UNSIGNED_INT, 0);
+        benchmarkPhase(&bench, "swap");
         glXSwapBuffers(dpy, w);
+        if (benchmarkEndFrame(&bench))
+            globalAbortFlag = true;
     }
 
     /* resource cleanup */
@@ -308,6 +325,7 @@ int main()
     glDeleteBuffers(1, &vertexBuffer);
     glDeleteVertexArrays(1, &vertexArrayBuffer);
     glDeleteProgram(program);
+    debugOutputReport(&debug, stderr);
     glXDestroyContext(dpy, ctxt);
     XFreeColormap(dpy, xattr.colormap);
     XDestroyWindow(dpy, w);
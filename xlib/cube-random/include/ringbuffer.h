@@ -0,0 +1,107 @@
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+/**
+ * @file      ringbuffer.h
+ * @brief     Persistently mapped ring buffer for per-frame data
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <GL/glew.h>
+
+#include <cstdint>
+
+#define STREAM_MAX_REGIONS 4
+
+/**
+ * @brief Buffer mapped once for its whole lifetime and split into per-frame regions
+ *
+ * Storage is created with glBufferStorage() and mapped persistent and
+ * coherent, so writes land in GPU visible memory without glBufferData()
+ * reallocations or map/unmap round trips. The CPU writes region N while the
+ * GPU still reads regions N-1 and N-2, a fence placed at the end of every
+ * frame tells when a region may be overwritten.
+ *
+ * Data allocated in a frame is only valid until that frame's endFrame() has
+ * cycled through all regions, it must be re-written every frame.
+ *
+ * Requires OpenGL 4.4 or GL_ARB_buffer_storage.
+ */
+class StreamBuffer
+{
+  public:
+    StreamBuffer();
+
+    /**
+     * @brief create and map storage
+     *
+     * @param regionSize bytes available per frame
+     * @param nRegions   number of frames in flight [2 - STREAM_MAX_REGIONS]
+     * @return 0 on success, -1 otherwise
+     */
+    int initialize(GLsizeiptr regionSize, GLuint nRegions = 3U);
+
+    void uninitialize();
+
+    /**
+     * @brief move to the next region, waits only if the GPU is still reading it
+     */
+    void beginFrame();
+
+    /**
+     * @brief sub-allocate from the current region
+     *
+     * @param size      bytes to allocate
+     * @param alignment required alignment of offset, need not be a power of two
+     * @param pOffset   receives offset of allocation from start of buffer
+     * @return CPU pointer to write to, nullptr when the region is exhausted
+     */
+    void *allocate(GLsizeiptr size, GLsizeiptr alignment, GLintptr *pOffset);
+
+    /**
+     * @brief fence the current region after the last command reading it
+     */
+    void endFrame();
+
+    GLuint buffer() const
+    {
+        return name;
+    }
+
+    GLsizeiptr used() const
+    {
+        return head;
+    }
+
+    GLsizeiptr capacity() const
+    {
+        return regionSize;
+    }
+
+    /**
+     * @brief number of times beginFrame() had to wait on the GPU
+     */
+    uint32_t stalls() const
+    {
+        return nStalls;
+    }
+
+  private:
+    GLuint     name;
+    uint8_t   *mapped;
+    GLsizeiptr regionSize;
+    GLuint     nRegions;
+    GLuint     region;
+    GLsizeiptr head; // bytes used in current region
+    GLsync     fences[STREAM_MAX_REGIONS];
+    uint32_t   nStalls;
+};
+
+#endif
@@ -27,6 +27,9 @@
 #include <X11/keysymdef.h>
 #include "X11/XKBlib.h"
 #include "shader.h"
+#include "ringbuffer.h"
+#include "../../benchmark/benchmark.h"
+#include "../../benchmark/gldebug.h"
 #include <glm/gtc/matrix_transform.hpp>
 
 #define GLX_MAJOR_MIN 1
@@ -48,7 +51,7 @@ int main()
     GLint result                 = 0;
     GLuint program               = 0U;
     GLuint vertexBuffer          = 0U;
-    GLuint colorBuffer           = 0U;
+    StreamBuffer colorRing;
     GLboolean shouldDraw         = false;
 
     // clang-format off
@@ -90,44 +93,6 @@ int main()
         -1.0f, 1.0f, 1.0f,
         1.0f,-1.0f, 1.0f
     };
-    static GLfloat colorBufferData[] = {
-        0.583f,  0.771f,  0.014f,
-        0.609f,  0.115f,  0.436f,
-        0.327f,  0.483f,  0.844f,
-        0.822f,  0.569f,  0.201f,
-        0.435f,  0.602f,  0.223f,
-        0.310f,  0.747f,  0.185f,
-        0.597f,  0.770f,  0.761f,
-        0.559f,  0.436f,  0.730f,
-        0.359f,  0.583f,  0.152f,
-        0.483f,  0.596f,  0.789f,
-        0.559f,  0.861f,  0.639f,
-        0.195f,  0.548f,  0.859f,
-        0.014f,  0.184f,  0.576f,
-        0.771f,  0.328f,  0.970f,
-        0.406f,  0.615f,  0.116f,
-        0.676f,  0.977f,  0.133f,
-        0.971f,  0.572f,  0.833f,
-        0.140f,  0.616f,  0.489f,
-        0.997f,  0.513f,  0.064f,
-        0.945f,  0.719f,  0.592f,
-        0.543f,  0.021f,  0.978f,
-        0.279f,  0.317f,  0.505f,
-        0.167f,  0.620f,  0.077f,
-        0.347f,  0.857f,  0.137f,
-        0.055f,  0.953f,  0.042f,
-        0.714f,  0.505f,  0.345f,
-        0.783f,  0.290f,  0.734f,
-        0.722f,  0.645f,  0.174f,
-        0.302f,  0.455f,  0.848f,
-        0.225f,  0.587f,  0.040f,
-        0.517f,  0.713f,  0.338f,
-        0.053f,  0.959f,  0.120f,
-        0.393f,  0.621f,  0.362f,
-        0.673f,  0.211f,  0.457f,
-        0.820f,  0.883f,  0.371f,
-        0.982f,  0.099f,  0.879f
-    };
     // clang-format on
 
     dpy = XOpenDisplay(NULL);
@@ -179,8 +144,11 @@ int main()
     w = XCreateWindow(dpy, root, 0, 0, 1024, 768, 0, vi->depth, InputOutput, vi->visual, CWBackPixel | CWColormap | CWBorderPixel | CWEventMask, &xattr);
     XStoreName(dpy, w, "Rohit Nimkar: OpenGL demo with X11");
 
+    /* debug context reporting performance warnings when GL_DEBUG is set */
+    struct DebugOutput debug;
+
     /* create opengl context */
-    ctxt = glXCreateContext(dpy, vi, nullptr, GL_TRUE);
+    ctxt = debugOutputCreateContext(&debug, dpy, vi);
     glXMakeCurrent(dpy, w, ctxt);
 
     /* initialize glew */
@@ -196,6 +164,8 @@ int main()
         return -1;
     }
 
+    debugOutputInstall(&debug);
+
     /* free XVisual as it is not required */
     XFree(vi);
     vi = nullptr;
@@ -209,10 +179,12 @@ int main()
     glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
     glBufferData(GL_ARRAY_BUFFER, sizeof(vertexBufferData), vertexBufferData, GL_STATIC_DRAW);
 
-    /* initialize color buffer */
-    glGenBuffers(1, &colorBuffer);
-    glBindBuffer(GL_ARRAY_BUFFER, colorBuffer);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(colorBufferData), colorBufferData, GL_STATIC_DRAW);
+    /* initialize color ring, colors are regenerated every frame straight into mapped memory */
+    if (0 != colorRing.initialize(36 * 3 * sizeof(GLfloat)))
+    {
+        std::cerr << "Failed to create color ring buffer\n";
+        return -1;
+    }
 
     // Create and compile our GLSL program from the shaders
     result = LoadShaders("vertex.glsl", "fragment.glsl", &program);
@@ -237,52 +209,64 @@ int main()
     glm::mat4 Model      = glm::mat4(1.0f);
     glm::mat4 MVP        = Projection * View * Model;
 
+    /* fixed workload with timing report when BENCHMARK_FRAMES is set */
+    struct Benchmark bench;
+    benchmarkInit(&bench, "cube-random");
+
     while (!globalAbortFlag)
     {
         XEvent evt;
-        XNextEvent(dpy, &evt);
-        switch (evt.type)
-        {
-        case Expose:
-        {
-            if (!shouldDraw) shouldDraw = true;
-            break;
-        }
-        case ClientMessage:
-        {
-            if (evt.xclient.data.l[0] == wm_delete_window) { globalAbortFlag = true; }
-            break;
-        }
-        case KeyPress:
+
+        /* benchmark mode renders back to back instead of waiting for events */
+        if (!bench.enabled || XPending(dpy))
         {
-            KeySym sym = XkbKeycodeToKeysym(dpy, evt.xkey.keycode, 0, 0);
-            if (XK_Escape == sym)
+            XNextEvent(dpy, &evt);
+            switch (evt.type)
+            {
+            case Expose:
             {
-                globalAbortFlag = true;
-                shouldDraw      = false;
+                if (!shouldDraw) shouldDraw = true;
+                break;
+            }
+            case ClientMessage:
+            {
+                if (evt.xclient.data.l[0] == wm_delete_window) { globalAbortFlag = true; }
+                break;
+            }
+            case KeyPress:
+            {
+                KeySym sym = XkbKeycodeToKeysym(dpy, evt.xkey.keycode, 0, 0);
+                if (XK_Escape == sym)
+                {
+                    globalAbortFlag = true;
+                    shouldDraw      = false;
+                }
+                break;
+            }
+            case MapNotify:
+            {
+                std::cout << "GL Vendor: " << glGetString(GL_VENDOR) << "\n";
+                std::cout << "GL Renderer: " << glGetString(GL_RENDERER) << "\n";
+                std::cout << "GL Version: " << glGetString(GL_VERSION) << "\n";
+                std::cout << "GL Shading Language: " << glGetString(GL_SHADING_LANGUAGE_VERSION) << "\n";
+                break;
+            }
+            default:
+            {
+                std::cout << "Default event: " << evt.type << std::endl;
+                break;
+            }
             }
-            break;
-        }
-        case MapNotify:
-        {
-            std::cout << "GL Vendor: " << glGetString(GL_VENDOR) << "\n";
-            std::cout << "GL Renderer: " << glGetString(GL_RENDERER) << "\n";
-            std::cout << "GL Version: " << glGetString(GL_VERSION) << "\n";
-            std::cout << "GL Shading Language: " << glGetString(GL_SHADING_LANGUAGE_VERSION) << "\n";
-            break;
-        }
-        default:
-        {
-            std::cout << "Default event: " << evt.type << std::endl;
-            break;
-        }
         }
 
         if (!shouldDraw) continue;
+        benchmarkBeginFrame(&bench);
+        benchmarkPhase(&bench, "update");
 
         /* redraw frame */
-        std::cout << "redrawing frame" << std::endl;
+        // std::cout << "redrawing frame" << std::endl;
 
+        benchmarkPhase(&bench, "render");
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
         glUseProgram(program);
@@ -292,7 +276,10 @@ int main()
         glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
         glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, (void*)0);
 
-        /* enable color buffer */
+        /* enable color buffer, waits only if the GPU still reads this region */
+        colorRing.beginFrame();
+        GLintptr colorOffset = 0;
+        GLfloat *colorBufferData = (GLfloat *)colorRing.allocate(36 * 3 * sizeof(GLfloat), sizeof(GLfloat), &colorOffset);
         for(int i=0; i< 36; ++i)
         {
             colorBufferData[i*3] = static_cast <float> (rand()) / static_cast <float> (RAND_MAX);
@@ -301,17 +288,22 @@ int main()
         }
 
         glEnableVertexAttribArray(1);
-        glBindBuffer(GL_ARRAY_BUFFER, colorBuffer);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(colorBufferData), colorBufferData, GL_STATIC_DRAW);
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 0, (void*)0);
+        glBindBuffer(GL_ARRAY_BUFFER, colorRing.buffer());
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 0, (void*)colorOffset);
 
         glDrawArrays(GL_TRIANGLES, 0, 36);
+        colorRing.endFrame();
+        benchmarkPhase(&bench, "swap");
         glXSwapBuffers(dpy, w);
+        if (benchmarkEndFrame(&bench))
+            globalAbortFlag = true;
     }
 
     /* resource cleanup */
     glDeleteBuffers(1, &vertexBuffer);
+    colorRing.uninitialize();
     glDeleteProgram(program);
+    debugOutputReport(&debug, stderr);
     glXDestroyContext(dpy, ctxt);
     XFreeColormap(dpy, xattr.colormap);
     XDestroyWindow(dpy, w);
@@ -0,0 +1,112 @@
+#ifndef SHADERRELOAD_H
+#define SHADERRELOAD_H
+/**
+ * @file      shaderreload.h
+ * @brief     Rebuild program when its shader files change on disk
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <GL/glew.h>
+
+#include <string>
+
+#define RELOAD_STAGES 2
+
+/**
+ * @brief One shader stage of the watched program
+ */
+struct ReloadStage
+{
+    std::string path;    // file as passed to initialize()
+    std::string name;    // file name without directory, matched against inotify events
+    GLenum      type;    // GL_VERTEX_SHADER or GL_FRAGMENT_SHADER
+    GLuint      shader;  // last good shader object, stays attached to nothing
+    GLuint      pending; // shader being compiled, 0 when stage is unchanged
+    int         watch;   // inotify watch descriptor of containing directory
+    bool        dirty;   // file changed since last rebuild was started
+};
+
+/**
+ * @brief Watches shader files with inotify and swaps in a relinked program
+ *
+ * Directories are watched rather than files because editors usually save by
+ * writing a new file and renaming it over the old one. Only stages whose file
+ * changed are recompiled, the other stage is relinked from its existing
+ * shader object.
+ *
+ * update() is meant to be called once per frame. With
+ * GL_KHR_parallel_shader_compile or its ARB variant the rebuild runs in the
+ * driver's background threads and update() only polls it, the first build
+ * included, without the extension the rebuild finishes within the update()
+ * that started it. A program that fails to compile or link is thrown away and
+ * the last good one stays in use.
+ */
+class ShaderReloader
+{
+  public:
+    ShaderReloader();
+
+    /**
+     * @brief start building the program and watching its files
+     *
+     * With parallel compile the first build is still running on return,
+     * program() is 0 until update() reports it done.
+     *
+     * @return 0 on success, -1 when the first build cannot be started or fails
+     *         synchronously, or inotify setup fails
+     */
+    int initialize(const char *vertexFile, const char *fragmentFile);
+
+    void uninitialize();
+
+    /**
+     * @brief handle file changes and finish rebuilds
+     *
+     * @return true when program() changed, uniform locations have to be queried again
+     */
+    bool update();
+
+    GLuint program() const
+    {
+        return current;
+    }
+
+    /**
+     * @brief inotify descriptor, readable when a watched directory changed
+     */
+    int fd() const
+    {
+        return inotifyFd;
+    }
+
+    /**
+     * @brief rebuild in flight, caller has to keep calling update()
+     */
+    bool isPending() const
+    {
+        return 0U != pendingProgram;
+    }
+
+  private:
+    void   readEvents();
+    void   startRebuild();
+    bool   finishRebuild();
+    GLuint compile(GLenum type, const std::string &path);
+    void   discardPending();
+
+    ReloadStage stages[RELOAD_STAGES];
+    GLuint      current;
+    GLuint      pendingProgram;
+    int         inotifyFd;
+    bool        parallel;
+};
+
+#endif
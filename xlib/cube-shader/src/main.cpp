@@ -27,11 +27,38 @@
 #include <X11/keysymdef.h>
 #include "X11/XKBlib.h"
 #include "shader.h"
+#include "shaderreload.h"
+#include "../../benchmark/benchmark.h"
+#include "../../benchmark/gldebug.h"
 #include <glm/gtc/matrix_transform.hpp>
+#include <sys/select.h>
 
 #define GLX_MAJOR_MIN 1
 #define GLX_MINOR_MIN 2
 
+/* poll interval while a shader rebuild is in flight */
+#define RELOAD_POLL_USEC 16000
+
+/**
+ * @brief sleep until an X event arrives or a shader file changes
+ *
+ * @return true when an X event is ready to be read
+ */
+static bool waitForEvent(Display* dpy, const ShaderReloader& reloader)
+{
+    if (XPending(dpy)) return true;
+
+    fd_set fds;
+    int xfd            = ConnectionNumber(dpy);
+    struct timeval tv  = {0, RELOAD_POLL_USEC};
+    FD_ZERO(&fds);
+    FD_SET(xfd, &fds);
+    FD_SET(reloader.fd(), &fds);
+    select((xfd > reloader.fd() ? xfd : reloader.fd()) + 1, &fds, nullptr, nullptr, reloader.isPending() ? &tv : nullptr);
+
+    return XPending(dpy) > 0;
+}
+
 int main()
 {
     Display* dpy                 = nullptr;
@@ -45,8 +72,7 @@ int main()
     bool globalAbortFlag         = false;
     static Atom wm_delete_window = 0;
     GLXContext ctxt              = nullptr;
-    GLint result                 = 0;
-    GLuint program               = 0U;
+    ShaderReloader reloader;
     GLuint vertexBuffer          = 0U;
     GLuint colorBuffer           = 0U;
     GLboolean shouldDraw         = false;
@@ -179,8 +205,11 @@ int main()
     w = XCreateWindow(dpy, root, 0, 0, 1024, 768, 0, vi->depth, InputOutput, vi->visual, CWBackPixel | CWColormap | CWBorderPixel | CWEventMask, &xattr);
     XStoreName(dpy, w, "Rohit Nimkar: OpenGL demo with X11");
 
+    /* debug context reporting performance warnings when GL_DEBUG is set */
+    struct DebugOutput debug;
+
     /* create opengl context */
-    ctxt = glXCreateContext(dpy, vi, nullptr, GL_TRUE);
+    ctxt = debugOutputCreateContext(&debug, dpy, vi);
     glXMakeCurrent(dpy, w, ctxt);
 
     /* initialize glew */
@@ -196,6 +225,8 @@ int main()
         return -1;
     }
 
+    debugOutputInstall(&debug);
+
     /* free XVisual as it is not required */
     XFree(vi);
     vi = nullptr;
@@ -214,9 +245,8 @@ int main()
     glBindBuffer(GL_ARRAY_BUFFER, colorBuffer);
     glBufferData(GL_ARRAY_BUFFER, sizeof(colorBufferData), colorBufferData, GL_STATIC_DRAW);
 
-    // Create and compile our GLSL program from the shaders
-    result = LoadShaders("vertex.glsl", "fragment.glsl", &program);
-    if (GL_TRUE != result)
+    // Create and compile our GLSL program from the shaders, rebuilt whenever they are saved
+    if (0 != reloader.initialize("vertex.glsl", "fragment.glsl"))
     {
         std::cerr << "Failed to link program\n";
         return -1;
@@ -228,7 +258,7 @@ int main()
     XMapWindow(dpy, w);
 
     /* generate transformation matrix */
-    GLuint MatrixID      = glGetUniformLocation(program, "MVP");
+    GLuint MatrixID      = reloader.program() ? glGetUniformLocation(reloader.program(), "MVP") : 0U;
     glm::mat4 Projection = glm::perspective(glm::radians(45.0f), 4.0f / 3.0f, 0.1f, 100.0f);
     glm::mat4 View       = glm::lookAt(glm::vec3(4, 3, -3), // Camera is at (4,3,3), in World Space
               glm::vec3(0, 0, 0),                           // and looks at the origin
@@ -237,12 +267,23 @@ int main()
     glm::mat4 Model      = glm::mat4(1.0f);
     glm::mat4 MVP        = Projection * View * Model;
 
+    /* fixed workload with timing report when BENCHMARK_FRAMES is set */
+    struct Benchmark bench;
+    benchmarkInit(&bench, "cube-shader");
+
     while (!globalAbortFlag)
     {
         XEvent evt;
-        XNextEvent(dpy, &evt);
+        evt.type = 0;
+        /* benchmark mode renders back to back, only pending events are read */
+        if (bench.enabled ? XPending(dpy) > 0 : waitForEvent(dpy, reloader)) { XNextEvent(dpy, &evt); }
         switch (evt.type)
         {
+        case 0:
+        {
+            /* woken up by shader watcher */
+            break;
+        }
         case Expose:
         {
             if (!shouldDraw) shouldDraw = true;
@@ -280,12 +321,25 @@ int main()
 
         if (!shouldDraw) continue;
 
+        /* first build compiles in the background, nothing to draw with until it is in */
+        if (0U == reloader.program())
+        {
+            if (!reloader.update()) continue;
+            MatrixID = glGetUniformLocation(reloader.program(), "MVP");
+        }
+        benchmarkBeginFrame(&bench);
+        benchmarkPhase(&bench, "update");
+
         /* redraw frame */
-        std::cout << "redrawing frame" << std::endl;
+        // std::cout << "redrawing frame" << std::endl;
+
+        /* frame boundary, swap in a rebuilt program */
+        if (reloader.update()) { MatrixID = glGetUniformLocation(reloader.program(), "MVP"); }
 
+        benchmarkPhase(&bench, "render");
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-        glUseProgram(program);
+        glUseProgram(reloader.program());
         glUniformMatrix4fv(MatrixID, 1, GL_FALSE, &MVP[0][0]);
         /* enable vertex buffer */
         glEnableVertexAttribArray(0);
@@ -298,12 +352,16 @@ int main()
         glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 0, (void*)0);
 
         glDrawArrays(GL_TRIANGLES, 0, 36);
+        benchmarkPhase(&bench, "swap");
         glXSwapBuffers(dpy, w);
+        if (benchmarkEndFrame(&bench))
+            globalAbortFlag = true;
     }
 
     /* resource cleanup */
     glDeleteBuffers(1, &vertexBuffer);
-    glDeleteProgram(program);
+    reloader.uninitialize();
+    debugOutputReport(&debug, stderr);
     glXDestroyContext(dpy, ctxt);
     XFreeColormap(dpy, xattr.colormap);
     XDestroyWindow(dpy, w);
@@ -0,0 +1,298 @@
+/**
+ * @file      shaderreload.cpp
+ * @brief     Rebuild program when its shader files change on disk
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <vector>
+
+#include "shaderreload.h"
+
+/* editors either rewrite a file in place or rename a new one over it */
+#define RELOAD_EVENTS (IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE)
+
+/* let the driver pick as many compiler threads as it supports */
+#define RELOAD_COMPILER_THREADS 0xffffffffU
+
+static void printLog(GLuint object, bool isProgram)
+{
+    GLint length = 0;
+
+    if (isProgram)
+        glGetProgramiv(object, GL_INFO_LOG_LENGTH, &length);
+    else
+        glGetShaderiv(object, GL_INFO_LOG_LENGTH, &length);
+
+    if (length > 0)
+    {
+        std::vector<char> log(length + 1);
+        if (isProgram)
+            glGetProgramInfoLog(object, length, nullptr, log.data());
+        else
+            glGetShaderInfoLog(object, length, nullptr, log.data());
+        std::cerr << log.data() << std::endl;
+    }
+}
+
+ShaderReloader::ShaderReloader() : current(0U), pendingProgram(0U), inotifyFd(-1), parallel(false)
+{
+    for (int idx = 0; idx < RELOAD_STAGES; ++idx)
+    {
+        stages[idx].type    = 0;
+        stages[idx].shader  = 0U;
+        stages[idx].pending = 0U;
+        stages[idx].watch   = -1;
+        stages[idx].dirty   = false;
+    }
+}
+
+int ShaderReloader::initialize(const char *vertexFile, const char *fragmentFile)
+{
+    const char  *files[RELOAD_STAGES] = {vertexFile, fragmentFile};
+    const GLenum types[RELOAD_STAGES] = {GL_VERTEX_SHADER, GL_FRAGMENT_SHADER};
+
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd < 0)
+    {
+        std::cerr << "Failed to initialize inotify: " << strerror(errno) << std::endl;
+        return -1;
+    }
+
+    for (int idx = 0; idx < RELOAD_STAGES; ++idx)
+    {
+        ReloadStage &stage = stages[idx];
+        size_t       slash;
+
+        stage.path  = files[idx];
+        stage.type  = types[idx];
+        slash       = stage.path.rfind('/');
+        stage.name  = std::string::npos == slash ? stage.path : stage.path.substr(slash + 1U);
+        stage.watch = inotify_add_watch(inotifyFd, std::string::npos == slash ? "." : stage.path.substr(0U, slash).c_str(), RELOAD_EVENTS);
+        if (stage.watch < 0)
+        {
+            std::cerr << "Failed to watch " << stage.path << ": " << strerror(errno) << std::endl;
+            return -1;
+        }
+        stage.dirty = true;
+    }
+
+    if (GLEW_KHR_parallel_shader_compile)
+    {
+        glMaxShaderCompilerThreadsKHR(RELOAD_COMPILER_THREADS);
+        parallel = true;
+    }
+    else if (GLEW_ARB_parallel_shader_compile)
+    {
+        glMaxShaderCompilerThreadsARB(RELOAD_COMPILER_THREADS);
+        parallel = true;
+    }
+
+    /* first build is polled by update() like any rebuild, program() stays 0 until it is in */
+    startRebuild();
+    if (0U == pendingProgram)
+        return -1;
+    if (parallel)
+        return 0;
+    return finishRebuild() ? 0 : -1;
+}
+
+void ShaderReloader::uninitialize()
+{
+    discardPending();
+    for (int idx = 0; idx < RELOAD_STAGES; ++idx)
+    {
+        if (stages[idx].shader)
+        {
+            glDeleteShader(stages[idx].shader);
+            stages[idx].shader = 0U;
+        }
+    }
+
+    if (current)
+    {
+        glDeleteProgram(current);
+        current = 0U;
+    }
+
+    if (inotifyFd >= 0)
+    {
+        close(inotifyFd);
+        inotifyFd = -1;
+    }
+}
+
+void ShaderReloader::readEvents()
+{
+    alignas(struct inotify_event) char buffer[4096];
+    ssize_t                            length;
+
+    while ((length = read(inotifyFd, buffer, sizeof(buffer))) > 0)
+    {
+        for (char *ptr = buffer; ptr < buffer + length;)
+        {
+            const struct inotify_event *event = (const struct inotify_event *)ptr;
+            for (int idx = 0; idx < RELOAD_STAGES; ++idx)
+            {
+                if (event->len && event->wd == stages[idx].watch && stages[idx].name == event->name)
+                    stages[idx].dirty = true;
+            }
+            ptr += sizeof(struct inotify_event) + event->len;
+        }
+    }
+}
+
+GLuint ShaderReloader::compile(GLenum type, const std::string &path)
+{
+    std::ifstream     sourceInputStream(path.c_str(), std::ios::in);
+    std::stringstream sstr;
+
+    if (!sourceInputStream.is_open())
+    {
+        std::cerr << "failed to read shader " << path << std::endl;
+        return 0U;
+    }
+    sstr << sourceInputStream.rdbuf();
+
+    /* status is checked after linking, querying it here would wait for the compiler */
+    std::string source  = sstr.str();
+    const char *pSource = source.c_str();
+    GLuint      shader  = glCreateShader(type);
+    glShaderSource(shader, 1, &pSource, nullptr);
+    glCompileShader(shader);
+    return shader;
+}
+
+void ShaderReloader::startRebuild()
+{
+    for (int idx = 0; idx < RELOAD_STAGES; ++idx)
+    {
+        ReloadStage &stage = stages[idx];
+        if (false == stage.dirty)
+            continue;
+
+        stage.dirty   = false;
+        stage.pending = compile(stage.type, stage.path);
+        std::cout << "Recompiling shader: " << stage.path << std::endl;
+    }
+
+    /* unchanged stages are linked from the shader object of the last good program */
+    pendingProgram = glCreateProgram();
+    for (int idx = 0; idx < RELOAD_STAGES; ++idx)
+    {
+        GLuint shader = stages[idx].pending ? stages[idx].pending : stages[idx].shader;
+        if (0U == shader)
+        {
+            discardPending();
+            return;
+        }
+        glAttachShader(pendingProgram, shader);
+    }
+    glLinkProgram(pendingProgram);
+}
+
+bool ShaderReloader::finishRebuild()
+{
+    GLint status = GL_FALSE;
+
+    glGetProgramiv(pendingProgram, GL_LINK_STATUS, &status);
+    if (GL_TRUE != status)
+    {
+        for (int idx = 0; idx < RELOAD_STAGES; ++idx)
+        {
+            if (0U == stages[idx].pending)
+                continue;
+
+            glGetShaderiv(stages[idx].pending, GL_COMPILE_STATUS, &status);
+            if (GL_TRUE != status)
+            {
+                std::cerr << "Failed to compile shader: " << stages[idx].path << std::endl;
+                printLog(stages[idx].pending, false);
+            }
+        }
+        std::cerr << "Failed to link program, " << (current ? "keeping last good program" : "waiting for the files to change") << std::endl;
+        printLog(pendingProgram, true);
+        discardPending();
+        return false;
+    }
+
+    /* swap, new stages replace the old shader objects */
+    for (int idx = 0; idx < RELOAD_STAGES; ++idx)
+    {
+        ReloadStage &stage = stages[idx];
+        glDetachShader(pendingProgram, stage.pending ? stage.pending : stage.shader);
+        if (stage.pending)
+        {
+            if (stage.shader)
+                glDeleteShader(stage.shader);
+            stage.shader  = stage.pending;
+            stage.pending = 0U;
+        }
+    }
+
+    if (current)
+        glDeleteProgram(current);
+    current        = pendingProgram;
+    pendingProgram = 0U;
+    return true;
+}
+
+void ShaderReloader::discardPending()
+{
+    for (int idx = 0; idx < RELOAD_STAGES; ++idx)
+    {
+        if (stages[idx].pending)
+        {
+            glDeleteShader(stages[idx].pending);
+            stages[idx].pending = 0U;
+        }
+    }
+
+    if (pendingProgram)
+    {
+        glDeleteProgram(pendingProgram);
+        pendingProgram = 0U;
+    }
+}
+
+bool ShaderReloader::update()
+{
+    readEvents();
+
+    if (0U == pendingProgram)
+    {
+        bool dirty = false;
+        for (int idx = 0; idx < RELOAD_STAGES; ++idx)
+            dirty = dirty || stages[idx].dirty;
+        if (false == dirty)
+            return false;
+
+        startRebuild();
+        if (0U == pendingProgram)
+            return false;
+    }
+
+    /* edits arriving meanwhile stay dirty and start the next rebuild */
+    if (parallel)
+    {
+        GLint done = GL_FALSE;
+        glGetProgramiv(pendingProgram, GL_COMPLETION_STATUS_KHR, &done);
+        if (GL_TRUE != done)
+            return false;
+    }
+    return finishRebuild();
+}
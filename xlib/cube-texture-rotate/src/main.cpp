@@ -31,6 +31,8 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <math.h>
 #include "stb_image.h"
+#include "../../benchmark/benchmark.h"
+#include "../../benchmark/gldebug.h"
 
 #define GLX_MAJOR_MIN 1
 #define GLX_MINOR_MIN 2
@@ -150,8 +152,11 @@ int main()
     wm_delete_window = XInternAtom(dpy, "WM_DELETE_WINDOW", False);
     XSetWMProtocols(dpy, w, &wm_delete_window, 1);
 
+    /* debug context reporting performance warnings when GL_DEBUG is set */
+    struct DebugOutput debug;
+
     /* create opengl context */
-    ctxt = glXCreateContext(dpy, vi, nullptr, GL_TRUE);
+    ctxt = debugOutputCreateContext(&debug, dpy, vi);
     glXMakeCurrent(dpy, w, ctxt);
 
     /* initialize glew */
@@ -167,6 +172,8 @@ int main()
         return -1;
     }
 
+    debugOutputInstall(&debug);
+
     /* free XVisual as it is not required */
     XFree(vi);
     vi = nullptr;
@@ -238,6 +245,10 @@ int main()
     else { std::cout << "Failed to load texture" << std::endl; }
     stbi_image_free(data);
 
+    /* fixed workload with timing report when BENCHMARK_FRAMES is set */
+    struct Benchmark bench;
+    benchmarkInit(&bench, "cube-texture-rotate");
+
     while (!globalAbortFlag)
     {
         XEvent evt;
@@ -283,6 +294,8 @@ int main()
         }
 
         if (!shouldDraw) continue;
+        benchmarkBeginFrame(&bench);
+        benchmarkPhase(&bench, "update");
 
         static GLfloat theta = 3;
         theta += 0.01;
@@ -293,6 +306,7 @@ int main()
         glm::mat4 old = glm::rotate(Model, theta, glm::vec3(0.0, 1.0, 0.0));
         MVP  = Projection * View * old;
 
+        benchmarkPhase(&bench, "render");
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
         glUseProgram(program);
@@ -303,7 +317,10 @@ int main()
         glBindVertexArray(vertexArrayBuffer);
 
         glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, 0);
+        benchmarkPhase(&bench, "swap");
         glXSwapBuffers(dpy, w);
+        if (benchmarkEndFrame(&bench))
+            globalAbortFlag = true;
     }
 
     /* resource cleanup */
@@ -314,6 +331,7 @@ int main()
     glDeleteBuffers(1, &vertexBuffer);
     glDeleteVertexArrays(1, &vertexArrayBuffer);
     glDeleteProgram(program);
+    debugOutputReport(&debug, stderr);
     glXDestroyContext(dpy, ctxt);
     XFreeColormap(dpy, xattr.colormap);
     XDestroyWindow(dpy, w);
@@ -30,6 +30,8 @@
 #include <X11/keysymdef.h>
 #include "X11/XKBlib.h"
 #include "shader.h"
+#include "../../benchmark/benchmark.h"
+#include "../../benchmark/gldebug.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <math.h>
 
@@ -180,8 +182,11 @@ int main()
     wm_delete_window = XInternAtom(dpy, "WM_DELETE_WINDOW", False);
     XSetWMProtocols(dpy, w, &wm_delete_window, 1);
 
+    /* debug context reporting performance warnings when GL_DEBUG is set */
+    struct DebugOutput debug;
+
     /* create opengl context */
-    ctxt = glXCreateContext(dpy, vi, nullptr, GL_TRUE);
+    ctxt = debugOutputCreateContext(&debug, dpy, vi);
     glXMakeCurrent(dpy, w, ctxt);
 
     /* initialize glew */
@@ -197,6 +202,8 @@ int main()
         return -1;
     }
 
+    debugOutputInstall(&debug);
+
     /* free XVisual as it is not required */
     XFree(vi);
     vi = nullptr;
@@ -244,6 +251,10 @@ int main()
     glm::mat4 Model = glm::scale(glm::rotate(glm::mat4(1.0f), glm::radians(45.0f), glm::vec3(1.0, 0.0, 0.0)), glm::vec3(0.5, 0.5, 0.5));
     glm::mat4 MVP   = Projection * View * Model;
 
+    /* fixed workload with timing report when BENCHMARK_FRAMES is set */
+    struct Benchmark bench;
+    benchmarkInit(&bench, "cube-transform");
+
     while (!globalAbortFlag)
     {
         XEvent evt;
@@ -289,6 +300,8 @@ int main()
         }
 
         if (!shouldDraw) continue;
+        benchmarkBeginFrame(&bench);
+        benchmarkPhase(&bench, "update");
         // static GLfloat x, y = 3.0, z;
         static GLfloat theta = 3;
         theta += 0.5;
@@ -302,6 +315,7 @@ int main()
         glm::mat4 old = glm::rotate(Model, glm::radians(theta), glm::vec3(0.0, 1.0, 0.0));
         MVP  = Projection * View * old;
 
+        benchmarkPhase(&bench, "render");
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
         glUseProgram(program);
@@ -309,7 +323,10 @@ int main()
         glBindVertexArray(vertexArrayBuffer);
 
         glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, 0);
+        benchmarkPhase(&bench, "swap");
         glXSwapBuffers(dpy, w);
+        if (benchmarkEndFrame(&bench))
+            globalAbortFlag = true;
     }
 
     /* resource cleanup */
@@ -319,6 +336,7 @@ int main()
     glDeleteBuffers(1, &vertexBuffer);
     glDeleteVertexArrays(1, &vertexArrayBuffer);
     glDeleteProgram(program);
+    debugOutputReport(&debug, stderr);
     glXDestroyContext(dpy, ctxt);
     XFreeColormap(dpy, xattr.colormap);
     XDestroyWindow(dpy, w);
@@ -10,6 +10,7 @@
 #include <iostream>
 #define _USE_MATH_DEFINES
 #include "stb_image.h"
+#include "../../benchmark/benchmark.h"
 #include <math.h>
 
 /* function declaration */
@@ -123,6 +124,10 @@ int main(int argc, char *argv[])
     glXMakeCurrent(dpy, w, glCtxt);
     initialize();
 
+    /* fixed workload with timing report when BENCHMARK_FRAMES is set */
+    struct Benchmark bench;
+    benchmarkInit(&bench, "ffp/disco");
+
     shouldDraw = false;
     while (!gbAbortFlag)
     {
@@ -214,10 +219,16 @@ int main(int argc, char *argv[])
 
         if (!shouldDraw)
             continue;
+        benchmarkBeginFrame(&bench);
+        benchmarkPhase(&bench, "update");
         update();
+        benchmarkPhase(&bench, "render");
         display();
 
+        benchmarkPhase(&bench, "swap");
         glXSwapBuffers(dpy, w);
+        if (benchmarkEndFrame(&bench))
+            gbAbortFlag = true;
     }
 
     uninitialize();
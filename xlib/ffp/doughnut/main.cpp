@@ -8,6 +8,7 @@
 #include <cstdio>
 #include <cstdlib>
 #include <iostream>
+#include "../../benchmark/benchmark.h"
 #define _USE_MATH_DEFINES
 #include <math.h>
 
@@ -111,6 +112,10 @@ int main(int argc, char *argv[])
     glXMakeCurrent(dpy, w, glCtxt);
     initialize();
 
+    /* fixed workload with timing report when BENCHMARK_FRAMES is set */
+    struct Benchmark bench;
+    benchmarkInit(&bench, "ffp/doughnut");
+
     shouldDraw = false;
     while (!gbAbortFlag)
     {
@@ -202,10 +207,16 @@ int main(int argc, char *argv[])
 
         if (!shouldDraw)
             continue;
+        benchmarkBeginFrame(&bench);
+        benchmarkPhase(&bench, "update");
         update();
+        benchmarkPhase(&bench, "render");
         display();
 
+        benchmarkPhase(&bench, "swap");
         glXSwapBuffers(dpy, w);
+        if (benchmarkEndFrame(&bench))
+            gbAbortFlag = true;
     }
 
     uninitialize();
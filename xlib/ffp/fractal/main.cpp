@@ -8,6 +8,8 @@
 #define __USE_MATH_DEFINES
 #include <math.h>
 #include <stdint.h>
+#include "../../benchmark/benchmark.h"
+#include "../../benchmark/framecapture.h"
 #define MAX_ITERATIONS 500.0f
 
 const int gwidth = 2880;
@@ -123,6 +125,7 @@ Display *display;
 Window window;
 GLXContext glContext;
 XRectangle rect = {0}; // window dimentions rectangle
+struct FrameCapture capture; // frames written to FRAMECAPTURE when set
 void resize(GLsizei width, GLsizei height)
 {
     if (height <= 0)
@@ -161,6 +164,12 @@ void calculateMandleBrot()
     }
     
 }
+/* predicate for XIfEvent(), other events stay queued */
+Bool isMapNotify(Display *, XEvent *event, XPointer arg)
+{
+    return MapNotify == event->type && *(Window *)arg == event->xmap.window;
+}
+
 void createWindow()
 {
     display = XOpenDisplay(nullptr);
@@ -211,6 +220,13 @@ void createWindow()
     glMatrixMode(GL_MODELVIEW);
     glLoadIdentity();
     calculateMandleBrot();
+
+    /* the window manager may clamp the window to the screen, capture what was actually mapped */
+    XEvent            mapped;
+    XWindowAttributes attributes;
+    XIfEvent(display, &mapped, isMapNotify, (XPointer)&window);
+    XGetWindowAttributes(display, window, &attributes);
+    frameCaptureInit(&capture, attributes.width, attributes.height);
 }
 
 void renderScene()
@@ -238,6 +254,7 @@ void renderScene()
     }
     glEnd();
 
+    frameCaptureFrame(&capture);
     glXSwapBuffers(display, window);
 }
 
@@ -245,6 +262,10 @@ int main(int argc, char *argv[])
 {
     createWindow();
 
+    /* fixed workload with timing report when BENCHMARK_FRAMES is set */
+    struct Benchmark bench;
+    benchmarkInit(&bench, "ffp/fractal");
+
     while (1)
     {
         XEvent event;
@@ -266,9 +287,18 @@ int main(int argc, char *argv[])
                 }
             }
         }
-        // renderScene();
+        /* benchmark mode renders every iteration, otherwise only on Expose */
+        if (bench.enabled)
+        {
+            benchmarkBeginFrame(&bench);
+            benchmarkPhase(&bench, "render");
+            renderScene();
+            if (benchmarkEndFrame(&bench))
+                break;
+        }
     }
 
+    frameCaptureShutdown(&capture);
     glXMakeCurrent(display, None, nullptr);
     glXDestroyContext(display, glContext);
     XDestroyWindow(display, window);
@@ -15,6 +15,7 @@
 #include <cstdlib>
 
 #include "mandlebrot.h"
+#include "../../../benchmark/benchmark.h"
 
 const int gwidth  = 2880;
 const int gheight = 1740;
@@ -140,6 +141,10 @@ int main(int argc, char *argv[])
 {
     createWindow();
 
+    /* fixed workload with timing report when BENCHMARK_FRAMES is set */
+    struct Benchmark bench;
+    benchmarkInit(&bench, "ffp/mandlebrot");
+
     while (false == gbAbortFlag)
     {
         XEvent event;
@@ -187,7 +192,15 @@ int main(int argc, char *argv[])
                 }
             }
         }
-        // renderScene();
+        /* benchmark mode renders every iteration, otherwise only on Expose */
+        if (bench.enabled)
+        {
+            benchmarkBeginFrame(&bench);
+            benchmarkPhase(&bench, "render");
+            renderScene();
+            if (benchmarkEndFrame(&bench))
+                break;
+        }
     }
 
     glXMakeCurrent(display, None, nullptr);
@@ -29,6 +29,10 @@
 #include <GL/glut.h>
 #include <GL/glx.h>
 
+#include "profiler.h"
+#include "../../benchmark/benchmark.h"
+#include "../../benchmark/framecapture.h"
+
 /* function declaration */
 static void initialize();
 static void uninitialize();
@@ -57,8 +61,12 @@ GLfloat     yPos = 2.1f;
 GLfloat     zPos = 8.0f;
 
 /*--- Debug variables --- */
-GLfloat temp         = 0.0f;
-bool    bDebugToggle = false;
+GLfloat  temp         = 0.0f;
+bool     bDebugToggle = false;
+Profiler profiler; // frame timings, report on p, trace on j
+
+/* frames written to FRAMECAPTURE when set, at the initial window size */
+struct FrameCapture capture;
 
 /*--- State of effects and objects in the scene ---*/
 bool isReflectionEnabled = false;
@@ -151,6 +159,10 @@ int main(int argc, char *argv[])
     glXMakeCurrent(dpy, window, glCtxt);
     initialize();
 
+    /* fixed workload with timing report when BENCHMARK_FRAMES is set */
+    struct Benchmark bench;
+    benchmarkInit(&bench, "ffp/shadow");
+
     shouldDraw = false;
     while (!gbAbortFlag)
     {
@@ -270,6 +282,11 @@ int main(int argc, char *argv[])
                             printReport();
                             break;
                         }
+                        case XK_j:
+                        {
+                            profiler.exportTrace("shadow-trace.json");
+                            break;
+                        }
                         case XK_Escape:
                         {
                             gbAbortFlag = true;
@@ -318,10 +335,31 @@ int main(int argc, char *argv[])
 
         if (!shouldDraw)
             continue;
-        update();
-        display();
 
-        glXSwapBuffers(dpy, window);
+        profiler.beginFrame();
+        benchmarkBeginFrame(&bench);
+        {
+            PROFILE_SCOPE(profiler, "update");
+            benchmarkPhase(&bench, "update");
+            update();
+        }
+        {
+            PROFILE_SCOPE(profiler, "display");
+            benchmarkPhase(&bench, "render");
+            display();
+        }
+        {
+            PROFILE_SCOPE(profiler, "capture");
+            frameCaptureFrame(&capture);
+        }
+        {
+            PROFILE_SCOPE(profiler, "swap");
+            benchmarkPhase(&bench, "swap");
+            glXSwapBuffers(dpy, window);
+        }
+        profiler.endFrame();
+        if (benchmarkEndFrame(&bench))
+            gbAbortFlag = true;
     }
 
     uninitialize();
@@ -380,6 +418,8 @@ static void initialize()
     printf("GLSL Version: %s\n", glGetString(GL_SHADING_LANGUAGE_VERSION));
     printf("Vendor: %s\n", glGetString(GL_VENDOR));
 
+    profiler.initialize();
+    frameCaptureInit(&capture, xattr.width, xattr.height);
     resize(xattr.width, xattr.height);
     // toggleFullscreen(dpy, w);
 }
@@ -401,6 +441,8 @@ inline void disableClipping()
 
 void uninitialize()
 {
+    frameCaptureShutdown(&capture);
+    profiler.uninitialize();
     glDeleteLists(torus, 3);
     gluDeleteQuadric(pQuadric);
 }
@@ -418,6 +460,7 @@ static void display()
     /* create stencil */
     if (true == isStencilEnabled)
     {
+        PROFILE_SCOPE(profiler, "stencil");
         glDisable(GL_DEPTH_TEST);
         glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
 
@@ -435,6 +478,7 @@ static void display()
     /* draw reflection */
     if (true == isReflectionEnabled)
     {
+        PROFILE_SCOPE(profiler, "reflection pass");
         glPushMatrix();
         glScalef(1.0f, -1.0f, 1.0f);
         enableClipping();
@@ -447,10 +491,13 @@ static void display()
     }
 
     /* draw real ground */
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glCallList(torus + 1);
-    glDisable(GL_BLEND);
+    {
+        PROFILE_SCOPE(profiler, "ground");
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        glCallList(torus + 1);
+        glDisable(GL_BLEND);
+    }
 
     if (true == isStencilEnabled)
     {
@@ -460,6 +507,7 @@ static void display()
     if (true == isShadowEnabled)
     {
         /* draw shadow */
+        PROFILE_SCOPE(profiler, "shadow pass");
         glPushMatrix();
         glPushAttrib(GL_LIGHTING_BIT | GL_DEPTH_BUFFER_BIT);
         glDisable(GL_LIGHTING);
@@ -478,17 +526,20 @@ static void display()
     }
 
     /* draw original scene */
-    glLightfv(GL_LIGHT0, GL_POSITION, lightPosition);
-    glPushMatrix();
-    enableClipping();
-    drawScene(false);
-    disableClipping();
-    glPopMatrix();
+    {
+        PROFILE_SCOPE(profiler, "scene");
+        glLightfv(GL_LIGHT0, GL_POSITION, lightPosition);
+        glPushMatrix();
+        enableClipping();
+        drawScene(false);
+        disableClipping();
+        glPopMatrix();
 
-    /* ground */
-    glFrontFace(GL_CW);
-    glCallList(torus + 1);
-    glFrontFace(GL_CCW);
+        /* ground */
+        glFrontFace(GL_CW);
+        glCallList(torus + 1);
+        glFrontFace(GL_CCW);
+    }
     return;
 }
 
@@ -733,4 +784,5 @@ void setShadowMatrix(GLfloat *destMat, float *lightPos, double *plane)
 void printReport()
 {
     printf("temp: %.2f\n", temp);
+    profiler.printReport();
 }
@@ -0,0 +1,305 @@
+/**
+ * @file      profiler.cpp
+ * @brief     CPU and GPU timing of nested frame scopes with Chrome trace export
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+/* query entry points are exported by libGL, no loader in this sample */
+#define GL_GLEXT_PROTOTYPES
+#include <GL/gl.h>
+#include <GL/glext.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "profiler.h"
+
+/* monotonic CPU clock in nanoseconds */
+static uint64_t now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static bool isTimerQuerySupported()
+{
+    const char *version    = (const char *)glGetString(GL_VERSION);
+    const char *extensions = (const char *)glGetString(GL_EXTENSIONS);
+    int         major = 0, minor = 0;
+
+    if (nullptr != version && 2 == sscanf(version, "%d.%d", &major, &minor) && (major > 3 || (3 == major && minor >= 3)))
+        return true;
+    return nullptr != extensions && nullptr != strstr(extensions, "GL_ARB_timer_query");
+}
+
+Profiler::Profiler() : nRecent(0), depth(0), frameIndex(0), gpuOffset(0), hasTimer(false), inFrame(false), isTraceFull(false)
+{
+    memset(frames, 0, sizeof(frames));
+    memset(recent, 0, sizeof(recent));
+}
+
+int Profiler::initialize()
+{
+    hasTimer = isTimerQuerySupported();
+    if (!hasTimer)
+    {
+        fprintf(stderr, "[%s] timer queries not supported, profiling CPU only\n", __func__);
+        return 0;
+    }
+
+    for (Frame &frame : frames)
+    {
+        glGenQueries(PROFILER_MAX_SCOPES * 2, frame.timestamps);
+        glGenQueries(1, &frame.elapsed);
+        frame.pending = false;
+    }
+
+    /* both clocks sampled back to back, good to a few microseconds */
+    GLint64 gpuNow = 0;
+    glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+    gpuOffset = (int64_t)now() - (int64_t)gpuNow;
+    return 0;
+}
+
+void Profiler::uninitialize()
+{
+    if (hasTimer)
+    {
+        for (Frame &frame : frames)
+        {
+            glDeleteQueries(PROFILER_MAX_SCOPES * 2, frame.timestamps);
+            glDeleteQueries(1, &frame.elapsed);
+            frame.pending = false;
+        }
+    }
+    hasTimer = false;
+}
+
+void Profiler::beginFrame()
+{
+    Frame &frame = frames[frameIndex % PROFILER_FRAMES];
+
+    /* results of the frame that used this slot before */
+    if (frame.pending)
+        collect(frame);
+
+    frame.nEvents = 0;
+    depth         = 0;
+    inFrame       = true;
+    if (hasTimer)
+        glBeginQuery(GL_TIME_ELAPSED, frame.elapsed);
+}
+
+void Profiler::endFrame()
+{
+    Frame &frame = frames[frameIndex % PROFILER_FRAMES];
+
+    if (!inFrame)
+        return;
+
+    inFrame = false;
+    frameIndex++;
+    if (hasTimer)
+    {
+        glEndQuery(GL_TIME_ELAPSED);
+        frame.pending = true;
+    }
+    else
+    {
+        collect(frame);
+    }
+}
+
+int Profiler::begin(const char *name)
+{
+    Frame &frame = frames[frameIndex % PROFILER_FRAMES];
+
+    if (!inFrame || PROFILER_MAX_SCOPES <= frame.nEvents)
+        return -1;
+
+    int           scope = (int)frame.nEvents++;
+    ProfileEvent &event = frame.events[scope];
+
+    event.name     = name;
+    event.frame    = frameIndex;
+    event.depth    = depth;
+    event.gpuBegin = 0;
+    event.gpuEnd   = 0;
+    stack[depth++] = scope;
+
+    if (hasTimer)
+        glQueryCounter(frame.timestamps[scope * 2], GL_TIMESTAMP);
+    event.cpuBegin = now();
+    return scope;
+}
+
+void Profiler::end(int scope)
+{
+    Frame &frame = frames[frameIndex % PROFILER_FRAMES];
+
+    if (0 > scope || !inFrame)
+        return;
+
+    frame.events[scope].cpuEnd = now();
+    if (hasTimer)
+        glQueryCounter(frame.timestamps[scope * 2 + 1], GL_TIMESTAMP);
+
+    /* scopes close in reverse order of opening */
+    if (depth > 0 && stack[depth - 1] == scope)
+        depth--;
+}
+
+void Profiler::collect(Frame &frame)
+{
+    bool     available = hasTimer;
+    GLuint64 elapsed   = 0;
+
+    frame.pending = false;
+
+    /* never wait: a frame still not finished on the GPU keeps only CPU times */
+    for (uint32_t idx = 0; available && idx < frame.nEvents * 2; ++idx)
+    {
+        GLuint ready = GL_FALSE;
+        glGetQueryObjectuiv(frame.timestamps[idx], GL_QUERY_RESULT_AVAILABLE, &ready);
+        available = GL_TRUE == ready;
+    }
+    if (available)
+    {
+        GLuint ready = GL_FALSE;
+        glGetQueryObjectuiv(frame.elapsed, GL_QUERY_RESULT_AVAILABLE, &ready);
+        available = GL_TRUE == ready;
+    }
+
+    if (available)
+    {
+        glGetQueryObjectui64v(frame.elapsed, GL_QUERY_RESULT, &elapsed);
+        for (uint32_t idx = 0; idx < frame.nEvents; ++idx)
+        {
+            GLuint64 gpuBegin = 0, gpuEnd = 0;
+            glGetQueryObjectui64v(frame.timestamps[idx * 2], GL_QUERY_RESULT, &gpuBegin);
+            glGetQueryObjectui64v(frame.timestamps[idx * 2 + 1], GL_QUERY_RESULT, &gpuEnd);
+            frame.events[idx].gpuBegin = (uint64_t)((int64_t)gpuBegin + gpuOffset);
+            frame.events[idx].gpuEnd   = (uint64_t)((int64_t)gpuEnd + gpuOffset);
+        }
+    }
+
+    /* the report always sees the latest frames, only the trace is capped */
+    Recent &last = recent[nRecent++ % PROFILER_REPORT_FRAMES];
+    memcpy(last.events, frame.events, sizeof(ProfileEvent) * frame.nEvents);
+    last.nEvents = frame.nEvents;
+    last.gpuTime = elapsed;
+
+    if (!isTraceFull && events.size() + frame.nEvents > PROFILER_MAX_EVENTS)
+    {
+        isTraceFull = true;
+        fprintf(stderr, "[%s] trace full after %zu scopes, later frames are not exported\n", __func__, events.size());
+    }
+    if (!isTraceFull)
+        events.insert(events.end(), frame.events, frame.events + frame.nEvents);
+}
+
+void Profiler::printReport() const
+{
+    struct Total
+    {
+        const char *name;
+        uint32_t    depth;
+        uint32_t    count;
+        uint32_t    gpuCount;
+        double      cpu;
+        double      gpu;
+    };
+
+    std::vector<Total> totals;
+    uint32_t           nKept    = nRecent < PROFILER_REPORT_FRAMES ? nRecent : PROFILER_REPORT_FRAMES;
+    uint32_t           nFrames  = 0;
+    double             gpuFrame = 0.0;
+
+    /* scopes of the last frames, oldest first, matched by name in order of first appearance */
+    for (uint32_t frame = nRecent - nKept; frame < nRecent; ++frame)
+    {
+        const Recent &last = recent[frame % PROFILER_REPORT_FRAMES];
+        for (uint32_t idx = 0; idx < last.nEvents; ++idx)
+        {
+            const ProfileEvent &event = last.events[idx];
+
+            size_t total = 0;
+            while (total < totals.size() && 0 != strcmp(totals[total].name, event.name)) { ++total; }
+            if (total == totals.size())
+                totals.push_back({event.name, event.depth, 0, 0, 0.0, 0.0});
+
+            totals[total].count++;
+            totals[total].cpu += (event.cpuEnd - event.cpuBegin) * 1e-6;
+            if (event.gpuBegin)
+            {
+                totals[total].gpuCount++;
+                totals[total].gpu += (event.gpuEnd - event.gpuBegin) * 1e-6;
+            }
+        }
+
+        if (last.gpuTime)
+        {
+            gpuFrame += last.gpuTime * 1e-6;
+            nFrames++;
+        }
+    }
+
+    printf("%-28s %10s %10s\n", "scope", "cpu ms", "gpu ms");
+    for (const Total &total : totals)
+    {
+        printf("%*s%-*s %10.3f ", (int)total.depth * 2, "", 28 - (int)total.depth * 2, total.name, total.cpu / total.count);
+        if (total.gpuCount)
+            printf("%10.3f\n", total.gpu / total.gpuCount);
+        else
+            printf("%10s\n", "-");
+    }
+    if (nFrames)
+        printf("%-28s %10s %10.3f\n", "frame", "", gpuFrame / nFrames);
+}
+
+int Profiler::exportTrace(const char *path) const
+{
+    FILE *pFile = fopen(path, "w");
+    if (nullptr == pFile)
+    {
+        fprintf(stderr, "[%s] cannot write %s\n", __func__, path);
+        return -1;
+    }
+
+    /* timestamps in microseconds from the first recorded scope */
+    uint64_t base = events.empty() ? 0 : events.front().cpuBegin;
+
+    fprintf(pFile, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    fprintf(pFile, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"CPU\"}},\n");
+    fprintf(pFile, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"GPU\"}}");
+
+    for (const ProfileEvent &event : events)
+    {
+        fprintf(pFile, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"frame\":%u}}", event.name, (double)(int64_t)(event.cpuBegin - base) * 1e-3,
+                (event.cpuEnd - event.cpuBegin) * 1e-3, event.frame);
+        if (event.gpuBegin)
+        {
+            fprintf(pFile, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":2,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"frame\":%u}}", event.name, (double)(int64_t)(event.gpuBegin - base) * 1e-3,
+                    (event.gpuEnd - event.gpuBegin) * 1e-3, event.frame);
+        }
+    }
+    fprintf(pFile, "\n]}\n");
+
+    if (0 != fclose(pFile))
+    {
+        fprintf(stderr, "[%s] cannot write %s\n", __func__, path);
+        return -1;
+    }
+    printf("wrote %zu scopes to %s\n", events.size(), path);
+    return 0;
+}
@@ -0,0 +1,148 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+/**
+ * @file      profiler.h
+ * @brief     CPU and GPU timing of nested frame scopes with Chrome trace export
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <GL/gl.h>
+
+#include <stdint.h>
+#include <vector>
+
+/* scopes recorded per frame, later ones are ignored */
+#define PROFILER_MAX_SCOPES 64
+
+/* frames whose queries are in flight, results are read this many frames later */
+#define PROFILER_FRAMES 4
+
+/* completed scopes kept for the trace, recording for the trace stops when full */
+#define PROFILER_MAX_EVENTS (1 << 18)
+
+/* frames averaged by printReport() */
+#define PROFILER_REPORT_FRAMES 120
+
+/**
+ * @brief One timed scope of one frame, times in nanoseconds
+ *
+ * GPU times are on the CPU clock, shifted by the offset measured at
+ * initialize(), so both tracks line up in the trace.
+ */
+struct ProfileEvent
+{
+    const char *name; // string literal, never copied
+    uint32_t    frame;
+    uint32_t    depth;
+    uint64_t    cpuBegin;
+    uint64_t    cpuEnd;
+    uint64_t    gpuBegin; // zero when the GPU time is not known
+    uint64_t    gpuEnd;
+};
+
+/**
+ * @brief Frame profiler
+ *
+ * Every scope issues a GL_TIMESTAMP query at its start and end, so scopes
+ * nest freely, which GL_TIME_ELAPSED queries cannot. A GL_TIME_ELAPSED query
+ * spans the whole frame. Queries of a frame are read PROFILER_FRAMES frames
+ * later, when the GPU has long finished them; a frame whose results are still
+ * not available then loses its GPU times instead of stalling.
+ */
+class Profiler
+{
+  public:
+    Profiler();
+
+    /**
+     * @brief create the query ring, GPU timing is skipped without ARB_timer_query
+     */
+    int  initialize();
+    void uninitialize();
+
+    void beginFrame();
+    void endFrame();
+
+    /**
+     * @brief open a scope nested in the currently open ones
+     * @return handle for end(), -1 when the frame has no scope left
+     */
+    int  begin(const char *name);
+    void end(int scope);
+
+    /**
+     * @brief print average CPU and GPU milliseconds of every scope
+     */
+    void printReport() const;
+
+    /**
+     * @brief write recorded scopes as Chrome trace event JSON (chrome://tracing, Perfetto)
+     */
+    int exportTrace(const char *path) const;
+
+  private:
+    struct Frame
+    {
+        GLuint       timestamps[PROFILER_MAX_SCOPES * 2];
+        GLuint       elapsed;
+        ProfileEvent events[PROFILER_MAX_SCOPES];
+        uint32_t     nEvents;
+        bool         pending; // queries issued, results not read yet
+    };
+
+    /* completed frame kept for printReport() */
+    struct Recent
+    {
+        ProfileEvent events[PROFILER_MAX_SCOPES];
+        uint32_t     nEvents;
+        uint64_t     gpuTime; // nanoseconds, zero when unknown
+    };
+
+    void collect(Frame &frame);
+
+    Frame                     frames[PROFILER_FRAMES];
+    Recent                    recent[PROFILER_REPORT_FRAMES]; // ring of the last completed frames
+    uint32_t                  nRecent;                        // frames ever completed
+    std::vector<ProfileEvent> events;                         // completed scopes for the trace, in order of completion
+    int                       stack[PROFILER_MAX_SCOPES];
+    uint32_t                  depth;
+    uint32_t                  frameIndex;
+    int64_t                   gpuOffset; // CPU clock minus GPU clock
+    bool                      hasTimer;
+    bool                      inFrame;
+    bool                      isTraceFull; // PROFILER_MAX_EVENTS reached, the report keeps going
+};
+
+/**
+ * @brief Times the enclosing block
+ */
+class ProfileScope
+{
+  public:
+    ProfileScope(Profiler &profiler, const char *name) : profiler(profiler), scope(profiler.begin(name))
+    {
+    }
+
+    ~ProfileScope()
+    {
+        profiler.end(scope);
+    }
+
+  private:
+    Profiler &profiler;
+    int       scope;
+};
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b)  PROFILE_CONCAT_(a, b)
+#define PROFILE_SCOPE(profiler, name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(profiler, name)
+
+#endif
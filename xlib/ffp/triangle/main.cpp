@@ -4,6 +4,7 @@
 #include <GL/gl.h>
 #include <cstdio>
 #include <cstdlib>
+#include "../../benchmark/benchmark.h"
 
 Display *display;
 Window window;
@@ -75,6 +76,10 @@ void renderScene() {
 int main(int argc, char *argv[]) {
     createWindow();
 
+    /* fixed workload with timing report when BENCHMARK_FRAMES is set */
+    struct Benchmark bench;
+    benchmarkInit(&bench, "ffp/triangle");
+
     while (1) {
         XEvent event;
         if(XPending(display))
@@ -90,7 +95,11 @@ int main(int argc, char *argv[]) {
             break;
         }
         }
+        benchmarkBeginFrame(&bench);
+        benchmarkPhase(&bench, "render");
             renderScene();
+        if (benchmarkEndFrame(&bench))
+            break;
     }
 
     glXMakeCurrent(display, None, nullptr);
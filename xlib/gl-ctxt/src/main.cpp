@@ -25,6 +25,7 @@
 #include <GL/gl.h>
 #include <X11/keysymdef.h>
 #include "X11/XKBlib.h"
+#include "../../benchmark/benchmark.h"
 
 #define GLX_MAJOR_MIN 1
 #define GLX_MINOR_MIN 2
@@ -98,46 +99,57 @@ int main()
     XSetWMProtocols(dpy, w, &wm_delete_window, 1);
     XMapWindow(dpy, w);
 
+    /* fixed workload with timing report when BENCHMARK_FRAMES is set */
+    struct Benchmark bench;
+    benchmarkInit(&bench, "gl-ctxt");
+
     while (!globalAbortFlag)
     {
         XEvent evt;
-        XNextEvent(dpy, &evt);
-        switch (evt.type)
-        {
-        case Expose:
-        {
-            std::cout << "Expose" << std::endl;
 
-            break;
-        }
-        case ClientMessage:
+        /* benchmark mode renders back to back instead of waiting for events */
+        if (!bench.enabled || XPending(dpy))
         {
-            if (evt.xclient.data.l[0] == wm_delete_window) { globalAbortFlag = true; }
+            XNextEvent(dpy, &evt);
+            switch (evt.type)
+            {
+            case Expose:
+            {
+                std::cout << "Expose" << std::endl;
 
-            break;
-        }
-        case KeyPress:
-        {
-            KeySym sym = XkbKeycodeToKeysym(dpy, evt.xkey.keycode, 0, 0);
-            if (XK_Escape == sym) { globalAbortFlag = true; }
-            break;
-        }
-        case MapNotify:
-        {
-            std::cout << "GL Vendor: " << glGetString(GL_VENDOR) << "\n";
-            std::cout << "GL Renderer: " << glGetString(GL_RENDERER) << "\n";
-            std::cout << "GL Version: " << glGetString(GL_VERSION) << "\n";
-            std::cout << "GL Shading Language: " << glGetString(GL_SHADING_LANGUAGE_VERSION) << "\n";
-            break;
-        }
-        default:
-        {
-            std::cout << "Default event: " << evt.type << std::endl;
-            break;
-        }
+                break;
+            }
+            case ClientMessage:
+            {
+                if (evt.xclient.data.l[0] == wm_delete_window) { globalAbortFlag = true; }
+
+                break;
+            }
+            case KeyPress:
+            {
+                KeySym sym = XkbKeycodeToKeysym(dpy, evt.xkey.keycode, 0, 0);
+                if (XK_Escape == sym) { globalAbortFlag = true; }
+                break;
+            }
+            case MapNotify:
+            {
+                std::cout << "GL Vendor: " << glGetString(GL_VENDOR) << "\n";
+                std::cout << "GL Renderer: " << glGetString(GL_RENDERER) << "\n";
+                std::cout << "GL Version: " << glGetString(GL_VERSION) << "\n";
+                std::cout << "GL Shading Language: " << glGetString(GL_SHADING_LANGUAGE_VERSION) << "\n";
+                break;
+            }
+            default:
+            {
+                std::cout << "Default event: " << evt.type << std::endl;
+                break;
+            }
+            }
         }
 
         /* redraw frame */
+        benchmarkBeginFrame(&bench);
+        benchmarkPhase(&bench, "render");
         glClear(GL_COLOR_BUFFER_BIT);
         glBegin(GL_TRIANGLES);
         glColor3f(1.0f, 0.0f, 0.0f);
@@ -148,7 +160,10 @@ int main()
         glVertex3f(1.0f, -1.0f, 0.0f);
         glEnd();
 
+        benchmarkPhase(&bench, "swap");
         glXSwapBuffers(dpy, w);
+        if (benchmarkEndFrame(&bench))
+            globalAbortFlag = true;
     }
 
     /* resource cleanup */
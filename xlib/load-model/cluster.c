@@ -0,0 +1,182 @@
+/**
+ * @file      cluster.c
+ * @brief     Split a triangle list into small clusters with culling bounds
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cluster.h"
+
+/* clusters whose normals spread this far apart are never considered backfacing */
+#define CLUSTER_MIN_CONE_DOT 0.1f
+
+static void unitNormal(const struct ModelVertex *vertices, const uint32_t *tri, float n[3])
+{
+    const struct ModelVertex *a = &vertices[tri[0]], *b = &vertices[tri[1]], *c = &vertices[tri[2]];
+    float e1[3] = {b->x - a->x, b->y - a->y, b->z - a->z};
+    float e2[3] = {c->x - a->x, c->y - a->y, c->z - a->z};
+
+    n[0] = e1[1] * e2[2] - e1[2] * e2[1];
+    n[1] = e1[2] * e2[0] - e1[0] * e2[2];
+    n[2] = e1[0] * e2[1] - e1[1] * e2[0];
+
+    float length = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+    for (int axis = 0; axis < 3; ++axis)
+        n[axis] = length > 0.0f ? n[axis] / length : 0.0f;
+}
+
+/* bounding sphere around the box of the vertices, cone around the triangle normals */
+static void computeClusterBounds(const struct ModelVertex *vertices, const uint32_t *indices, struct ModelCluster *cluster)
+{
+    float lo[3] = {INFINITY, INFINITY, INFINITY};
+    float hi[3] = {-INFINITY, -INFINITY, -INFINITY};
+    float axis[3] = {0.0f, 0.0f, 0.0f};
+
+    for (uint32_t idx = 0U; idx < cluster->nIndices; ++idx)
+    {
+        const struct ModelVertex *v = &vertices[indices[idx]];
+        const float p[3] = {v->x, v->y, v->z};
+        for (int k = 0; k < 3; ++k)
+        {
+            lo[k] = p[k] < lo[k] ? p[k] : lo[k];
+            hi[k] = p[k] > hi[k] ? p[k] : hi[k];
+        }
+    }
+
+    cluster->radius = 0.0f;
+    for (int k = 0; k < 3; ++k)
+        cluster->center[k] = 0.5f * (lo[k] + hi[k]);
+
+    for (uint32_t idx = 0U; idx < cluster->nIndices; ++idx)
+    {
+        const struct ModelVertex *v = &vertices[indices[idx]];
+        float dx = v->x - cluster->center[0], dy = v->y - cluster->center[1], dz = v->z - cluster->center[2];
+        float d = sqrtf(dx * dx + dy * dy + dz * dz);
+        cluster->radius = d > cluster->radius ? d : cluster->radius;
+    }
+
+    for (uint32_t idx = 0U; idx < cluster->nIndices; idx += 3U)
+    {
+        float n[3];
+        unitNormal(vertices, &indices[idx], n);
+        for (int k = 0; k < 3; ++k)
+            axis[k] += n[k];
+    }
+
+    float length = sqrtf(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+    float minDot = length > 0.0f ? 1.0f : -1.0f;
+    for (int k = 0; k < 3; ++k)
+        cluster->coneAxis[k] = length > 0.0f ? axis[k] / length : 0.0f;
+
+    for (uint32_t idx = 0U; idx < cluster->nIndices; idx += 3U)
+    {
+        float n[3];
+        unitNormal(vertices, &indices[idx], n);
+        if (0.0f == n[0] && 0.0f == n[1] && 0.0f == n[2])
+            continue;
+
+        float d = n[0] * cluster->coneAxis[0] + n[1] * cluster->coneAxis[1] + n[2] * cluster->coneAxis[2];
+        minDot = d < minDot ? d : minDot;
+    }
+
+    /* backfacing when the view direction lies within 90 degrees minus the cone angle of the axis */
+    cluster->coneCutoff = minDot < CLUSTER_MIN_CONE_DOT ? 1.0f : sqrtf(1.0f - minDot * minDot);
+}
+
+uint32_t buildClusters(const struct ModelVertex *vertices, uint32_t nVertices, const uint32_t *indices, uint32_t nIndices, uint32_t firstIndex, struct ModelCluster *clusters, uint32_t *out)
+{
+    uint32_t  nTriangles = nIndices / 3U;
+    uint32_t *offsets    = (uint32_t *)calloc(nVertices + 1U, sizeof(uint32_t));
+    uint32_t *triangles  = (uint32_t *)malloc(sizeof(uint32_t) * nIndices);
+    uint32_t *owner      = (uint32_t *)calloc(nVertices, sizeof(uint32_t)); // cluster number + 1 that last used a vertex
+    unsigned char *emitted = (unsigned char *)calloc(nTriangles ? nTriangles : 1U, 1U);
+    uint32_t  members[CLUSTER_MAX_VERTICES];
+    uint32_t  nClusters = 0U;
+    uint32_t  nOut      = 0U;
+    uint32_t  seed      = 0U;
+
+    /* triangles around every vertex */
+    for (uint32_t idx = 0U; idx < nIndices; ++idx)
+        offsets[indices[idx] + 1U]++;
+    for (uint32_t v = 0U; v < nVertices; ++v)
+        offsets[v + 1U] += offsets[v];
+    for (uint32_t idx = 0U; idx < nIndices; ++idx)
+        triangles[offsets[indices[idx]]++] = idx / 3U;
+    for (uint32_t v = nVertices; v > 0U; --v)
+        offsets[v] = offsets[v - 1U];
+    offsets[0] = 0U;
+
+    while (nOut < nIndices)
+    {
+        struct ModelCluster *cluster = &clusters[nClusters++];
+        uint32_t nMembers = 0U;
+
+        cluster->firstIndex = firstIndex + nOut;
+        cluster->nIndices   = 0U;
+
+        while (emitted[seed])
+            seed++;
+
+        for (uint32_t next = seed; UINT32_MAX != next;)
+        {
+            /* emit triangle, its new vertices join the cluster */
+            emitted[next] = 1U;
+            for (int corner = 0; corner < 3; ++corner)
+            {
+                uint32_t v = indices[next * 3U + corner];
+                if (owner[v] != nClusters)
+                {
+                    owner[v]             = nClusters;
+                    members[nMembers++] = v;
+                }
+                out[nOut++] = v;
+            }
+            cluster->nIndices += 3U;
+
+            if (cluster->nIndices / 3U >= CLUSTER_MAX_TRIANGLES)
+                break;
+
+            /* neighbour adding the fewest vertices, keeps clusters compact */
+            uint32_t fewest = 3U;
+            next            = UINT32_MAX;
+            for (uint32_t m = 0U; m < nMembers && fewest > 0U; ++m)
+            {
+                for (uint32_t t = offsets[members[m]]; t < offsets[members[m] + 1U]; ++t)
+                {
+                    uint32_t candidate = triangles[t];
+                    if (emitted[candidate])
+                        continue;
+
+                    uint32_t added = 0U;
+                    for (int corner = 0; corner < 3; ++corner)
+                        added += owner[indices[candidate * 3U + corner]] != nClusters;
+
+                    if (added < fewest && nMembers + added <= CLUSTER_MAX_VERTICES)
+                    {
+                        fewest = added;
+                        next   = candidate;
+                    }
+                }
+            }
+        }
+
+        computeClusterBounds(vertices, &out[cluster->firstIndex - firstIndex], cluster);
+    }
+
+    free(offsets);
+    free(triangles);
+    free(owner);
+    free(emitted);
+    return nClusters;
+}
@@ -0,0 +1,41 @@
+#ifndef CLUSTER_H
+#define CLUSTER_H
+/**
+ * @file      cluster.h
+ * @brief     Split a triangle list into small clusters with culling bounds
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <stdint.h>
+
+#include "model.h"
+
+/* limits of a cluster, sized after common mesh shader outputs */
+#define CLUSTER_MAX_VERTICES  64U
+#define CLUSTER_MAX_TRIANGLES 124U
+
+/**
+ * @brief reorder triangles into clusters of neighbouring triangles
+ *
+ * Clusters are grown from a seed triangle by adding the neighbour that brings
+ * the fewest new vertices, until either limit is hit. Each cluster receives a
+ * bounding sphere and the cone bounding the normals of its triangles.
+ *
+ * @param indices    input triangle list
+ * @param nIndices   number of input indices
+ * @param firstIndex position of the output in the file, added to the cluster ranges
+ * @param clusters   receives at most nIndices / 3 clusters
+ * @param out        receives the nIndices reordered indices
+ * @return number of clusters written
+ */
+uint32_t buildClusters(const struct ModelVertex *vertices, uint32_t nVertices, const uint32_t *indices, uint32_t nIndices, uint32_t firstIndex, struct ModelCluster *clusters, uint32_t *out);
+
+#endif
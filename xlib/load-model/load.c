@@ -1,226 +1,235 @@
+#include <math.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-#define NUM_VERTICES 512
-#define LEN_FILENAME 128
+#define ASYNCLOG_IMPLEMENTATION
+#include "../benchmark/asynclog.h"
+#include "cluster.h"
+#include "material.h"
+#include "model.h"
+#include "obj.h"
+#include "simplify.h"
 
-struct Position{
-    float x;
-    float y;
-    float z;
-};
+/* coarser LODs are not worth it below this many triangles, nor when simplification stalls */
+#define LOD_MIN_TRIANGLES 8
+#define LOD_MIN_REDUCTION 0.8f
 
-struct Index
+/* center of bounding box, radius reaching the farthest vertex */
+static void computeBounds(const struct ModelVertex *vertices, uint32_t nVertices, struct ModelHeader *header)
 {
-    int v;
-    int t;
-    int n;
-};
-
-struct Texture{
-    float u;
-    float v;
-};
-
-struct Vertex{
-    float x;
-    float y;
-    float z;
-    float u;
-    float v;
-};
-
-struct Triangle{
-    struct Vertex a;
-    struct Vertex b;
-    struct Vertex c;
-};
-
-struct Header{
-    uint32_t nVertices;
-    uint32_t nIndices;
-};
+    float lo[3] = {INFINITY, INFINITY, INFINITY};
+    float hi[3] = {-INFINITY, -INFINITY, -INFINITY};
 
+    for (uint32_t idx = 0U; idx < nVertices; ++idx)
+    {
+        const float p[3] = {vertices[idx].x, vertices[idx].y, vertices[idx].z};
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            lo[axis] = p[axis] < lo[axis] ? p[axis] : lo[axis];
+            hi[axis] = p[axis] > hi[axis] ? p[axis] : hi[axis];
+        }
+    }
+
+    header->radius = 0.0f;
+    for (int axis = 0; axis < 3; ++axis)
+        header->center[axis] = nVertices ? 0.5f * (lo[axis] + hi[axis]) : 0.0f;
+
+    for (uint32_t idx = 0U; idx < nVertices; ++idx)
+    {
+        float dx = vertices[idx].x - header->center[0];
+        float dy = vertices[idx].y - header->center[1];
+        float dz = vertices[idx].z - header->center[2];
+        float d  = sqrtf(dx * dx + dy * dy + dz * dz);
+        header->radius = d > header->radius ? d : header->radius;
+    }
+}
 
 int main(int argc, char *argv[])
 {
-    /* Map for counting unique vertices */
-    // int **map = NULL;
-    FILE* pFileInput = NULL; // handle for input file
+    const char* input = "cube.obj";
+    const char* output = "cube.model";
     FILE* pFileOutput = NULL; // handle for output file
-    char buffer[128];   // buffer for reading line from input file
-
-    struct Position positions[NUM_VERTICES];
-    uint32_t nPositions = 0; // number of unique position co-ordinates
-
-    struct Texture texCoords[NUM_VERTICES];
-    uint32_t nTexCoords = 0; // number of unique texture co-ordinates
-
-    struct Index indices[NUM_VERTICES];
-    uint32_t nIndexes = 0; // number if vert
+    struct ObjMesh mesh;
 
-    struct Header header;
-    int *pOutputIndexs = NULL;
+    struct ModelHeader header;
+    struct ModelLod lods[MODEL_MAX_LODS];
+    uint32_t *pOutputIndexs = NULL;
 
-    struct Vertex *pOutputVertices = NULL;
-    int nOutputVertices = 0;
+    struct ModelVertex *pOutputVertices = NULL;
+    uint32_t nOutputVertices = 0;
 
-    if(3 != argc)
+    if(3 == argc)
     {
-        char input[128] = "cube.obj";
-        char output[128] = "cube.model";
-
-        // printf("Enter obj filenme: ");
-        // scanf("%s", input);
+        input = argv[1];
+        output = argv[2];
+    }
 
-        pFileInput = fopen(input, "r");
-        if(NULL == pFileInput)
-        {
-            printf("Failed to open input obj file: %s\n", input);
-            return EXIT_FAILURE;
-        }
+    if(0 != readObj(input, &mesh))
+        return EXIT_FAILURE;
 
-        // printf("Enter model filename: ");
-        // scanf("%s", output);
-        
-        pFileOutput = fopen(output, "wb");
-        if(NULL == pFileInput)
-        {
-            printf("Failed to open output hex file: %s\n", output);
-            fclose(pFileInput);
-            pFileInput = NULL;
-            return EXIT_FAILURE;
-        }
+    pFileOutput = fopen(output, "wb");
+    if(NULL == pFileOutput)
+    {
+        LOG_ERROR("Failed to open output model file: %s", output);
+        freeObj(&mesh);
+        return EXIT_FAILURE;
     }
-    else
+
+    LOG_INFO("File reading finished: Positions %d, Textures %d, indexes %d", mesh.nPositions, mesh.nTexCoords, mesh.nIndices);
+
+    uint32_t nIndexes = mesh.nIndices;
+    uint32_t nMaterials = mesh.nMaterials;
+    const struct ModelMaterial *materials = mesh.materials;
+    const uint32_t *faceMaterials = mesh.faceMaterials;
+
+    pOutputVertices = (struct ModelVertex *)malloc(sizeof(struct ModelVertex) * (nIndexes ? nIndexes : 1U));
+    uint32_t outputCapacity = 0U;
+    pOutputIndexs = reserve(NULL, &outputCapacity, nIndexes, sizeof(uint32_t));
+    nOutputVertices = weldVertices(&mesh, pOutputVertices, pOutputIndexs);
+    LOG_INFO("Number of unique vertices: %d, total indices: %d", nOutputVertices, nIndexes);
+
+    /* triangles sorted by material, one submesh per used material */
+    uint32_t nTriangles = nIndexes / 3U;
+    uint32_t *materialStart = (uint32_t *)calloc(nMaterials + 1U, sizeof(uint32_t));
+    uint32_t *pScratch = (uint32_t *)malloc(sizeof(uint32_t) * (nIndexes ? nIndexes : 1U));
+    for (uint32_t tri = 0U; tri < nTriangles; ++tri)
+        materialStart[faceMaterials[tri] + 1U] += 3U;
+    for (uint32_t m = 0U; m < nMaterials; ++m)
+        materialStart[m + 1U] += materialStart[m];
+    for (uint32_t tri = 0U; tri < nTriangles; ++tri)
     {
-        pFileInput = fopen(argv[1], "r");
-        if(NULL == pFileOutput)
-        {
-            printf("Failed to open input obj file: %s\n", argv[1]);
-            return EXIT_FAILURE;
-        }
+        uint32_t *slot = &materialStart[faceMaterials[tri]];
+        memcpy(pScratch + *slot, pOutputIndexs + tri * 3U, sizeof(uint32_t) * 3U);
+        *slot += 3U;
+    }
+    memcpy(pOutputIndexs, pScratch, sizeof(uint32_t) * nIndexes);
 
-        pFileOutput = fopen(argv[2], "wb");
-        if(NULL == pFileOutput)
-        {
-            printf("Failed to open output hex file: %s\n", argv[2]);
-            fclose(pFileInput);
-            pFileInput = NULL;
-            return EXIT_FAILURE;
-        }
+    /* every LOD has the submeshes of LOD 0, in the same order */
+    struct ModelSubmesh *submeshes = (struct ModelSubmesh *)malloc(sizeof(struct ModelSubmesh) * (nMaterials * MODEL_MAX_LODS));
+    uint32_t nUsed = 0U;
+    for (uint32_t m = 0U, first = 0U; m < nMaterials; first = materialStart[m++])
+    {
+        if (materialStart[m] == first)
+            continue;
+        submeshes[nUsed].material = m;
+        submeshes[nUsed].firstIndex = first;
+        submeshes[nUsed].nIndices = materialStart[m] - first;
+        submeshes[nUsed].firstCluster = 0U;
+        submeshes[nUsed].nClusters = 0U;
+        nUsed++;
     }
-    printf("Opened all files\n");
-    while (fgets(buffer, sizeof(buffer), pFileInput))
+
+    /* LOD chain, each level aims at half the triangles of the previous one */
+    header.magic = MODEL_MAGIC;
+    header.version = MODEL_VERSION;
+    header.nVertices = nOutputVertices;
+    header.nIndices = nIndexes;
+    header.nMaterials = nMaterials;
+    header.nLods = 1U;
+    header.nSubmeshes = nUsed;
+    lods[0].firstIndex = 0U;
+    lods[0].nIndices = nIndexes;
+    lods[0].error = 0.0f;
+    lods[0].firstSubmesh = 0U;
+    lods[0].nSubmeshes = nUsed;
+    computeBounds(pOutputVertices, nOutputVertices, &header);
+
+    while (header.nLods < MODEL_MAX_LODS && 0U < nUsed)
     {
-        if('v' == buffer[0])
+        const struct ModelLod *previous = &lods[header.nLods - 1U];
+        struct ModelSubmesh *next = &submeshes[header.nSubmeshes];
+        uint32_t count = 0U;
+        float error = previous->error;
+
+        if ((previous->nIndices / 6U) * 3U < LOD_MIN_TRIANGLES * 3U)
+            break;
+
+        /*
+          Materials are simplified one by one so that their borders stay
+          closed, always from the full mesh so that errors do not pile up.
+          Small ones keep the triangles of the previous LOD.
+         */
+        for (uint32_t s = 0U; s < nUsed; ++s)
         {
-            /* process vertex information */
-            if(' ' == buffer[1])
-            {
-                /* process vertex position */
-                sscanf(buffer, "v %f %f %f", &positions[nPositions].x, &positions[nPositions].y, &positions[nPositions].z);
-                nPositions++;
-            }
-            else if('t' == buffer[1])
+            const struct ModelSubmesh *full = &submeshes[s];
+            const struct ModelSubmesh *last = &submeshes[previous->firstSubmesh + s];
+            uint32_t target = (last->nIndices / 6U) * 3U;
+
+            next[s] = *last;
+            next[s].firstIndex = header.nIndices + count;
+            if (target < LOD_MIN_TRIANGLES * 3U)
             {
-                /* process texture position */
-                sscanf(buffer, "vt %f %f", &texCoords[nTexCoords].u, &texCoords[nTexCoords].v);
-                nTexCoords++;
+                memcpy(pScratch + count, pOutputIndexs + last->firstIndex, sizeof(uint32_t) * last->nIndices);
             }
-            else if('n' == buffer[1])
+            else
             {
-                /* process normal direction */
+                float submeshError = 0.0f;
+                next[s].nIndices = simplifyMesh(pOutputVertices, nOutputVertices, pOutputIndexs + full->firstIndex, full->nIndices, target, pScratch + count, &submeshError);
+                error = submeshError > error ? submeshError : error;
             }
+            count += next[s].nIndices;
         }
-        else if('f' == buffer[0])
-        {
-            /* process index information */
-            sscanf(buffer, "f %d/%d/%d %d/%d/%d %d/%d/%d", 
-                   &indices[nIndexes].v, &indices[nIndexes].t, &indices[nIndexes].n,
-                   &indices[nIndexes + 1].v, &indices[nIndexes + 1].t, &indices[nIndexes+1].n,
-                   &indices[nIndexes + 2].v, &indices[nIndexes + 2].t, &indices[nIndexes+2].n);
-
-            /* convert 1 based indeces to 0 based */
-            indices[nIndexes].v--;
-            indices[nIndexes + 1].v--;
-            indices[nIndexes + 2].v--;
-
-            indices[nIndexes].t--;
-            indices[nIndexes + 1].t--;
-            indices[nIndexes + 2].t--;
-
-            indices[nIndexes].n--;
-            indices[nIndexes + 1].n--;
-            indices[nIndexes + 2].n--;
-            nIndexes+=3;
-        }
-    }
-    /* close input file handle */
-    fclose(pFileInput);
-    pFileInput = NULL;
-
-    printf("File reading finished: Positions %d, Textures %d, indexes %d\n", nPositions, nTexCoords, nIndexes);
-    
-    header.nIndices = nIndexes;
-    pOutputIndexs = (int *)malloc(sizeof(int)*header.nIndices);
 
-    /* allocate memory for vertices and indices */
-    int (*map)[nTexCoords] = (int(*)[nTexCoords])malloc(sizeof(int)*nPositions*nTexCoords);
-    memset(map, -1, sizeof(int)*nPositions*nTexCoords); // -1 means does not exist
-    pOutputVertices = (struct Vertex *)malloc(sizeof(struct Vertex)*header.nIndices);
-    pOutputIndexs = (int *)malloc(sizeof(int)*header.nIndices);
+        if (count > previous->nIndices * LOD_MIN_REDUCTION)
+            break;
+
+        pOutputIndexs = reserve(pOutputIndexs, &outputCapacity, header.nIndices + count, sizeof(uint32_t));
+        memcpy(pOutputIndexs + header.nIndices, pScratch, sizeof(uint32_t) * count);
+        lods[header.nLods].firstIndex = header.nIndices;
+        lods[header.nLods].nIndices = count;
+        lods[header.nLods].error = error;
+        lods[header.nLods].firstSubmesh = header.nSubmeshes;
+        lods[header.nLods].nSubmeshes = nUsed;
+        header.nIndices += count;
+        header.nSubmeshes += nUsed;
+        header.nLods++;
+    }
 
-    for (uint32_t idx = 0U; idx < header.nIndices; ++idx)
+    /* every submesh is reordered into clusters that are culled on their own, at most one per triangle */
+    struct ModelCluster *clusters = (struct ModelCluster *)malloc(sizeof(struct ModelCluster) * (header.nIndices / 3U + 1U));
+    header.nClusters = 0U;
+    for (uint32_t s = 0U; s < header.nSubmeshes; ++s)
     {
-        struct Index *tempIndex = &indices[idx];
-        // printf("Index %d: %d/%d/%d\n", idx, tempIndex->v, tempIndex->t, tempIndex->n);
-        printf("index: %d -> map[%d][%d] = %d\n", idx, tempIndex->v, tempIndex->t, map[tempIndex->v][tempIndex->t]);
-        if(-1 == map[tempIndex->v][tempIndex->t])
-        {
-            printf("Creating new vertex for %d/%d at index %d\n\n", tempIndex->v, tempIndex->t, nOutputVertices);
-            /*
-              This combination of position and tex-coords is not referenced earlier,
-              so create a new vertex by combining position and texture
-             */
-            pOutputVertices[nOutputVertices].x = positions[tempIndex->v].x;
-            pOutputVertices[nOutputVertices].y = positions[tempIndex->v].y;
-            pOutputVertices[nOutputVertices].z = positions[tempIndex->v].z;
-            pOutputVertices[nOutputVertices].u = texCoords[tempIndex->t].u;
-            pOutputVertices[nOutputVertices].v = texCoords[tempIndex->t].v;
-            map[tempIndex->v][tempIndex->t] = nOutputVertices;
-            nOutputVertices++;
-        }
-        else
-        {
-            /*
-              This combination of position and tex-coords is referenced earlier and 
-              map contains its location in final pOutputVertices array.
-              Use this value as index
-             */
-            printf("vertex exits for %d/%d at index %d\n\n", tempIndex->v, tempIndex->t, map[tempIndex->v][tempIndex->t]);
-        }
+        struct ModelSubmesh *submesh = &submeshes[s];
+        submesh->firstCluster = header.nClusters;
+        submesh->nClusters = buildClusters(pOutputVertices, nOutputVertices, pOutputIndexs + submesh->firstIndex, submesh->nIndices, submesh->firstIndex, clusters + header.nClusters, pScratch);
+        memcpy(pOutputIndexs + submesh->firstIndex, pScratch, sizeof(uint32_t) * submesh->nIndices);
+        header.nClusters += submesh->nClusters;
+    }
 
+    for (uint32_t lod = 0U; lod < header.nLods; ++lod)
+    {
+        LOG_INFO("LOD %u: %u triangles, error %f", lod, lods[lod].nIndices / 3U, lods[lod].error);
+        for (uint32_t s = lods[lod].firstSubmesh; s < lods[lod].firstSubmesh + lods[lod].nSubmeshes; ++s)
+            LOG_INFO("    %s: %u triangles in %u clusters", materials[submeshes[s].material].name, submeshes[s].nIndices / 3U, submeshes[s].nClusters);
     }
-    printf("Number of unique vertices: %d, total indices: %d\n", nOutputVertices, header.nIndices);
-    header.nVertices = nOutputVertices;
 
     /* write data to file */
-    fwrite(&header, sizeof(struct Header), 1UL, pFileOutput);
-    fwrite(pOutputVertices, sizeof(struct Vertex), header.nVertices, pFileOutput);
-    fwrite(pOutputIndexs, sizeof(int), header.nIndices, pFileOutput);
-    
+    fwrite(&header, sizeof(struct ModelHeader), 1UL, pFileOutput);
+    fwrite(materials, sizeof(struct ModelMaterial), header.nMaterials, pFileOutput);
+    fwrite(lods, sizeof(struct ModelLod), header.nLods, pFileOutput);
+    fwrite(submeshes, sizeof(struct ModelSubmesh), header.nSubmeshes, pFileOutput);
+    fwrite(clusters, sizeof(struct ModelCluster), header.nClusters, pFileOutput);
+    fwrite(pOutputVertices, sizeof(struct ModelVertex), header.nVertices, pFileOutput);
+    fwrite(pOutputIndexs, sizeof(uint32_t), header.nIndices, pFileOutput);
 
     /* release memory for indeces adn verticess */
     free(pOutputVertices);
     free(pOutputIndexs);
-    free(map);
+    free(pScratch);
+    free(clusters);
+    free(submeshes);
+    free(materialStart);
+    freeObj(&mesh);
 
     /* close output file handle */
-    fclose(pFileOutput);
+    if (0 != fclose(pFileOutput))
+    {
+        LOG_ERROR("Failed to write output model file: %s", output);
+        return EXIT_FAILURE;
+    }
     pFileOutput = NULL;
     return EXIT_SUCCESS;
 }
-
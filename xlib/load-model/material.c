@@ -0,0 +1,122 @@
+/**
+ * @file      material.c
+ * @brief     Wavefront MTL parser
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../benchmark/asynclog.h"
+#include "material.h"
+
+#define LEN_LINE 512
+
+/* skip leading blanks, cut trailing blanks and line end */
+static char *trim(char *text)
+{
+    while (isspace((unsigned char)*text))
+        text++;
+
+    size_t length = strlen(text);
+    while (length > 0U && isspace((unsigned char)text[length - 1U]))
+        text[--length] = '\0';
+    return text;
+}
+
+static void copyString(char *out, size_t size, const char *text)
+{
+    snprintf(out, size, "%s", text);
+}
+
+void defaultMaterial(struct ModelMaterial *material, const char *name)
+{
+    memset(material, 0, sizeof(struct ModelMaterial));
+    copyString(material->name, sizeof(material->name), name);
+
+    /* white diffuse so that a texture shows unmodulated when Kd is missing */
+    for (int k = 0; k < 3; ++k)
+    {
+        material->ambient[k]  = 1.0f;
+        material->diffuse[k]  = 1.0f;
+        material->specular[k] = 0.5f;
+    }
+    material->shininess = 32.0f;
+    material->opacity   = 1.0f;
+}
+
+void relativePath(const char *base, const char *name, char *out, size_t size)
+{
+    const char *slash = strrchr(base, '/');
+
+    if ('/' == name[0] || NULL == slash)
+        snprintf(out, size, "%s", name);
+    else
+        snprintf(out, size, "%.*s/%s", (int)(slash - base), base, name);
+}
+
+int loadMaterials(const char *path, struct ModelMaterial **materials, uint32_t *nMaterials)
+{
+    char                  buffer[LEN_LINE];
+    struct ModelMaterial *current = NULL;
+    FILE                 *pFile   = fopen(path, "r");
+
+    if (NULL == pFile)
+    {
+        LOG_ERROR("Failed to open material file: %s", path);
+        return -1;
+    }
+
+    while (fgets(buffer, sizeof(buffer), pFile))
+    {
+        char *line = trim(buffer);
+
+        if (0 == strncmp(line, "newmtl ", 7))
+        {
+            struct ModelMaterial *grown = (struct ModelMaterial *)realloc(*materials, sizeof(struct ModelMaterial) * (*nMaterials + 1U));
+            if (NULL == grown)
+            {
+                LOG_ERROR("Out of memory");
+                fclose(pFile);
+                return -1;
+            }
+            *materials = grown;
+            current    = &grown[(*nMaterials)++];
+            defaultMaterial(current, trim(line + 7));
+        }
+        else if (NULL == current)
+        {
+            /* comments and anything before the first material */
+            continue;
+        }
+        else if (0 == strncmp(line, "Ka ", 3))
+            sscanf(line, "Ka %f %f %f", &current->ambient[0], &current->ambient[1], &current->ambient[2]);
+        else if (0 == strncmp(line, "Kd ", 3))
+            sscanf(line, "Kd %f %f %f", &current->diffuse[0], &current->diffuse[1], &current->diffuse[2]);
+        else if (0 == strncmp(line, "Ks ", 3))
+            sscanf(line, "Ks %f %f %f", &current->specular[0], &current->specular[1], &current->specular[2]);
+        else if (0 == strncmp(line, "Ke ", 3))
+            sscanf(line, "Ke %f %f %f", &current->emission[0], &current->emission[1], &current->emission[2]);
+        else if (0 == strncmp(line, "Ns ", 3))
+            sscanf(line, "Ns %f", &current->shininess);
+        else if (0 == strncmp(line, "d ", 2))
+            sscanf(line, "d %f", &current->opacity);
+        else if (0 == strncmp(line, "Tr ", 3) && 1 == sscanf(line, "Tr %f", &current->opacity))
+            current->opacity = 1.0f - current->opacity;
+        else if (0 == strncmp(line, "map_Kd ", 7))
+            relativePath(path, trim(line + 7), current->diffuseMap, sizeof(current->diffuseMap));
+    }
+
+    fclose(pFile);
+    return 0;
+}
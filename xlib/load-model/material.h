@@ -0,0 +1,42 @@
+#ifndef MATERIAL_H
+#define MATERIAL_H
+/**
+ * @file      material.h
+ * @brief     Wavefront MTL parser
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "model.h"
+
+/**
+ * @brief material used by faces before any usemtl or with an unknown name
+ */
+void defaultMaterial(struct ModelMaterial *material, const char *name);
+
+/**
+ * @brief append the newmtl blocks of an MTL file
+ *
+ * @param path       MTL file, texture paths in it are made relative to its directory
+ * @param materials  array grown with realloc
+ * @param nMaterials number of materials in the array, updated
+ * @return 0 on success, -1 when the file cannot be read
+ */
+int loadMaterials(const char *path, struct ModelMaterial **materials, uint32_t *nMaterials);
+
+/**
+ * @brief path of name relative to the directory of base, absolute names are kept
+ */
+void relativePath(const char *base, const char *name, char *out, size_t size);
+
+#endif
@@ -0,0 +1,138 @@
+#ifndef MODEL_H
+#define MODEL_H
+/**
+ * @file      model.h
+ * @brief     Binary model file written by load and read by the samples
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * File layout, every field little endian:
+ *
+ *   struct ModelHeader
+ *   struct ModelMaterial materials[nMaterials]
+ *   struct ModelLod      lods[nLods]           finest first
+ *   struct ModelSubmesh  submeshes[nSubmeshes] submeshes of all LODs back to back
+ *   struct ModelCluster  clusters[nClusters]   clusters of all submeshes back to back
+ *   struct ModelVertex   vertices[nVertices]
+ *   uint32_t             indices[nIndices]     index ranges of all LODs back to back
+ *
+ * All LODs index the same vertex array, coarser ones simply reference fewer
+ * of its vertices. The index range of every LOD is split into one submesh per
+ * material, sorted by material, and every submesh into clusters of
+ * neighbouring triangles which can be culled and drawn on their own.
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <stdint.h>
+
+#define MODEL_MAGIC   0x4c444f4dU /* "MODL" */
+#define MODEL_VERSION 3U
+
+/* 100%, 50%, 25%, ... of the triangles */
+#define MODEL_MAX_LODS 8
+
+/* fixed size strings of a material, including the terminating zero */
+#define MODEL_MAX_NAME 64
+#define MODEL_MAX_PATH 256
+
+struct ModelHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t nVertices;
+    uint32_t nIndices;
+    uint32_t nMaterials;
+    uint32_t nLods;
+    uint32_t nSubmeshes;
+    uint32_t nClusters;
+    float    center[3]; // bounding sphere of the model
+    float    radius;
+};
+
+struct ModelLod
+{
+    uint32_t firstIndex;
+    uint32_t nIndices;
+    float    error; // approximate distance of the simplified surface from the original, in model units
+    uint32_t firstSubmesh;
+    uint32_t nSubmeshes;
+};
+
+/**
+ * Parameters of a newmtl block. Relative texture paths are resolved against
+ * the MTL file when converting, blender often writes absolute ones, so
+ * loaders should fall back to the file name next to the model.
+ */
+struct ModelMaterial
+{
+    char  name[MODEL_MAX_NAME];
+    float ambient[3];  // Ka
+    float diffuse[3];  // Kd
+    float specular[3]; // Ks
+    float emission[3]; // Ke
+    float shininess;   // Ns
+    float opacity;     // d
+    char  diffuseMap[MODEL_MAX_PATH]; // map_Kd, empty without texture
+};
+
+/* triangles of one LOD using one material */
+struct ModelSubmesh
+{
+    uint32_t material;
+    uint32_t firstIndex;
+    uint32_t nIndices;
+    uint32_t firstCluster;
+    uint32_t nClusters;
+};
+
+/**
+ * All triangles of a cluster face away from an eye at e when
+ * dot(center - e, coneAxis) >= coneCutoff * |center - e| + radius,
+ * a cutoff of 1 keeps the cluster always.
+ */
+struct ModelCluster
+{
+    uint32_t firstIndex;
+    uint32_t nIndices;
+    float    center[3]; // bounding sphere of the cluster
+    float    radius;
+    float    coneAxis[3]; // mean direction of the triangle normals
+    float    coneCutoff;  // sine of the widest angle between a normal and the axis
+};
+
+struct ModelVertex
+{
+    float x;
+    float y;
+    float z;
+    float u;
+    float v;
+};
+
+/**
+ * @brief coarsest LOD whose error covers at most threshold pixels on screen
+ *
+ * @param pixelsPerUnit size in pixels of one model unit at distance 1,
+ *                      viewport height / (2 * tan(fovy / 2)) times model scale
+ * @param distance      from the eye to the nearest point of the bounding sphere
+ * @param threshold     largest acceptable error in pixels
+ */
+static inline uint32_t modelSelectLod(const struct ModelLod *lods, uint32_t nLods, float pixelsPerUnit, float distance, float threshold)
+{
+    uint32_t lod = 0U;
+
+    if (distance < 1e-3f)
+        return 0U;
+
+    while (lod + 1U < nLods && lods[lod + 1U].error * pixelsPerUnit / distance <= threshold)
+        lod++;
+    return lod;
+}
+
+#endif
@@ -0,0 +1,218 @@
+/**
+ * @file      obj.c
+ * @brief     Wavefront OBJ reader and vertex welding
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../benchmark/asynclog.h"
+#include "material.h"
+#include "obj.h"
+
+#define LEN_LINE 256
+
+void *reserve(void *array, uint32_t *capacity, uint32_t count, size_t size)
+{
+    if (count <= *capacity)
+        return array;
+
+    *capacity = *capacity ? *capacity * 2U : 64U;
+    if (*capacity < count)
+        *capacity = count;
+
+    array = realloc(array, *capacity * size);
+    if (NULL == array)
+    {
+        LOG_ERROR("Out of memory");
+        exit(EXIT_FAILURE);
+    }
+    return array;
+}
+
+int readObj(const char *path, struct ObjMesh *mesh)
+{
+    FILE* pFileInput = NULL; // handle for input file
+    char buffer[LEN_LINE];   // buffer for reading line from input file
+    uint32_t positionCapacity = 0;
+    uint32_t texCoordCapacity = 0;
+    uint32_t indexCapacity = 0;
+    uint32_t faceCapacity = 0;
+    uint32_t currentMaterial = 0U;
+
+    memset(mesh, 0, sizeof(struct ObjMesh));
+    pFileInput = fopen(path, "r");
+    if(NULL == pFileInput)
+    {
+        LOG_ERROR("Failed to open input obj file: %s", path);
+        return -1;
+    }
+
+    mesh->materials = (struct ModelMaterial *)malloc(sizeof(struct ModelMaterial));
+    mesh->nMaterials = 1U;
+    defaultMaterial(&mesh->materials[0], "default");
+    while (fgets(buffer, sizeof(buffer), pFileInput))
+    {
+        if('v' == buffer[0])
+        {
+            /* process vertex information */
+            if(' ' == buffer[1])
+            {
+                /* process vertex position */
+                struct Position *position;
+                mesh->positions = reserve(mesh->positions, &positionCapacity, mesh->nPositions + 1U, sizeof(struct Position));
+                position = &mesh->positions[mesh->nPositions++];
+                sscanf(buffer, "v %f %f %f", &position->x, &position->y, &position->z);
+            }
+            else if('t' == buffer[1])
+            {
+                /* process texture position */
+                struct Texture *texCoord;
+                mesh->texCoords = reserve(mesh->texCoords, &texCoordCapacity, mesh->nTexCoords + 1U, sizeof(struct Texture));
+                texCoord = &mesh->texCoords[mesh->nTexCoords++];
+                sscanf(buffer, "vt %f %f", &texCoord->u, &texCoord->v);
+            }
+            else if('n' == buffer[1])
+            {
+                /* process normal direction */
+            }
+        }
+        else if(0 == strncmp(buffer, "mtllib ", 7))
+        {
+            /* material library next to the obj file */
+            char name[LEN_LINE], libPath[LEN_LINE];
+            if (1 == sscanf(buffer, "mtllib %255[^\r\n]", name))
+            {
+                relativePath(path, name, libPath, sizeof(libPath));
+                loadMaterials(libPath, &mesh->materials, &mesh->nMaterials);
+            }
+        }
+        else if(0 == strncmp(buffer, "usemtl ", 7))
+        {
+            char name[LEN_LINE];
+            currentMaterial = 0U;
+            if (1 == sscanf(buffer, "usemtl %255[^\r\n]", name))
+            {
+                for (uint32_t m = 1U; m < mesh->nMaterials; ++m)
+                {
+                    if (0 == strcmp(mesh->materials[m].name, name))
+                        currentMaterial = m;
+                }
+            }
+            if (0U == currentMaterial)
+                LOG_WARN("Unknown material, using default: %.*s", (int)strcspn(buffer, "\r\n"), buffer);
+        }
+        else if('f' == buffer[0])
+        {
+            /* process index information */
+            struct Index *corners;
+            mesh->indices = reserve(mesh->indices, &indexCapacity, mesh->nIndices + 3U, sizeof(struct Index));
+            mesh->faceMaterials = reserve(mesh->faceMaterials, &faceCapacity, mesh->nIndices / 3U + 1U, sizeof(uint32_t));
+            corners = &mesh->indices[mesh->nIndices];
+            if(9 != sscanf(buffer, "f %d/%d/%d %d/%d/%d %d/%d/%d",
+                   &corners[0].v, &corners[0].t, &corners[0].n,
+                   &corners[1].v, &corners[1].t, &corners[1].n,
+                   &corners[2].v, &corners[2].t, &corners[2].n))
+            {
+                LOG_WARN("Skipping face that is not a v/t/n triangle: %.*s", (int)strcspn(buffer, "\r\n"), buffer);
+                continue;
+            }
+
+            /* convert 1 based indeces to 0 based */
+            for (uint32_t corner = 0U; corner < 3U; ++corner)
+            {
+                corners[corner].v--;
+                corners[corner].t--;
+                corners[corner].n--;
+                if (corners[corner].v < 0 || (uint32_t)corners[corner].v >= mesh->nPositions ||
+                    corners[corner].t < 0 || (uint32_t)corners[corner].t >= mesh->nTexCoords)
+                {
+                    LOG_ERROR("Face refers to undefined vertex: %.*s", (int)strcspn(buffer, "\r\n"), buffer);
+                    fclose(pFileInput);
+                    freeObj(mesh);
+                    return -1;
+                }
+            }
+            mesh->faceMaterials[mesh->nIndices / 3U] = currentMaterial;
+            mesh->nIndices+=3;
+        }
+    }
+    /* close input file handle */
+    fclose(pFileInput);
+    pFileInput = NULL;
+    return 0;
+}
+
+void freeObj(struct ObjMesh *mesh)
+{
+    free(mesh->positions);
+    free(mesh->texCoords);
+    free(mesh->indices);
+    free(mesh->faceMaterials);
+    free(mesh->materials);
+    memset(mesh, 0, sizeof(struct ObjMesh));
+}
+
+uint32_t weldVertices(const struct ObjMesh *mesh, struct ModelVertex *vertices, uint32_t *indices)
+{
+    uint32_t nVertices = 0U;
+
+    /*
+      Vertices created for a position are chained from firstVertex through
+      nextVertex.
+     */
+    int *firstVertex = (int *)malloc(sizeof(int) * (mesh->nPositions ? mesh->nPositions : 1U));
+    int *nextVertex = (int *)malloc(sizeof(int) * (mesh->nIndices ? mesh->nIndices : 1U));
+    if (NULL == firstVertex || NULL == nextVertex)
+    {
+        LOG_ERROR("Out of memory");
+        exit(EXIT_FAILURE);
+    }
+    memset(firstVertex, -1, sizeof(int) * mesh->nPositions); // -1 means does not exist
+
+    for (uint32_t idx = 0U; idx < mesh->nIndices; ++idx)
+    {
+        const struct Index *tempIndex = &mesh->indices[idx];
+        const struct Texture *texCoord = &mesh->texCoords[tempIndex->t];
+        int vertex = firstVertex[tempIndex->v];
+
+        while (-1 != vertex && (vertices[vertex].u != texCoord->u || vertices[vertex].v != texCoord->v))
+            vertex = nextVertex[vertex];
+
+        if(-1 == vertex)
+        {
+            /*
+              This combination of position and tex-coords is not referenced earlier,
+              so create a new vertex by combining position and texture
+             */
+            vertex = nVertices++;
+            vertices[vertex].x = mesh->positions[tempIndex->v].x;
+            vertices[vertex].y = mesh->positions[tempIndex->v].y;
+            vertices[vertex].z = mesh->positions[tempIndex->v].z;
+            vertices[vertex].u = texCoord->u;
+            vertices[vertex].v = texCoord->v;
+            nextVertex[vertex] = firstVertex[tempIndex->v];
+            firstVertex[tempIndex->v] = vertex;
+            LOG_DEBUG("index %u: position %d, texcoord %d -> new vertex %d", idx, tempIndex->v, tempIndex->t, vertex);
+        }
+        else
+        {
+            LOG_DEBUG("index %u: position %d, texcoord %d -> vertex %d", idx, tempIndex->v, tempIndex->t, vertex);
+        }
+        indices[idx] = vertex;
+    }
+
+    free(firstVertex);
+    free(nextVertex);
+    return nVertices;
+}
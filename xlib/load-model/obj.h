@@ -0,0 +1,88 @@
+#ifndef OBJ_H
+#define OBJ_H
+/**
+ * @file      obj.h
+ * @brief     Wavefront OBJ reader and vertex welding
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "model.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct Position
+{
+    float x;
+    float y;
+    float z;
+};
+
+struct Index
+{
+    int v;
+    int t;
+    int n;
+};
+
+struct Texture
+{
+    float u;
+    float v;
+};
+
+/**
+ * @brief Triangles of an OBJ file as written, corners index into the attribute arrays
+ */
+struct ObjMesh
+{
+    struct Position      *positions;
+    uint32_t              nPositions;
+    struct Texture       *texCoords;
+    uint32_t              nTexCoords;
+    struct Index         *indices;       // 3 per triangle, 0 based
+    uint32_t              nIndices;
+    uint32_t             *faceMaterials; // material of every triangle
+    struct ModelMaterial *materials;     // material 0 takes faces without a known usemtl
+    uint32_t              nMaterials;
+};
+
+/**
+ * @brief grow array to hold at least count elements, exits when out of memory
+ */
+void *reserve(void *array, uint32_t *capacity, uint32_t count, size_t size);
+
+/**
+ * @brief read the v/t/n triangles of an OBJ file and the materials of its mtllib
+ * @return 0 on success, -1 when the file cannot be read or refers to undefined vertices
+ */
+int readObj(const char *path, struct ObjMesh *mesh);
+
+void freeObj(struct ObjMesh *mesh);
+
+/**
+ * @brief one vertex per distinct position/tex-coord pair
+ *
+ * @param vertices receives up to mesh->nIndices vertices
+ * @param indices  receives mesh->nIndices indices into vertices
+ * @return number of vertices written
+ */
+uint32_t weldVertices(const struct ObjMesh *mesh, struct ModelVertex *vertices, uint32_t *indices);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,278 @@
+/**
+ * @file      simplify.c
+ * @brief     Triangle mesh simplification by quadric error edge collapse
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * Each vertex carries the quadric of the planes of its triangles [Garland &
+ * Heckbert], the cost of collapsing one vertex onto another is the quadric
+ * error of both at the target position. Every pass sorts all collapsible
+ * edges by cost and collapses the cheapest ones, no two of them touching the
+ * same triangle, until the target is reached or nothing is left to collapse.
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "simplify.h"
+
+/* symmetric 4x4 matrix, upper triangle, and the total area of its planes */
+struct Quadric
+{
+    double a00, a01, a02, a03;
+    double a11, a12, a13;
+    double a22, a23;
+    double a33;
+    double w;
+};
+
+struct Collapse
+{
+    uint32_t from;
+    uint32_t to;
+    double   cost;
+};
+
+static void quadricAdd(struct Quadric *q, const struct Quadric *r)
+{
+    q->a00 += r->a00, q->a01 += r->a01, q->a02 += r->a02, q->a03 += r->a03;
+    q->a11 += r->a11, q->a12 += r->a12, q->a13 += r->a13;
+    q->a22 += r->a22, q->a23 += r->a23;
+    q->a33 += r->a33;
+    q->w += r->w;
+}
+
+/* area weighted mean of squared distances to the planes of the quadric */
+static double quadricError(const struct Quadric *q, const struct ModelVertex *v)
+{
+    double x = v->x, y = v->y, z = v->z;
+    double e = q->a00 * x * x + 2.0 * q->a01 * x * y + 2.0 * q->a02 * x * z + 2.0 * q->a03 * x //
+               + q->a11 * y * y + 2.0 * q->a12 * y * z + 2.0 * q->a13 * y                     //
+               + q->a22 * z * z + 2.0 * q->a23 * z                                             //
+               + q->a33;
+    return e > 0.0 && q->w > 0.0 ? e / q->w : 0.0;
+}
+
+static void triangleNormal(const struct ModelVertex *a, const struct ModelVertex *b, const struct ModelVertex *c, double n[3])
+{
+    double e1[3] = {b->x - a->x, b->y - a->y, b->z - a->z};
+    double e2[3] = {c->x - a->x, c->y - a->y, c->z - a->z};
+
+    n[0] = e1[1] * e2[2] - e1[2] * e2[1];
+    n[1] = e1[2] * e2[0] - e1[0] * e2[2];
+    n[2] = e1[0] * e2[1] - e1[1] * e2[0];
+}
+
+static int compareEdges(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+static int compareCollapses(const void *a, const void *b)
+{
+    double x = ((const struct Collapse *)a)->cost, y = ((const struct Collapse *)b)->cost;
+    return x < y ? -1 : x > y;
+}
+
+static void computeQuadrics(const struct ModelVertex *vertices, uint32_t nVertices, const uint32_t *indices, uint32_t nIndices, struct Quadric *quadrics)
+{
+    memset(quadrics, 0, sizeof(struct Quadric) * nVertices);
+
+    for (uint32_t idx = 0U; idx < nIndices; idx += 3U)
+    {
+        double n[3];
+        triangleNormal(&vertices[indices[idx]], &vertices[indices[idx + 1U]], &vertices[indices[idx + 2U]], n);
+
+        double length = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        if (length <= 0.0)
+            continue;
+
+        /* plane ax + by + cz + d = 0 weighted by triangle area, large triangles matter more */
+        double a = n[0] / length, b = n[1] / length, c = n[2] / length;
+        double d = -(a * vertices[indices[idx]].x + b * vertices[indices[idx]].y + c * vertices[indices[idx]].z);
+        double w = 0.5 * length;
+
+        struct Quadric plane = {w * a * a, w * a * b, w * a * c, w * a * d, w * b * b, w * b * c, w * b * d, w * c * c, w * c * d, w * d * d, w};
+        for (int corner = 0; corner < 3; ++corner)
+            quadricAdd(&quadrics[indices[idx + corner]], &plane);
+    }
+}
+
+/* vertices of edges with a single triangle are borders or UV seams */
+static void lockBorders(const uint32_t *indices, uint32_t nIndices, uint64_t *edges, unsigned char *locked)
+{
+    for (uint32_t idx = 0U; idx < nIndices; ++idx)
+    {
+        uint32_t a = indices[idx];
+        uint32_t b = indices[idx % 3U == 2U ? idx - 2U : idx + 1U];
+        edges[idx] = a < b ? (uint64_t)a << 32 | b : (uint64_t)b << 32 | a;
+    }
+    qsort(edges, nIndices, sizeof(uint64_t), compareEdges);
+
+    for (uint32_t idx = 0U; idx < nIndices;)
+    {
+        uint32_t run = 1U;
+        while (idx + run < nIndices && edges[idx + run] == edges[idx])
+            run++;
+
+        /* non-manifold edges are left alone as well */
+        if (2U != run)
+        {
+            locked[edges[idx] >> 32]         = 1U;
+            locked[edges[idx] & 0xffffffffU] = 1U;
+        }
+        idx += run;
+    }
+}
+
+/* moving from onto to must not turn any remaining triangle around */
+static int isFlipping(const struct ModelVertex *vertices, const uint32_t *indices, const uint32_t *triangles, uint32_t first, uint32_t last, uint32_t from, uint32_t to)
+{
+    for (uint32_t t = first; t < last; ++t)
+    {
+        const uint32_t *tri = &indices[triangles[t] * 3U];
+        double          before[3], after[3];
+
+        if (tri[0] == to || tri[1] == to || tri[2] == to)
+            continue;
+
+        const struct ModelVertex *p[3] = {&vertices[tri[0]], &vertices[tri[1]], &vertices[tri[2]]};
+        triangleNormal(p[0], p[1], p[2], before);
+        for (int corner = 0; corner < 3; ++corner)
+        {
+            if (tri[corner] == from)
+                p[corner] = &vertices[to];
+        }
+        triangleNormal(p[0], p[1], p[2], after);
+
+        if (before[0] * after[0] + before[1] * after[1] + before[2] * after[2] <= 0.0)
+            return 1;
+    }
+    return 0;
+}
+
+uint32_t simplifyMesh(const struct ModelVertex *vertices, uint32_t nVertices, const uint32_t *indices, uint32_t nIndices, uint32_t targetIndices, uint32_t *out, float *error)
+{
+    struct Quadric  *quadrics  = (struct Quadric *)malloc(sizeof(struct Quadric) * nVertices);
+    unsigned char   *locked    = (unsigned char *)calloc(nVertices, 1U);
+    unsigned char   *touched   = (unsigned char *)malloc(nVertices);
+    uint32_t        *remap     = (uint32_t *)malloc(sizeof(uint32_t) * nVertices);
+    uint32_t        *offsets   = (uint32_t *)malloc(sizeof(uint32_t) * (nVertices + 1U));
+    uint32_t        *triangles = (uint32_t *)malloc(sizeof(uint32_t) * nIndices);
+    uint64_t        *edges     = (uint64_t *)malloc(sizeof(uint64_t) * nIndices);
+    struct Collapse *collapses = (struct Collapse *)malloc(sizeof(struct Collapse) * nIndices);
+    double           maxCost   = 0.0;
+
+    memcpy(out, indices, sizeof(uint32_t) * nIndices);
+    computeQuadrics(vertices, nVertices, indices, nIndices, quadrics);
+    lockBorders(indices, nIndices, edges, locked);
+
+    while (nIndices > targetIndices)
+    {
+        uint32_t nCollapses = 0U;
+        uint32_t nDone      = 0U;
+        uint32_t budget     = (nIndices - targetIndices) / 6U + 1U; // every collapse removes two triangles
+
+        /* candidate collapses, each interior edge in its cheaper direction */
+        for (uint32_t idx = 0U; idx < nIndices; ++idx)
+        {
+            uint32_t a = out[idx];
+            uint32_t b = out[idx % 3U == 2U ? idx - 2U : idx + 1U];
+            edges[idx] = a < b ? (uint64_t)a << 32 | b : (uint64_t)b << 32 | a;
+        }
+        qsort(edges, nIndices, sizeof(uint64_t), compareEdges);
+
+        for (uint32_t idx = 0U; idx < nIndices; ++idx)
+        {
+            uint32_t a = edges[idx] >> 32, b = edges[idx] & 0xffffffffU;
+            if ((idx > 0U && edges[idx - 1U] == edges[idx]) || (locked[a] && locked[b]))
+                continue;
+
+            struct Quadric q = quadrics[a];
+            quadricAdd(&q, &quadrics[b]);
+
+            double toB = locked[a] ? INFINITY : quadricError(&q, &vertices[b]);
+            double toA = locked[b] ? INFINITY : quadricError(&q, &vertices[a]);
+
+            collapses[nCollapses].from = toB <= toA ? a : b;
+            collapses[nCollapses].to   = toB <= toA ? b : a;
+            collapses[nCollapses].cost = toB <= toA ? toB : toA;
+            nCollapses++;
+        }
+        qsort(collapses, nCollapses, sizeof(struct Collapse), compareCollapses);
+
+        /* triangles around every vertex */
+        memset(offsets, 0, sizeof(uint32_t) * (nVertices + 1U));
+        for (uint32_t idx = 0U; idx < nIndices; ++idx)
+            offsets[out[idx] + 1U]++;
+        for (uint32_t v = 0U; v < nVertices; ++v)
+            offsets[v + 1U] += offsets[v];
+        for (uint32_t idx = 0U; idx < nIndices; ++idx)
+            triangles[offsets[out[idx]]++] = idx / 3U;
+        for (uint32_t v = nVertices; v > 0U; --v)
+            offsets[v] = offsets[v - 1U];
+        offsets[0] = 0U;
+
+        memset(touched, 0, nVertices);
+        for (uint32_t v = 0U; v < nVertices; ++v)
+            remap[v] = v;
+
+        for (uint32_t idx = 0U; idx < nCollapses && nDone < budget; ++idx)
+        {
+            const struct Collapse *c = &collapses[idx];
+            if (touched[c->from] || touched[c->to])
+                continue;
+            if (isFlipping(vertices, out, triangles, offsets[c->from], offsets[c->from + 1U], c->from, c->to))
+                continue;
+
+            /* every triangle around from changes, its vertices wait for the next pass */
+            for (uint32_t t = offsets[c->from]; t < offsets[c->from + 1U]; ++t)
+            {
+                for (int corner = 0; corner < 3; ++corner)
+                    touched[out[triangles[t] * 3U + corner]] = 1U;
+            }
+
+            remap[c->from] = c->to;
+            quadricAdd(&quadrics[c->to], &quadrics[c->from]);
+            maxCost = c->cost > maxCost ? c->cost : maxCost;
+            nDone++;
+        }
+
+        if (0U == nDone)
+            break;
+
+        /* apply collapses, triangles that lost a corner disappear */
+        uint32_t nKept = 0U;
+        for (uint32_t idx = 0U; idx < nIndices; idx += 3U)
+        {
+            uint32_t a = remap[out[idx]], b = remap[out[idx + 1U]], c = remap[out[idx + 2U]];
+            if (a == b || b == c || c == a)
+                continue;
+            out[nKept++] = a;
+            out[nKept++] = b;
+            out[nKept++] = c;
+        }
+        nIndices = nKept;
+    }
+
+    *error = (float)sqrt(maxCost);
+
+    free(quadrics);
+    free(locked);
+    free(touched);
+    free(remap);
+    free(offsets);
+    free(triangles);
+    free(edges);
+    free(collapses);
+    return nIndices;
+}
@@ -0,0 +1,39 @@
+#ifndef SIMPLIFY_H
+#define SIMPLIFY_H
+/**
+ * @file      simplify.h
+ * @brief     Triangle mesh simplification by quadric error edge collapse
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <stdint.h>
+
+#include "model.h"
+
+/**
+ * @brief reduce an indexed triangle list to about targetIndices indices
+ *
+ * Vertices are collapsed onto a neighbour, never moved, so the texture
+ * coordinates of the result are those of the input. Every vertex on an edge
+ * used by a single triangle stays in place: these are open borders and UV
+ * seams, where the same position is split into vertices with different
+ * texture coordinates. The result may therefore stay above the target.
+ *
+ * @param indices       input triangle list
+ * @param nIndices      number of input indices
+ * @param targetIndices wanted number of output indices
+ * @param out           receives at most nIndices indices
+ * @param error         receives square root of the worst collapse cost, about the distance of the result from the input surface
+ * @return number of indices written to out
+ */
+uint32_t simplifyMesh(const struct ModelVertex *vertices, uint32_t nVertices, const uint32_t *indices, uint32_t nIndices, uint32_t targetIndices, uint32_t *out, float *error);
+
+#endif
@@ -18,6 +18,8 @@
 #include <X11/keysymdef.h>
 
 #include "shader.h"
+#include "../../../benchmark/benchmark.h"
+#include "../../../benchmark/gldebug.h"
 #include <cstddef>
 #include <cstdint>
 #include <cstdio>
@@ -125,7 +127,10 @@ int main()
 
     /* make window visible */
     XMapWindow(dpy, w);
-    glCtxt = glXCreateContext(dpy, vi, nullptr, GL_TRUE);
+
+    /* debug context reporting performance warnings when GL_DEBUG is set */
+    struct DebugOutput debug;
+    glCtxt = debugOutputCreateContext(&debug, dpy, vi);
     glXMakeCurrent(dpy, w, glCtxt);
     /* initialize glew */
     glewExperimental = true;
@@ -140,9 +145,15 @@ int main()
         return -1;
     }
 
+    debugOutputInstall(&debug);
+
     initialize();
 
     shouldDraw = false;
+    /* fixed workload with timing report when BENCHMARK_FRAMES is set */
+    struct Benchmark bench;
+    benchmarkInit(&bench, "pp/01-Triangle");
+
     while (!gbAbortFlag)
     {
         XEvent event;
@@ -210,12 +221,19 @@ int main()
 
         if (!shouldDraw)
             continue;
+        benchmarkBeginFrame(&bench);
+        benchmarkPhase(&bench, "update");
         update();
+        benchmarkPhase(&bench, "render");
         display();
 
+        benchmarkPhase(&bench, "swap");
         glXSwapBuffers(dpy, w);
+        if (benchmarkEndFrame(&bench))
+            gbAbortFlag = true;
     }
 
+    debugOutputReport(&debug, stderr);
     glXMakeCurrent(dpy, None, nullptr);
     glXDestroyContext(dpy, glCtxt);
     free(vi);
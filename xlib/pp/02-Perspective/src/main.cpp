@@ -27,6 +27,8 @@
 
 #include "shader.h"
 #include "vmath.h"
+#include "../../../benchmark/benchmark.h"
+#include "../../../benchmark/gldebug.h"
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
@@ -141,7 +143,10 @@ int main()
 
     /* make window visible */
     XMapWindow(dpy, w);
-    glCtxt = glXCreateContext(dpy, vi, nullptr, GL_TRUE);
+
+    /* debug context reporting performance warnings when GL_DEBUG is set */
+    struct DebugOutput debug;
+    glCtxt = debugOutputCreateContext(&debug, dpy, vi);
     glXMakeCurrent(dpy, w, glCtxt);
     /* initialize glew */
     glewExperimental = true;
@@ -156,9 +161,15 @@ int main()
         return -1;
     }
 
+    debugOutputInstall(&debug);
+
     initialize();
 
     shouldDraw = false;
+    /* fixed workload with timing report when BENCHMARK_FRAMES is set */
+    struct Benchmark bench;
+    benchmarkInit(&bench, "pp/02-Perspective");
+
     while (!gbAbortFlag)
     {
         XEvent event;
@@ -226,12 +237,19 @@ int main()
 
         if (!shouldDraw)
             continue;
+        benchmarkBeginFrame(&bench);
+        benchmarkPhase(&bench, "update");
         update();
+        benchmarkPhase(&bench, "render");
         display();
 
+        benchmarkPhase(&bench, "swap");
         glXSwapBuffers(dpy, w);
+        if (benchmarkEndFrame(&bench))
+            gbAbortFlag = true;
     }
 
+    debugOutputReport(&debug, stderr);
     glXMakeCurrent(dpy, None, nullptr);
     glXDestroyContext(dpy, glCtxt);
     free(vi);
@@ -0,0 +1,11 @@
+#version 330 core
+
+in vec4 color;
+
+// Ouput data
+out vec4 fragColor;
+
+void main()
+{
+    fragColor = color;
+}
@@ -0,0 +1,21 @@
+#version 330 core
+
+// Minimal program drawn while the scene program is still compiling
+
+layout(location = 0) in vec3 vertexPosition_modelspace;
+layout(location = 2) in vec4 instanceDiffuse;
+layout(location = 3) in vec4 instanceEmission;
+layout(location = 4) in mat4 instanceModel;
+
+#include "passdata.glsl"
+
+out vec4 color;
+
+void main()
+{
+    vec4 worldPosition = instanceModel * vec4(vertexPosition_modelspace, 1.0);
+
+    gl_ClipDistance[0] = dot(worldPosition, uClipPlane);
+    gl_Position        = uProjection * uView * uPre * worldPosition;
+    color              = instanceDiffuse + instanceEmission;
+}
@@ -0,0 +1,36 @@
+#version 330 core
+
+in vec3 viewPosition;
+in vec3 viewNormal;
+in vec3 viewLight;
+in vec4 diffuse;
+in vec4 emission;
+in vec3 texCoord;
+
+// Scene texture pool, the render queue binds it to unit 0 which is where samplers point by default
+uniform sampler2DArray uTextures;
+
+// Ouput data
+out vec4 color;
+
+const vec3  lightAmbient  = vec3(0.3);
+const vec3  lightSpecular = vec3(1.0);
+const float shininess     = 128.0;
+
+void main()
+{
+#ifdef SHADOW
+    // projected onto the ground, lighting is not needed
+    color = vec4(0.0, 0.0, 0.0, 1.0);
+#else
+    vec3  N       = normalize(viewNormal);
+    vec3  L       = normalize(viewLight - viewPosition);
+    vec3  H       = normalize(L - normalize(viewPosition));
+    float lambert = max(dot(N, L), 0.0);
+    float phong   = lambert > 0.0 ? pow(max(dot(N, H), 0.0), shininess) : 0.0;
+    vec4  albedo  = texture(uTextures, texCoord);
+
+    color.rgb = (lightAmbient * diffuse.rgb + lambert * diffuse.rgb + emission.rgb) * albedo.rgb + phong * lightSpecular;
+    color.a   = diffuse.a * albedo.a;
+#endif
+}
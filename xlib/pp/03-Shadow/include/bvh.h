@@ -0,0 +1,104 @@
+#ifndef BVH_H
+#define BVH_H
+/**
+ * @file      bvh.h
+ * @brief     Bounding volume hierarchy for frustum culling
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include "frustum.h"
+#include "vmath.h"
+#include <cstdint>
+#include <vector>
+
+/* objects per leaf */
+#define BVH_LEAF_SIZE 4
+
+/* deepest traversal supported, a median split tree of 2^32 objects is 32 deep */
+#define BVH_MAX_DEPTH 64
+
+/**
+ * @brief Per-frame culling counters
+ */
+struct CullStats
+{
+    uint32_t objects;      // objects in the hierarchy
+    uint32_t visible;      // objects that passed
+    uint32_t culled;       // objects rejected
+    uint32_t nodesVisited; // nodes tested against frusta
+};
+
+/**
+ * @brief Box of an object range, children are adjacent so only the left one is stored
+ */
+struct BvhNode
+{
+    float    min[3];
+    float    max[3];
+    uint32_t left;  // index of first child, 0 for leaves
+    uint32_t first; // first entry of subtree in object index list
+    uint32_t count; // number of objects in subtree
+};
+
+/**
+ * @brief Binary tree of axis aligned boxes over bounding spheres
+ *
+ * Objects are bounding spheres (x, y, z, radius) owned by the caller and
+ * addressed by their index. build() splits at the median of the longest axis,
+ * refit() keeps the topology and only grows or shrinks the boxes, which is
+ * enough for objects that move a little every frame. When refitting has
+ * loosened the boxes too much refit() asks for a rebuild.
+ *
+ * A subtree that is completely inside a frustum is accepted without testing
+ * its objects, one that is completely outside is rejected as a whole.
+ */
+class Bvh
+{
+  public:
+    Bvh();
+
+    void build(const vmath::vec4 *spheres, uint32_t count);
+
+    /**
+     * @brief update boxes bottom up after objects moved, count must not change
+     *
+     * @return true when the tree degraded and should be rebuilt
+     */
+    bool refit(const vmath::vec4 *spheres);
+
+    /**
+     * @brief collect objects visible in at least one of the frusta
+     *
+     * @param frusta  clip volumes, an object is kept if any of them sees it
+     * @param nFrusta number of frusta
+     * @param spheres bounds the tree was built or refitted with
+     * @param visible receives indices of visible objects, cleared first
+     * @param stats   counters accumulated into, may be nullptr
+     */
+    void cull(const Frustum *frusta, uint32_t nFrusta, const vmath::vec4 *spheres, std::vector<uint32_t> &visible, CullStats *stats) const;
+
+    uint32_t objectCount() const
+    {
+        return nObjects;
+    }
+
+  private:
+    uint32_t buildNode(uint32_t nodeIndex, const vmath::vec4 *spheres, uint32_t first, uint32_t count, uint32_t depth);
+    void     fitLeaf(BvhNode &node, const vmath::vec4 *spheres) const;
+    float    surfaceArea() const;
+
+    std::vector<BvhNode>  nodes;
+    std::vector<uint32_t> indices;   // object indices, every node covers a contiguous range
+    uint32_t              nObjects;
+    float                 builtArea; // sum of node surface areas right after build
+};
+
+#endif
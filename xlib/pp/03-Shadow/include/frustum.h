@@ -0,0 +1,59 @@
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+/**
+ * @file      frustum.h
+ * @brief     View frustum planes and visibility tests
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include "vmath.h"
+
+/* six planes padded to two groups of four, padding planes accept everything */
+#define FRUSTUM_PLANES 8
+
+enum FrustumResult
+{
+    FRUSTUM_OUTSIDE = 0,
+    FRUSTUM_INTERSECT,
+    FRUSTUM_INSIDE
+};
+
+/**
+ * @brief Planes of a clip volume, stored plane component wise for SIMD tests
+ *
+ * Planes point inwards, a point p is inside when a*x + b*y + c*z + d >= 0 for
+ * every plane. Four planes are tested per SSE instruction, a scalar fallback is
+ * used where SSE is not available.
+ */
+struct Frustum
+{
+    alignas(16) float a[FRUSTUM_PLANES];
+    alignas(16) float b[FRUSTUM_PLANES];
+    alignas(16) float c[FRUSTUM_PLANES];
+    alignas(16) float d[FRUSTUM_PLANES];
+
+    /**
+     * @brief extract planes from a column major clip matrix
+     *
+     * Passing projection * view gives world space planes, appending a model or
+     * pre-transform gives planes in the space before that transform.
+     */
+    void extract(const vmath::mat4 &clip);
+
+    /**
+     * @return false only when the sphere is completely outside
+     */
+    bool testSphere(float x, float y, float z, float radius) const;
+
+    FrustumResult testAabb(const float min[3], const float max[3]) const;
+};
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef IMMEDIATE_H
+#define IMMEDIATE_H
+/**
+ * @file      immediate.h
+ * @brief     Capture of immediate mode geometry into vertex buffers
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <GL/glew.h>
+
+#include "instancing.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Records glBegin()/glEnd() style geometry and replays it from a VBO
+ *
+ * Legacy drawing code keeps its shape, only the gl prefix changes:
+ *
+ *     batch.reset();
+ *     batch.begin(GL_QUAD_STRIP);
+ *     batch.normal3f(nx, ny, nz);
+ *     batch.vertex3f(x, y, z);
+ *     batch.end();
+ *     batch.compile(mesh);
+ *
+ * Primitives are converted to triangles in a CPU staging area, identical
+ * vertices are merged and the result is indexed. compile() hashes the final
+ * vertex and index data and skips the upload when it matches what the target
+ * mesh already holds, so recording the same geometry every frame costs no bus
+ * traffic.
+ *
+ * Supported modes are GL_TRIANGLES, GL_TRIANGLE_STRIP, GL_TRIANGLE_FAN,
+ * GL_QUADS, GL_QUAD_STRIP and GL_POLYGON.
+ */
+class ImmediateBatch
+{
+  public:
+    ImmediateBatch();
+
+    /**
+     * @brief discard recorded geometry, allocations are kept for the next recording
+     */
+    void reset();
+
+    void begin(GLenum mode);
+    void normal3f(GLfloat x, GLfloat y, GLfloat z);
+    void texCoord2f(GLfloat u, GLfloat v);
+    void vertex3f(GLfloat x, GLfloat y, GLfloat z);
+    void end();
+
+    /**
+     * @brief upload recorded geometry into mesh unless it is unchanged
+     *
+     * @param mesh destination mesh, initialized on first upload
+     * @return 1 when data was uploaded, 0 when upload was skipped, -1 on error
+     */
+    int compile(InstancedMesh &mesh);
+
+    GLsizei vertexCount() const
+    {
+        return vertices.size();
+    }
+
+    GLsizei indexCount() const
+    {
+        return indices.size();
+    }
+
+  private:
+    void emit(GLuint a, GLuint b, GLuint c);
+
+    /* state of the current primitive */
+    GLenum                  mode;
+    bool                    inside;
+    MeshVertex              current;
+    std::vector<MeshVertex> primitive;
+
+    /* deduplicated and indexed output */
+    std::vector<MeshVertex> vertices;
+    std::vector<GLuint>     indices;
+    std::vector<GLuint>     buckets; // open addressing table of indices into vertices, ~0U marks empty slot
+};
+
+#endif
@@ -0,0 +1,160 @@
+#ifndef INSTANCING_H
+#define INSTANCING_H
+/**
+ * @file      instancing.h
+ * @brief     Instanced mesh rendering
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <GL/glew.h>
+
+#include "ringbuffer.h"
+#include "statecache.h"
+#include "vmath.h"
+#include <cstdint>
+#include <vector>
+
+/* vertex attribute locations shared with vertex.glsl */
+#define ATTRIB_POSITION 0
+#define ATTRIB_NORMAL   1
+#define ATTRIB_DIFFUSE  2
+#define ATTRIB_EMISSION 3
+#define ATTRIB_MODEL    4 // occupies 4 consecutive locations, one per column
+#define ATTRIB_TEXCOORD 8
+#define ATTRIB_LAYER    9
+
+/**
+ * @brief Vertex of a lit mesh
+ */
+struct MeshVertex
+{
+    GLfloat position[3];
+    GLfloat normal[3];
+    GLfloat texcoord[2];
+};
+
+/**
+ * @brief Per-instance data, streamed into the instance buffer
+ */
+struct Instance
+{
+    /**
+     * @brief object to world transformation
+     */
+    vmath::mat4 model;
+
+    /**
+     * @brief diffuse color of material, alpha is used for blending
+     */
+    vmath::vec4 diffuse;
+
+    /**
+     * @brief emissive color of material
+     */
+    vmath::vec4 emission;
+
+    /**
+     * @brief layer of the scene texture pool tinting diffuse and emission, 0 is plain white
+     */
+    GLfloat layer;
+};
+
+/**
+ * @brief Indexed mesh drawn once per frame for any number of instances
+ *
+ * Geometry is uploaded once, the instance buffer is re-specified whenever the
+ * instance list changes. Every call to draw() issues exactly one
+ * glDrawElementsInstanced() regardless of the number of instances.
+ */
+class InstancedMesh
+{
+  public:
+    /**
+     * @param owner tag of the mesh in the resource registry, not copied
+     */
+    explicit InstancedMesh(const char *owner = "mesh");
+
+    /**
+     * @brief upload geometry and create the vertex array object
+     *
+     * Calling it again on an initialized mesh re-specifies the geometry and
+     * keeps the vertex array object and instance data.
+     *
+     * @param vertices  pointer to interleaved vertices
+     * @param nVertices number of vertices
+     * @param indices   pointer to triangle indices
+     * @param nIndices  number of indices
+     * @param hash      hash of vertices and indices, 0 when not known
+     * @return 0 on success, -1 otherwise
+     */
+    int initialize(const MeshVertex *vertices, GLsizei nVertices, const GLuint *indices, GLsizei nIndices, uint64_t hash = 0ULL);
+
+    /**
+     * @brief replace instance data kept in the mesh's own buffer
+     *
+     * Meant for instances that rarely change, the buffer is re-specified on
+     * every call. Per-frame data goes through streamInstances().
+     */
+    void setInstances(const Instance *instances, GLsizei count);
+
+    /**
+     * @brief reserve room for this frame's instances in a stream buffer
+     *
+     * Instance attributes are pointed at the allocation, the caller fills in
+     * the returned array before the frame is submitted.
+     *
+     * @return array of count instances to write, nullptr on failure
+     */
+    Instance *streamInstances(StreamBuffer &ring, GLsizei count);
+
+    /**
+     * @brief draw all instances with one draw call
+     *
+     * The vertex array object is bound through state and left bound.
+     *
+     * @return number of draw calls issued [0 or 1]
+     */
+    GLuint draw(StateCache &state) const;
+
+    void uninitialize();
+
+    GLsizei instanceCount() const
+    {
+        return nInstances;
+    }
+
+    /**
+     * @brief hash passed to initialize() for the resident geometry, 0 when not known
+     */
+    uint64_t geometryHash() const
+    {
+        return hash;
+    }
+
+  private:
+    void pointInstanceAttributes(GLuint buffer, GLintptr offset);
+
+    GLuint      vao;
+    GLuint      vertexBuffer;
+    GLuint      indexBuffer;
+    GLuint      instanceBuffer;
+    GLsizei     nIndices;
+    GLsizei     nInstances;
+    GLsizei     capacity;
+    GLuint      instanceSource; // buffer instance attributes currently read from
+    uint64_t    hash;           // of the resident geometry
+    const char *owner;
+};
+
+/* procedural meshes */
+void generateSphere(std::vector<MeshVertex> &vertices, std::vector<GLuint> &indices, GLfloat radius, GLint slices, GLint stacks);
+
+#endif
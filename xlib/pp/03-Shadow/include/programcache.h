@@ -0,0 +1,95 @@
+#ifndef PROGRAMCACHE_H
+#define PROGRAMCACHE_H
+/**
+ * @file      programcache.h
+ * @brief     On-disk cache of linked program binaries
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <GL/glew.h>
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Counters of one run, compile times let cold and warm starts be compared
+ */
+struct ProgramCacheStats
+{
+    uint32_t hits;      // programs created from a stored binary
+    uint32_t misses;    // programs compiled from source
+    uint32_t rejected;  // stored binaries the driver refused
+    double   loadMs;    // time spent in glProgramBinary for hits
+    double   compileMs; // time spent compiling and linking misses
+    double   coldMs;    // compile time recorded when the hit binaries were stored
+};
+
+/**
+ * @brief Stores glGetProgramBinary() output keyed by source and driver hash
+ *
+ * The key covers the shader sources together with the vendor, renderer and
+ * version strings, a driver update or a shader edit therefore simply misses
+ * and the program is compiled and stored again. A binary the driver refuses
+ * is deleted and treated as a miss.
+ *
+ * Files are written to a temporary name and renamed so that a crash never
+ * leaves a truncated entry behind.
+ */
+class ProgramCache
+{
+  public:
+    ProgramCache();
+
+    /**
+     * @brief create cache directory and capture driver identity
+     *
+     * Needs a current context. Without any program binary format the cache
+     * stays disabled and every lookup misses.
+     *
+     * @return 0 on success, -1 when caching is not possible
+     */
+    int initialize(const char *directory);
+
+    /**
+     * @brief key of a program built from these stages, in order
+     */
+    uint64_t key(const std::string *sources, uint32_t nSources) const;
+
+    /**
+     * @brief create program from a stored binary
+     *
+     * @return program on hit, 0 on miss
+     */
+    GLuint load(uint64_t key);
+
+    /**
+     * @brief store a program linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+     *
+     * @param compileMs time taken to build it from source, reported on later hits
+     */
+    void store(uint64_t key, GLuint program, double compileMs);
+
+    bool enabled() const
+    {
+        return isEnabled;
+    }
+
+    ProgramCacheStats stats;
+
+  private:
+    std::string path(uint64_t key) const;
+
+    std::string directory;
+    std::string driver; // vendor, renderer and version strings
+    bool        isEnabled;
+};
+
+#endif
@@ -0,0 +1,137 @@
+#ifndef RENDERQUEUE_H
+#define RENDERQUEUE_H
+/**
+ * @file      renderqueue.h
+ * @brief     Sorted queue of draw packets
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <GL/glew.h>
+
+#include "instancing.h"
+#include "statecache.h"
+#include <cstdint>
+#include <vector>
+
+/*
+ * Layout of the 64 bit sort key, most significant bits first. Sorting the keys
+ * groups packets by pass, then by program, material and mesh so that each of
+ * them changes as rarely as possible.
+ *
+ *  63    60 59      52 51        40 39            24 23            0
+ * +--------+----------+------------+----------------+---------------+
+ * |  pass  | program  |  material  |      mesh      |     depth     |
+ * +--------+----------+------------+----------------+---------------+
+ */
+#define KEY_PASS_BITS     4
+#define KEY_PROGRAM_BITS  8
+#define KEY_MATERIAL_BITS 12
+#define KEY_MESH_BITS     16
+#define KEY_DEPTH_BITS    24
+
+#define KEY_DEPTH_SHIFT    0
+#define KEY_MESH_SHIFT     (KEY_DEPTH_SHIFT + KEY_DEPTH_BITS)
+#define KEY_MATERIAL_SHIFT (KEY_MESH_SHIFT + KEY_MESH_BITS)
+#define KEY_PROGRAM_SHIFT  (KEY_MATERIAL_SHIFT + KEY_MATERIAL_BITS)
+#define KEY_PASS_SHIFT     (KEY_PROGRAM_SHIFT + KEY_PROGRAM_BITS)
+
+#define MAX_PASSES    (1U << KEY_PASS_BITS)
+#define MAX_PROGRAMS  (1U << KEY_PROGRAM_BITS)
+#define MAX_MATERIALS (1U << KEY_MATERIAL_BITS)
+
+/**
+ * @brief Texture bound to unit 0 for a material
+ */
+struct Material
+{
+    GLenum target;
+    GLuint texture;
+};
+
+/**
+ * @brief One draw, the key identifies everything that has to be bound for it
+ */
+struct DrawPacket
+{
+    uint64_t             key;
+    const InstancedMesh *mesh;
+};
+
+/**
+ * @brief Render state of a pass, applied when the queue enters or leaves it
+ */
+struct RenderPass
+{
+    void (*begin)(StateCache &state);
+    void (*end)(StateCache &state);
+    bool backToFront; // sort translucent packets far to near
+};
+
+/**
+ * @brief Collects draw packets during a frame, sorts and executes them on flush
+ *
+ * Programs and materials are registered once and referenced by small ids that
+ * fit in the key. Material 0 means untextured. A pass is only entered when at
+ * least one packet was submitted to it.
+ */
+class RenderQueue
+{
+  public:
+    RenderQueue();
+
+    /**
+     * @return id of program to use with submit()
+     */
+    uint32_t addProgram(GLuint program);
+
+    /**
+     * @brief point a program id at another program, e.g. once it finished compiling
+     */
+    void setProgram(uint32_t id, GLuint program);
+
+    /**
+     * @param target GL_TEXTURE_2D, or GL_TEXTURE_2D_ARRAY for a texture pool shared by many meshes
+     * @return id of material to use with submit()
+     */
+    uint32_t addMaterial(GLuint texture, GLenum target = GL_TEXTURE_2D);
+
+    void setPass(uint32_t pass, const RenderPass &renderPass);
+
+    /**
+     * @brief queue a draw of all instances of mesh
+     *
+     * @param pass     pass index, lower passes execute first
+     * @param program  id returned by addProgram()
+     * @param material id returned by addMaterial() or 0
+     * @param meshId   id grouping packets of same mesh
+     * @param depth    normalized view depth [0, 1]
+     * @param mesh     mesh to draw
+     */
+    void submit(uint32_t pass, uint32_t program, uint32_t material, uint32_t meshId, float depth, const InstancedMesh *mesh);
+
+    /**
+     * @brief sort queued packets, issue them through state and empty the queue
+     */
+    void flush(StateCache &state);
+
+    static uint64_t makeKey(uint32_t pass, uint32_t program, uint32_t material, uint32_t meshId, uint32_t depth);
+
+  private:
+    void sort();
+
+    std::vector<DrawPacket> packets;
+    std::vector<DrawPacket> scratch;
+    std::vector<GLuint>     programs;
+    std::vector<Material>   materials;
+    RenderPass              passes[MAX_PASSES];
+};
+
+#endif
@@ -0,0 +1,154 @@
+#ifndef RESOURCEREGISTRY_H
+#define RESOURCEREGISTRY_H
+/**
+ * @file      resourceregistry.h
+ * @brief     Bookkeeping of GPU memory held by buffers and textures
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <GL/glew.h>
+
+#include <cstdio>
+#include <vector>
+
+enum ResourceCategory
+{
+    RESOURCE_VERTEX,   // per-vertex attributes
+    RESOURCE_INDEX,    // element arrays
+    RESOURCE_INSTANCE, // per-instance attributes kept by a mesh
+    RESOURCE_STREAM,   // persistently mapped per-frame data
+    RESOURCE_TEXTURE,  // sampled images
+    RESOURCE_CATEGORIES
+};
+
+/**
+ * @brief one live buffer or texture
+ */
+struct ResourceRecord
+{
+    GLenum           kind;     // GL_BUFFER or GL_TEXTURE
+    GLuint           name;
+    ResourceCategory category;
+    const char      *owner;    // tag of the object holding it, not copied
+    GLenum           format;   // internal format of textures, 0 for buffers
+    GLsizei          width;    // textures only
+    GLsizei          height;   // textures only
+    GLsizei          layers;   // textures only, 1 unless an array texture
+    GLint            levels;   // textures only, allocated mip levels
+    GLsizeiptr       bytes;
+};
+
+/**
+ * @brief Records every buffer and texture allocation with its size and owner
+ *
+ * Modules report storage right after specifying it and release it right
+ * before deleting the object, the registry never calls GL itself. Sizes are
+ * what the application asked for, drivers add padding and alignment on top.
+ *
+ * Re-specifying a tracked object replaces its record, so buffers that grow
+ * are followed without a release in between. Whatever is still tracked at
+ * shutdown was not deleted by its owner and is reported as a leak.
+ *
+ * A budget of 0 disables the budget check. Crossing the budget prints one
+ * warning, the next warning comes after usage dropped below it again.
+ */
+class ResourceRegistry
+{
+  public:
+    ResourceRegistry();
+
+    /**
+     * @brief bytes of GPU memory the application intends to stay within, 0 for none
+     */
+    void setBudget(GLsizeiptr bytes);
+
+    /**
+     * @brief record the data store of a buffer after glBufferData() or glBufferStorage()
+     */
+    void trackBuffer(GLuint name, ResourceCategory category, const char *owner, GLsizeiptr bytes);
+
+    /**
+     * @brief record the storage of a texture after all its levels are specified
+     *
+     * @param layers depth or array layers, 1 for 2D textures
+     * @param levels mip levels allocated, starting at width x height
+     */
+    void trackTexture(GLuint name, ResourceCategory category, const char *owner, GLenum format, GLsizei width, GLsizei height, GLsizei layers, GLint levels);
+
+    /**
+     * @brief forget an object, to be called before deleting it
+     *
+     * @param kind GL_BUFFER or GL_TEXTURE
+     */
+    void release(GLenum kind, GLuint name);
+
+    /**
+     * @brief one line with live and peak usage, budget and the breakdown by category
+     */
+    void printSummary(FILE *pFile) const;
+
+    /**
+     * @brief every live object with its size and owner
+     */
+    void printRecords(FILE *pFile) const;
+
+    /**
+     * @brief report objects still tracked, meant to be called after all owners are uninitialized
+     *
+     * @return number of leaked objects
+     */
+    size_t reportLeaks(FILE *pFile) const;
+
+    /**
+     * @brief size of a mip chain, level 0 is width x height x layers
+     */
+    static GLsizeiptr textureBytes(GLenum format, GLsizei width, GLsizei height, GLsizei layers, GLint levels);
+
+    static const char *categoryName(ResourceCategory category);
+
+    GLsizeiptr liveBytes() const
+    {
+        return live;
+    }
+
+    GLsizeiptr peakBytes() const
+    {
+        return peak;
+    }
+
+    GLsizeiptr categoryBytes(ResourceCategory category) const
+    {
+        return perCategory[category];
+    }
+
+    size_t liveCount() const
+    {
+        return records.size();
+    }
+
+  private:
+    void add(const ResourceRecord &record);
+    void remove(size_t idx);
+    void checkBudget();
+
+    /* a few dozen objects at most, a linear search is cheaper than a map */
+    std::vector<ResourceRecord> records;
+    GLsizeiptr                  perCategory[RESOURCE_CATEGORIES];
+    GLsizeiptr                  live;
+    GLsizeiptr                  peak;
+    GLsizeiptr                  budget;
+    bool                        isOverBudget;
+};
+
+/* registry of the running sample, shared by every module that allocates GPU memory */
+extern ResourceRegistry resourceRegistry;
+
+#endif
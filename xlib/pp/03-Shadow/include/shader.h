@@ -0,0 +1,35 @@
+#ifndef SHADER_H
+#define SHADER_H
+/**
+ * @file      shader.h
+ * @brief     shader compilation
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2023-12-19
+ * @copyright Copyright 2023 Rohit Nimkar
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <GL/glew.h>
+
+#include "programcache.h"
+#include <string>
+
+/**
+ * @brief build program from a vertex and a fragment shader file
+ *
+ * With a cache the program is created from a stored binary when the sources
+ * and driver match, otherwise it is compiled, linked and stored.
+ */
+GLuint LoadShaders(const char* vertex_file_path, const char* fragment_file_path, GLuint* program, ProgramCache* cache = nullptr);
+
+GLint loadShader(GLuint shaderId, const char* pFilename);
+
+bool readShaderSource(const char* pFilename, std::string& source);
+
+GLint compileShader(GLuint shaderId, const std::string& source, const char* pName);
+#endif
@@ -0,0 +1,129 @@
+#ifndef SHADERMANAGER_H
+#define SHADERMANAGER_H
+/**
+ * @file      shadermanager.h
+ * @brief     Asynchronous program compilation
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <GL/glew.h>
+
+#include "programcache.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum ProgramState
+{
+    PROGRAM_PENDING = 0, // compile and link submitted, driver still working
+    PROGRAM_READY,
+    PROGRAM_FAILED
+};
+
+/**
+ * @brief Program submitted to the manager
+ */
+struct ProgramRequest
+{
+    std::string  files[2];   // vertex and fragment shader names, for messages
+    GLuint       shaders[2]; // released once the program is linked
+    GLuint       program;
+    GLuint       fallback;   // handed out while program is not ready
+    ProgramState state;
+    uint64_t     key;        // program cache key
+    double       submitted;  // timestamp of submit() in milliseconds
+    double       readyMs;    // time from submit to ready
+};
+
+/**
+ * @brief Compiles all programs up front and hands them out once linked
+ *
+ * submit() issues compile and link of both stages without querying any
+ * status, so the driver is free to build every program at the same time.
+ * With GL_KHR_parallel_shader_compile (or the ARB variant) poll() checks
+ * GL_COMPLETION_STATUS and never blocks, until then program() returns the
+ * fallback so that rendering can start right away. Without the extension
+ * poll() falls back to blocking status queries, compiles still overlap with
+ * each other but not with rendering.
+ *
+ * Programs found in the program cache are ready right after submit().
+ */
+class ShaderManager
+{
+  public:
+    ShaderManager();
+
+    /**
+     * @param cache    optional binary cache, consulted on submit and filled when programs link
+     * @param onLinked optional hook run once for every program that becomes ready, e.g. to bind uniform blocks
+     */
+    void initialize(ProgramCache *cache, void (*onLinked)(GLuint program) = nullptr);
+
+    void uninitialize();
+
+    /**
+     * @brief start building a program
+     *
+     * @param fallback program returned by program() until this one is ready, may be 0
+     * @return handle of the request
+     */
+    uint32_t submit(const char *vertexFile, const char *fragmentFile, GLuint fallback);
+
+    /**
+     * @brief start building a program from sources already in memory
+     *
+     * @param sources vertex and fragment shader source
+     * @param names   names used in messages
+     */
+    uint32_t submit(const std::string sources[2], const std::string names[2], GLuint fallback);
+
+    /**
+     * @brief advance pending requests
+     *
+     * @return number of requests that became ready or failed during this call
+     */
+    uint32_t poll();
+
+    /**
+     * @brief block until a request is ready or failed
+     */
+    void finish(uint32_t handle);
+
+    /**
+     * @return linked program when ready, fallback otherwise
+     */
+    GLuint program(uint32_t handle) const;
+
+    ProgramState state(uint32_t handle) const;
+
+    const ProgramRequest &request(uint32_t handle) const
+    {
+        return requests[handle];
+    }
+
+    /**
+     * @brief compilation overlaps rendering
+     */
+    bool isParallel() const
+    {
+        return parallel;
+    }
+
+  private:
+    void complete(ProgramRequest &request);
+
+    std::vector<ProgramRequest> requests;
+    ProgramCache               *cache;
+    void (*onLinked)(GLuint program);
+    bool parallel;
+};
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef SHADERVARIANT_H
+#define SHADERVARIANT_H
+/**
+ * @file      shadervariant.h
+ * @brief     GLSL preprocessing and lazily built shader permutations
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <GL/glew.h>
+
+#include "shadermanager.h"
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+/* features per program, one bit of the permutation key each */
+#define MAX_SHADER_FEATURES 32
+
+/* deepest chain of nested includes */
+#define MAX_INCLUDE_DEPTH 16
+
+/**
+ * @brief expand #include "file" and inject feature defines
+ *
+ * Included paths are relative to the including file, every file is included
+ * at most once. Defines are inserted right after the #version line and #line
+ * directives keep compiler messages pointing at the right line, the source
+ * string number is the index of the file in files.
+ *
+ * @param path    root shader file
+ * @param defines names to #define, without values
+ * @param source  receives expanded source
+ * @param files   receives every file read, in #line numbering order
+ * @return true on success
+ */
+bool preprocessShader(const std::string &path, const std::vector<std::string> &defines, std::string &source, std::vector<std::string> &files);
+
+/**
+ * @brief Permutations of one vertex/fragment shader pair keyed by feature bits
+ *
+ * Features are registered by name and each gets one bit of the key. A
+ * variant is preprocessed and submitted to the shader manager the first time
+ * it is asked for, until it is linked program() returns the fallback. Built
+ * variants stay in memory for the lifetime of the object and, through the
+ * shader manager, in the program binary cache across runs.
+ */
+class ShaderVariants
+{
+  public:
+    ShaderVariants();
+
+    void initialize(ShaderManager *manager, const char *vertexFile, const char *fragmentFile, GLuint fallback);
+
+    /**
+     * @return key bit of feature, registered on first use, 0 when out of bits
+     */
+    uint32_t feature(const char *name);
+
+    /**
+     * @brief program of a permutation, building it on first use
+     *
+     * @return linked variant or fallback while it is still compiling or when it failed
+     */
+    GLuint program(uint32_t key);
+
+    /**
+     * @brief number of variants built or being built
+     */
+    uint32_t variantCount() const
+    {
+        return variants.size();
+    }
+
+  private:
+    ShaderManager               *manager;
+    std::string                  files[2];
+    GLuint                       fallback;
+    std::vector<std::string>     features; // index is bit position
+    std::map<uint32_t, uint32_t> variants; // key to shader manager handle
+};
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef STATECACHE_H
+#define STATECACHE_H
+/**
+ * @file      statecache.h
+ * @brief     Shadow copy of GL bindings to drop redundant state changes
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <GL/glew.h>
+
+#include <cstdint>
+
+#define STATE_TEXTURE_UNITS 8
+
+/**
+ * @brief Per-frame counters of issued and avoided state changes
+ */
+struct RenderStats
+{
+    uint32_t packets;            // draw packets submitted
+    uint32_t drawCalls;          // draw calls issued
+    uint32_t passChanges;        // pass setup callbacks run
+    uint32_t programChanges;     // glUseProgram issued
+    uint32_t programSkipped;     // glUseProgram avoided
+    uint32_t textureChanges;     // glBindTexture issued
+    uint32_t textureSkipped;     // glBindTexture avoided
+    uint32_t vertexArrayChanges; // glBindVertexArray issued
+    uint32_t vertexArraySkipped; // glBindVertexArray avoided
+};
+
+/**
+ * @brief Remembers what is bound and only calls into GL on a change
+ *
+ * All binds that go through the cache must keep going through it, any direct
+ * GL bind in between has to be followed by invalidate(). Texture units are
+ * tracked by name only, a unit is expected to be used with one target.
+ */
+class StateCache
+{
+  public:
+    StateCache();
+
+    void useProgram(GLuint program);
+    void bindTexture(GLuint unit, GLenum target, GLuint texture);
+    void bindVertexArray(GLuint vao);
+
+    /**
+     * @brief forget all cached bindings, next bind of every kind is issued
+     */
+    void invalidate();
+
+    /**
+     * @brief zero counters, called once per frame
+     */
+    void resetStats();
+
+    RenderStats stats;
+
+  private:
+    GLuint program;
+    GLuint vertexArray;
+    GLuint activeUnit;
+    GLuint textures[STATE_TEXTURE_UNITS];
+};
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef TEXTUREPOOL_H
+#define TEXTUREPOOL_H
+/**
+ * @file      texturepool.h
+ * @brief     Textures of one size and format packed into layers of an array texture
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <GL/glew.h>
+
+/* layer every pool starts with, plain white so untextured instances sample 1.0 */
+#define TEXTURE_LAYER_WHITE 0
+
+/**
+ * @brief RGBA8 GL_TEXTURE_2D_ARRAY shared by every object of a scene
+ *
+ * Objects reference their texture by layer index, carried per instance, so
+ * that one bind serves all of them and objects with different textures still
+ * go out in the same instanced draw. All layers share width, height and mip
+ * chain, textures of another size need a pool of their own.
+ */
+class TexturePool
+{
+  public:
+    /**
+     * @param owner tag of the texture in the resource registry, not copied
+     */
+    explicit TexturePool(const char *owner = "texture pool");
+
+    /**
+     * @brief allocate storage for all layers and fill the white layer
+     *
+     * @return 0 on success, -1 otherwise
+     */
+    int initialize(GLsizei width, GLsizei height, GLsizei maxLayers);
+
+    void uninitialize();
+
+    /**
+     * @brief copy an image into the next free layer
+     *
+     * @param rgba tightly packed RGBA8 texels
+     * @return layer index, -1 when the size does not match or the pool is full
+     */
+    GLint addLayer(const unsigned char *rgba, GLsizei width, GLsizei height);
+
+    /**
+     * @brief build mip levels of every layer, once all layers are added
+     */
+    void generateMipmaps();
+
+    GLuint texture() const
+    {
+        return arrayTexture;
+    }
+
+    GLsizei layerCount() const
+    {
+        return nLayers;
+    }
+
+  private:
+    GLuint      arrayTexture;
+    GLsizei     width;
+    GLsizei     height;
+    GLsizei     maxLayers;
+    GLsizei     nLayers;
+    const char *owner;
+};
+
+#endif
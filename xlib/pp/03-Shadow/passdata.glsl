@@ -0,0 +1,9 @@
+// Per-pass data, sub-allocated from the frame ring buffer [struct PassData]
+layout(std140) uniform PassData
+{
+    mat4 uView;
+    mat4 uProjection;
+    mat4 uPre;           // world space pre-transform [mirror or shadow projection]
+    vec4 uLightPosition; // world space
+    vec4 uClipPlane;     // world space, applied before pre-transform
+};
@@ -0,0 +1,216 @@
+/**
+ * @file      bvh.cpp
+ * @brief     Bounding volume hierarchy for frustum culling
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <algorithm>
+#include <cfloat>
+#include <cstdio>
+
+#include "bvh.h"
+
+/* refit may loosen the tree up to this factor before a rebuild is requested */
+#define BVH_REBUILD_RATIO 2.0f
+
+Bvh::Bvh() : nObjects(0U), builtArea(0.0f)
+{
+}
+
+void Bvh::build(const vmath::vec4 *spheres, uint32_t count)
+{
+    nObjects = count;
+    nodes.clear();
+    indices.resize(count);
+    for (uint32_t idx = 0U; idx < count; ++idx)
+        indices[idx] = idx;
+
+    if (0U == count)
+    {
+        builtArea = 0.0f;
+        return;
+    }
+
+    /* a binary tree with leaves of at least half BVH_LEAF_SIZE has fewer than this many nodes */
+    nodes.reserve(2U * (count / (BVH_LEAF_SIZE / 2) + 1U));
+    nodes.push_back(BvhNode());
+    buildNode(0U, spheres, 0U, count, 0U);
+    builtArea = surfaceArea();
+}
+
+uint32_t Bvh::buildNode(uint32_t nodeIndex, const vmath::vec4 *spheres, uint32_t first, uint32_t count, uint32_t depth)
+{
+    nodes[nodeIndex].first = first;
+    nodes[nodeIndex].count = count;
+    nodes[nodeIndex].left  = 0U;
+    fitLeaf(nodes[nodeIndex], spheres);
+
+    if (count <= BVH_LEAF_SIZE || depth + 1U >= BVH_MAX_DEPTH)
+        return nodeIndex;
+
+    /* split at the median of centers along the axis where they spread the most */
+    float cmin[3] = {FLT_MAX, FLT_MAX, FLT_MAX};
+    float cmax[3] = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+    for (uint32_t idx = first; idx < first + count; ++idx)
+    {
+        const vmath::vec4 &s = spheres[indices[idx]];
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            cmin[axis] = std::min(cmin[axis], s[axis]);
+            cmax[axis] = std::max(cmax[axis], s[axis]);
+        }
+    }
+
+    int axis = 0;
+    if (cmax[1] - cmin[1] > cmax[axis] - cmin[axis])
+        axis = 1;
+    if (cmax[2] - cmin[2] > cmax[axis] - cmin[axis])
+        axis = 2;
+
+    uint32_t half = count / 2U;
+    std::nth_element(indices.begin() + first, indices.begin() + first + half, indices.begin() + first + count,
+                     [spheres, axis](uint32_t lhs, uint32_t rhs) { return spheres[lhs][axis] < spheres[rhs][axis]; });
+
+    /* children adjacent and after their parent, refit relies on that order */
+    uint32_t left = nodes.size();
+    nodes.push_back(BvhNode());
+    nodes.push_back(BvhNode());
+    nodes[nodeIndex].left = left;
+
+    buildNode(left, spheres, first, half, depth + 1U);
+    buildNode(left + 1U, spheres, first + half, count - half, depth + 1U);
+    return nodeIndex;
+}
+
+void Bvh::fitLeaf(BvhNode &node, const vmath::vec4 *spheres) const
+{
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        node.min[axis] = FLT_MAX;
+        node.max[axis] = -FLT_MAX;
+    }
+
+    for (uint32_t idx = node.first; idx < node.first + node.count; ++idx)
+    {
+        const vmath::vec4 &s = spheres[indices[idx]];
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            node.min[axis] = std::min(node.min[axis], s[axis] - s[3]);
+            node.max[axis] = std::max(node.max[axis], s[axis] + s[3]);
+        }
+    }
+}
+
+float Bvh::surfaceArea() const
+{
+    float area = 0.0f;
+
+    for (size_t idx = 0U; idx < nodes.size(); ++idx)
+    {
+        const BvhNode &node = nodes[idx];
+        float          dx   = node.max[0] - node.min[0];
+        float          dy   = node.max[1] - node.min[1];
+        float          dz   = node.max[2] - node.min[2];
+        area += dx * dy + dy * dz + dz * dx;
+    }
+    return area;
+}
+
+bool Bvh::refit(const vmath::vec4 *spheres)
+{
+    if (nodes.empty())
+        return false;
+
+    /* children always follow their parent, walking backwards visits them first */
+    for (size_t idx = nodes.size(); idx-- > 0U;)
+    {
+        BvhNode &node = nodes[idx];
+        if (0U == node.left)
+        {
+            fitLeaf(node, spheres);
+            continue;
+        }
+
+        const BvhNode &left  = nodes[node.left];
+        const BvhNode &right = nodes[node.left + 1U];
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            node.min[axis] = std::min(left.min[axis], right.min[axis]);
+            node.max[axis] = std::max(left.max[axis], right.max[axis]);
+        }
+    }
+
+    return surfaceArea() > builtArea * BVH_REBUILD_RATIO;
+}
+
+void Bvh::cull(const Frustum *frusta, uint32_t nFrusta, const vmath::vec4 *spheres, std::vector<uint32_t> &visible, CullStats *stats) const
+{
+    uint32_t stack[BVH_MAX_DEPTH + 1];
+    uint32_t top     = 0U;
+    uint32_t visited = 0U;
+
+    visible.clear();
+    if (nodes.empty())
+        return;
+
+    stack[top++] = 0U;
+    while (top > 0U)
+    {
+        const BvhNode &node   = nodes[stack[--top]];
+        FrustumResult  result = FRUSTUM_OUTSIDE;
+
+        visited++;
+        for (uint32_t f = 0U; f < nFrusta && FRUSTUM_INSIDE != result; ++f)
+        {
+            FrustumResult r = frusta[f].testAabb(node.min, node.max);
+            if (r > result)
+                result = r;
+        }
+
+        if (FRUSTUM_OUTSIDE == result)
+            continue;
+
+        /* whole subtree visible, take its object range without further tests */
+        if (FRUSTUM_INSIDE == result)
+        {
+            visible.insert(visible.end(), indices.begin() + node.first, indices.begin() + node.first + node.count);
+            continue;
+        }
+
+        if (0U != node.left)
+        {
+            stack[top++] = node.left;
+            stack[top++] = node.left + 1U;
+            continue;
+        }
+
+        for (uint32_t idx = node.first; idx < node.first + node.count; ++idx)
+        {
+            const vmath::vec4 &s = spheres[indices[idx]];
+            for (uint32_t f = 0U; f < nFrusta; ++f)
+            {
+                if (frusta[f].testSphere(s[0], s[1], s[2], s[3]))
+                {
+                    visible.push_back(indices[idx]);
+                    break;
+                }
+            }
+        }
+    }
+
+    if (nullptr != stats)
+    {
+        stats->objects += nObjects;
+        stats->visible += visible.size();
+        stats->culled += nObjects - visible.size();
+        stats->nodesVisited += visited;
+    }
+}
@@ -0,0 +1,152 @@
+/**
+ * @file      frustum.cpp
+ * @brief     View frustum planes and visibility tests
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <cmath>
+
+#include "frustum.h"
+
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+
+/* distance of padding planes, large enough to accept any scene */
+#define FRUSTUM_FAR_AWAY 1e30f
+
+void Frustum::extract(const vmath::mat4 &clip)
+{
+    /* matrix is column major, element [col][row] */
+    for (int plane = 0; plane < 6; ++plane)
+    {
+        int   row  = plane / 2;
+        float sign = (plane & 1) ? -1.0f : 1.0f;
+
+        /* left, right, bottom, top, near, far: row 3 +/- row 0, 1, 2 */
+        a[plane] = clip[0][3] + sign * clip[0][row];
+        b[plane] = clip[1][3] + sign * clip[1][row];
+        c[plane] = clip[2][3] + sign * clip[2][row];
+        d[plane] = clip[3][3] + sign * clip[3][row];
+
+        float length = sqrtf(a[plane] * a[plane] + b[plane] * b[plane] + c[plane] * c[plane]);
+        if (length > 1e-6f)
+        {
+            a[plane] /= length;
+            b[plane] /= length;
+            c[plane] /= length;
+            d[plane] /= length;
+        }
+        else
+        {
+            /* degenerate plane of a projective matrix, constant for all points */
+            a[plane] = b[plane] = c[plane] = 0.0f;
+            d[plane]                       = d[plane] < 0.0f ? -FRUSTUM_FAR_AWAY : FRUSTUM_FAR_AWAY;
+        }
+    }
+
+    for (int plane = 6; plane < FRUSTUM_PLANES; ++plane)
+    {
+        a[plane] = b[plane] = c[plane] = 0.0f;
+        d[plane]                       = FRUSTUM_FAR_AWAY;
+    }
+}
+
+#if defined(__SSE__)
+
+bool Frustum::testSphere(float x, float y, float z, float radius) const
+{
+    const __m128 px   = _mm_set1_ps(x);
+    const __m128 py   = _mm_set1_ps(y);
+    const __m128 pz   = _mm_set1_ps(z);
+    const __m128 nrad = _mm_set1_ps(-radius);
+    int          mask = 0;
+
+    for (int plane = 0; plane < FRUSTUM_PLANES; plane += 4)
+    {
+        __m128 dist = _mm_add_ps(_mm_mul_ps(_mm_load_ps(a + plane), px), _mm_load_ps(d + plane));
+        dist        = _mm_add_ps(dist, _mm_mul_ps(_mm_load_ps(b + plane), py));
+        dist        = _mm_add_ps(dist, _mm_mul_ps(_mm_load_ps(c + plane), pz));
+        mask |= _mm_movemask_ps(_mm_cmplt_ps(dist, nrad));
+    }
+    return 0 == mask;
+}
+
+FrustumResult Frustum::testAabb(const float min[3], const float max[3]) const
+{
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 cx   = _mm_set1_ps((min[0] + max[0]) * 0.5f);
+    const __m128 cy   = _mm_set1_ps((min[1] + max[1]) * 0.5f);
+    const __m128 cz   = _mm_set1_ps((min[2] + max[2]) * 0.5f);
+    const __m128 ex   = _mm_mul_ps(_mm_set1_ps(max[0] - min[0]), half);
+    const __m128 ey   = _mm_mul_ps(_mm_set1_ps(max[1] - min[1]), half);
+    const __m128 ez   = _mm_mul_ps(_mm_set1_ps(max[2] - min[2]), half);
+    const __m128 zero = _mm_setzero_ps();
+    int          out  = 0; // planes box is fully behind
+    int          cut  = 0; // planes crossing the box
+
+    for (int plane = 0; plane < FRUSTUM_PLANES; plane += 4)
+    {
+        __m128 pa = _mm_load_ps(a + plane);
+        __m128 pb = _mm_load_ps(b + plane);
+        __m128 pc = _mm_load_ps(c + plane);
+
+        /* |n| as max(n, -n) keeps this within SSE1 */
+        __m128 absA = _mm_max_ps(pa, _mm_sub_ps(zero, pa));
+        __m128 absB = _mm_max_ps(pb, _mm_sub_ps(zero, pb));
+        __m128 absC = _mm_max_ps(pc, _mm_sub_ps(zero, pc));
+
+        /* signed distance of center and projected half size of box on plane normal */
+        __m128 dist   = _mm_add_ps(_mm_add_ps(_mm_mul_ps(pa, cx), _mm_mul_ps(pb, cy)), _mm_add_ps(_mm_mul_ps(pc, cz), _mm_load_ps(d + plane)));
+        __m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(absA, ex), _mm_mul_ps(absB, ey)), _mm_mul_ps(absC, ez));
+
+        out |= _mm_movemask_ps(_mm_cmplt_ps(dist, _mm_sub_ps(zero, radius)));
+        cut |= _mm_movemask_ps(_mm_cmplt_ps(dist, radius));
+    }
+
+    if (out)
+        return FRUSTUM_OUTSIDE;
+    return cut ? FRUSTUM_INTERSECT : FRUSTUM_INSIDE;
+}
+
+#else
+
+bool Frustum::testSphere(float x, float y, float z, float radius) const
+{
+    for (int plane = 0; plane < FRUSTUM_PLANES; ++plane)
+    {
+        if (a[plane] * x + b[plane] * y + c[plane] * z + d[plane] < -radius)
+            return false;
+    }
+    return true;
+}
+
+FrustumResult Frustum::testAabb(const float min[3], const float max[3]) const
+{
+    FrustumResult result = FRUSTUM_INSIDE;
+
+    for (int plane = 0; plane < FRUSTUM_PLANES; ++plane)
+    {
+        float cx     = (min[0] + max[0]) * 0.5f;
+        float cy     = (min[1] + max[1]) * 0.5f;
+        float cz     = (min[2] + max[2]) * 0.5f;
+        float dist   = a[plane] * cx + b[plane] * cy + c[plane] * cz + d[plane];
+        float radius = fabsf(a[plane]) * (max[0] - cx) + fabsf(b[plane]) * (max[1] - cy) + fabsf(c[plane]) * (max[2] - cz);
+
+        if (dist < -radius)
+            return FRUSTUM_OUTSIDE;
+        if (dist < radius)
+            result = FRUSTUM_INTERSECT;
+    }
+    return result;
+}
+
+#endif
@@ -0,0 +1,208 @@
+/**
+ * @file      immediate.cpp
+ * @brief     Capture of immediate mode geometry into vertex buffers
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <cstdio>
+#include <cstring>
+
+#include "immediate.h"
+
+#define EMPTY_BUCKET (~0U)
+
+/* 64 bit FNV-1a */
+static uint64_t hashBytes(const void *data, size_t size, uint64_t hash = 14695981039346656037ULL)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+    for (size_t idx = 0U; idx < size; ++idx)
+    {
+        hash ^= bytes[idx];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+ImmediateBatch::ImmediateBatch() : mode(GL_TRIANGLES), inside(false)
+{
+    memset(&current, 0, sizeof(current));
+    current.normal[2] = 1.0f; // same default normal as fixed function pipeline
+}
+
+void ImmediateBatch::reset()
+{
+    vertices.clear();
+    indices.clear();
+    buckets.assign(buckets.size(), EMPTY_BUCKET);
+}
+
+void ImmediateBatch::begin(GLenum mode)
+{
+    if (inside)
+    {
+        fprintf(stderr, "[%s] begin called inside begin/end\n", __func__);
+        return;
+    }
+    this->mode = mode;
+    inside     = true;
+    primitive.clear();
+}
+
+void ImmediateBatch::normal3f(GLfloat x, GLfloat y, GLfloat z)
+{
+    current.normal[0] = x;
+    current.normal[1] = y;
+    current.normal[2] = z;
+}
+
+void ImmediateBatch::texCoord2f(GLfloat u, GLfloat v)
+{
+    current.texcoord[0] = u;
+    current.texcoord[1] = v;
+}
+
+void ImmediateBatch::vertex3f(GLfloat x, GLfloat y, GLfloat z)
+{
+    current.position[0] = x;
+    current.position[1] = y;
+    current.position[2] = z;
+    primitive.push_back(current);
+}
+
+void ImmediateBatch::end()
+{
+    const GLuint n = primitive.size();
+
+    if (!inside)
+    {
+        fprintf(stderr, "[%s] end called without begin\n", __func__);
+        return;
+    }
+    inside = false;
+
+    switch (mode)
+    {
+        case GL_TRIANGLES:
+        {
+            for (GLuint idx = 0U; idx + 2U < n; idx += 3U)
+                emit(idx, idx + 1U, idx + 2U);
+            break;
+        }
+        case GL_TRIANGLE_STRIP:
+        {
+            /* every other triangle is flipped to keep the winding consistent */
+            for (GLuint idx = 2U; idx < n; ++idx)
+            {
+                if (idx & 1U)
+                    emit(idx - 1U, idx - 2U, idx);
+                else
+                    emit(idx - 2U, idx - 1U, idx);
+            }
+            break;
+        }
+        case GL_TRIANGLE_FAN:
+        case GL_POLYGON:
+        {
+            for (GLuint idx = 2U; idx < n; ++idx)
+                emit(0U, idx - 1U, idx);
+            break;
+        }
+        case GL_QUADS:
+        {
+            for (GLuint idx = 0U; idx + 3U < n; idx += 4U)
+            {
+                emit(idx, idx + 1U, idx + 2U);
+                emit(idx, idx + 2U, idx + 3U);
+            }
+            break;
+        }
+        case GL_QUAD_STRIP:
+        {
+            /* quad k is made of vertices 2k, 2k+1, 2k+3, 2k+2 */
+            for (GLuint idx = 0U; idx + 3U < n; idx += 2U)
+            {
+                emit(idx, idx + 1U, idx + 3U);
+                emit(idx, idx + 3U, idx + 2U);
+            }
+            break;
+        }
+        default:
+        {
+            fprintf(stderr, "[%s] unsupported primitive mode 0x%x, %u vertices dropped\n", __func__, mode, n);
+            break;
+        }
+    }
+}
+
+void ImmediateBatch::emit(GLuint a, GLuint b, GLuint c)
+{
+    const GLuint corners[3] = {a, b, c};
+
+    for (GLuint corner = 0U; corner < 3U; ++corner)
+    {
+        const MeshVertex &vertex = primitive[corners[corner]];
+
+        /* keep the table at most half full */
+        if (2U * (vertices.size() + 1U) > buckets.size())
+        {
+            size_t size = buckets.size() ? 2U * buckets.size() : 1024U;
+            buckets.assign(size, EMPTY_BUCKET);
+            for (GLuint idx = 0U; idx < vertices.size(); ++idx)
+            {
+                size_t slot = hashBytes(&vertices[idx], sizeof(MeshVertex)) & (size - 1U);
+                while (EMPTY_BUCKET != buckets[slot])
+                    slot = (slot + 1U) & (size - 1U);
+                buckets[slot] = idx;
+            }
+        }
+
+        /* look up vertex, linear probing */
+        size_t mask = buckets.size() - 1U;
+        size_t slot = hashBytes(&vertex, sizeof(MeshVertex)) & mask;
+        while (EMPTY_BUCKET != buckets[slot] && 0 != memcmp(&vertices[buckets[slot]], &vertex, sizeof(MeshVertex)))
+            slot = (slot + 1U) & mask;
+
+        if (EMPTY_BUCKET == buckets[slot])
+        {
+            buckets[slot] = vertices.size();
+            vertices.push_back(vertex);
+        }
+        indices.push_back(buckets[slot]);
+    }
+}
+
+int ImmediateBatch::compile(InstancedMesh &mesh)
+{
+    if (inside)
+    {
+        fprintf(stderr, "[%s] compile called inside begin/end\n", __func__);
+        return -1;
+    }
+
+    if (vertices.empty() || indices.empty())
+    {
+        return -1;
+    }
+
+    uint64_t hash = hashBytes(vertices.data(), vertices.size() * sizeof(MeshVertex));
+    hash          = hashBytes(indices.data(), indices.size() * sizeof(GLuint), hash);
+    /* the hash lives in the mesh, several meshes can be compiled from one batch */
+    if (0ULL != hash && hash == mesh.geometryHash())
+    {
+        return 0;
+    }
+
+    if (0 != mesh.initialize(vertices.data(), vertices.size(), indices.data(), indices.size(), hash))
+    {
+        return -1;
+    }
+    return 1;
+}
@@ -0,0 +1,257 @@
+/**
+ * @file      instancing.cpp
+ * @brief     Instanced mesh rendering
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <cmath>
+#include <cstddef>
+
+#include "instancing.h"
+#include "resourceregistry.h"
+
+static_assert(sizeof(vmath::mat4) == 16 * sizeof(GLfloat), "mat4 must be tightly packed");
+static_assert(sizeof(Instance) == 25 * sizeof(GLfloat), "Instance must be tightly packed");
+
+InstancedMesh::InstancedMesh(const char *owner)
+    : vao(0U), vertexBuffer(0U), indexBuffer(0U), instanceBuffer(0U), nIndices(0), nInstances(0), capacity(0), instanceSource(0U), hash(0ULL), owner(owner)
+{
+}
+
+int InstancedMesh::initialize(const MeshVertex *vertices, GLsizei nVertices, const GLuint *indices, GLsizei nIndices, uint64_t hash)
+{
+    if (nullptr == vertices || nullptr == indices || 0 >= nVertices || 0 >= nIndices)
+    {
+        return -1;
+    }
+    this->nIndices = nIndices;
+    this->hash     = hash;
+
+    /* already initialized, only the geometry changes */
+    if (vao)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+        glBufferData(GL_ARRAY_BUFFER, nVertices * sizeof(MeshVertex), vertices, GL_STATIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        resourceRegistry.trackBuffer(vertexBuffer, RESOURCE_VERTEX, owner, nVertices * sizeof(MeshVertex));
+
+        glBindVertexArray(vao);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, nIndices * sizeof(GLuint), indices, GL_STATIC_DRAW);
+        glBindVertexArray(0);
+        resourceRegistry.trackBuffer(indexBuffer, RESOURCE_INDEX, owner, nIndices * sizeof(GLuint));
+        return 0;
+    }
+
+    glGenVertexArrays(1, &vao);
+    glBindVertexArray(vao);
+
+    /* per-vertex attributes */
+    glGenBuffers(1, &vertexBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, nVertices * sizeof(MeshVertex), vertices, GL_STATIC_DRAW);
+    resourceRegistry.trackBuffer(vertexBuffer, RESOURCE_VERTEX, owner, nVertices * sizeof(MeshVertex));
+
+    glEnableVertexAttribArray(ATTRIB_POSITION);
+    glVertexAttribPointer(ATTRIB_POSITION, 3, GL_FLOAT, GL_FALSE, sizeof(MeshVertex), (void *)offsetof(MeshVertex, position));
+    glEnableVertexAttribArray(ATTRIB_NORMAL);
+    glVertexAttribPointer(ATTRIB_NORMAL, 3, GL_FLOAT, GL_FALSE, sizeof(MeshVertex), (void *)offsetof(MeshVertex, normal));
+    glEnableVertexAttribArray(ATTRIB_TEXCOORD);
+    glVertexAttribPointer(ATTRIB_TEXCOORD, 2, GL_FLOAT, GL_FALSE, sizeof(MeshVertex), (void *)offsetof(MeshVertex, texcoord));
+
+    glGenBuffers(1, &indexBuffer);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, nIndices * sizeof(GLuint), indices, GL_STATIC_DRAW);
+    resourceRegistry.trackBuffer(indexBuffer, RESOURCE_INDEX, owner, nIndices * sizeof(GLuint));
+
+    /* per-instance attributes, advanced once per instance */
+    glGenBuffers(1, &instanceBuffer);
+    pointInstanceAttributes(instanceBuffer, 0);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    return 0;
+}
+
+/* expects vao to be bound */
+void InstancedMesh::pointInstanceAttributes(GLuint buffer, GLintptr offset)
+{
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+
+    glEnableVertexAttribArray(ATTRIB_DIFFUSE);
+    glVertexAttribPointer(ATTRIB_DIFFUSE, 4, GL_FLOAT, GL_FALSE, sizeof(Instance), (void *)(offset + offsetof(Instance, diffuse)));
+    glVertexAttribDivisor(ATTRIB_DIFFUSE, 1);
+
+    glEnableVertexAttribArray(ATTRIB_EMISSION);
+    glVertexAttribPointer(ATTRIB_EMISSION, 4, GL_FLOAT, GL_FALSE, sizeof(Instance), (void *)(offset + offsetof(Instance, emission)));
+    glVertexAttribDivisor(ATTRIB_EMISSION, 1);
+
+    glEnableVertexAttribArray(ATTRIB_LAYER);
+    glVertexAttribPointer(ATTRIB_LAYER, 1, GL_FLOAT, GL_FALSE, sizeof(Instance), (void *)(offset + offsetof(Instance, layer)));
+    glVertexAttribDivisor(ATTRIB_LAYER, 1);
+
+    for (GLuint column = 0U; column < 4U; ++column)
+    {
+        glEnableVertexAttribArray(ATTRIB_MODEL + column);
+        glVertexAttribPointer(ATTRIB_MODEL + column, 4, GL_FLOAT, GL_FALSE, sizeof(Instance), (void *)(offset + offsetof(Instance, model) + column * 4 * sizeof(GLfloat)));
+        glVertexAttribDivisor(ATTRIB_MODEL + column, 1);
+    }
+    instanceSource = buffer;
+}
+
+void InstancedMesh::setInstances(const Instance *instances, GLsizei count)
+{
+    nInstances = count;
+    if (0 == count)
+    {
+        return;
+    }
+
+    if (instanceSource != instanceBuffer)
+    {
+        glBindVertexArray(vao);
+        pointInstanceAttributes(instanceBuffer, 0);
+        glBindVertexArray(0);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    if (count > capacity)
+    {
+        capacity = capacity * 2 > count ? capacity * 2 : count;
+    }
+    glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(Instance), nullptr, GL_STATIC_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, count * sizeof(Instance), instances);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    resourceRegistry.trackBuffer(instanceBuffer, RESOURCE_INSTANCE, owner, capacity * sizeof(Instance));
+}
+
+Instance *InstancedMesh::streamInstances(StreamBuffer &ring, GLsizei count)
+{
+    GLintptr  offset    = 0;
+    Instance *instances = nullptr;
+
+    nInstances = 0;
+    if (0 == count)
+    {
+        return nullptr;
+    }
+
+    instances = (Instance *)ring.allocate(count * sizeof(Instance), 4 * sizeof(GLfloat), &offset);
+    if (nullptr == instances)
+    {
+        return nullptr;
+    }
+
+    /* only the offset changes from frame to frame, vertex array keeps its layout */
+    glBindVertexArray(vao);
+    pointInstanceAttributes(ring.buffer(), offset);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    nInstances = count;
+    return instances;
+}
+
+GLuint InstancedMesh::draw(StateCache &state) const
+{
+    if (0 == nInstances)
+    {
+        return 0U;
+    }
+
+    state.bindVertexArray(vao);
+    glDrawElementsInstanced(GL_TRIANGLES, nIndices, GL_UNSIGNED_INT, nullptr, nInstances);
+    return 1U;
+}
+
+void InstancedMesh::uninitialize()
+{
+    if (instanceBuffer)
+    {
+        resourceRegistry.release(GL_BUFFER, instanceBuffer);
+        glDeleteBuffers(1, &instanceBuffer);
+        instanceBuffer = 0U;
+    }
+
+    if (indexBuffer)
+    {
+        resourceRegistry.release(GL_BUFFER, indexBuffer);
+        glDeleteBuffers(1, &indexBuffer);
+        indexBuffer = 0U;
+    }
+
+    if (vertexBuffer)
+    {
+        resourceRegistry.release(GL_BUFFER, vertexBuffer);
+        glDeleteBuffers(1, &vertexBuffer);
+        vertexBuffer = 0U;
+    }
+
+    if (vao)
+    {
+        glDeleteVertexArrays(1, &vao);
+        vao = 0U;
+    }
+    nIndices       = 0;
+    nInstances     = 0;
+    capacity       = 0;
+    instanceSource = 0U;
+    hash           = 0ULL;
+}
+
+/* index quads of a (rows + 1) x (columns + 1) vertex grid, counter clockwise when b follows a along a row */
+static void indexGrid(std::vector<GLuint> &indices, GLuint base, GLint rows, GLint columns)
+{
+    for (GLint i = 0; i < rows; ++i)
+    {
+        for (GLint j = 0; j < columns; ++j)
+        {
+            GLuint a = base + i * (columns + 1) + j;
+            GLuint b = a + 1;
+            GLuint d = a + columns + 1;
+            GLuint c = d + 1;
+
+            indices.push_back(a);
+            indices.push_back(b);
+            indices.push_back(c);
+
+            indices.push_back(a);
+            indices.push_back(c);
+            indices.push_back(d);
+        }
+    }
+}
+
+void generateSphere(std::vector<MeshVertex> &vertices, std::vector<GLuint> &indices, GLfloat radius, GLint slices, GLint stacks)
+{
+    const GLfloat sliceDelta = 2.0 * M_PI / slices;
+    const GLfloat stackDelta = M_PI / stacks;
+    const GLuint  base       = vertices.size();
+
+    for (GLint i = 0; i <= stacks; ++i)
+    {
+        GLfloat cosPhi = cosf(i * stackDelta);
+        GLfloat sinPhi = sinf(i * stackDelta);
+
+        for (GLint j = 0; j <= slices; ++j)
+        {
+            GLfloat    cosTheta = cosf(j * sliceDelta);
+            GLfloat    sinTheta = sinf(j * sliceDelta);
+            MeshVertex vertex   = {
+                {radius * sinPhi * cosTheta, radius * cosPhi, radius * sinPhi * sinTheta},
+                {sinPhi * cosTheta, cosPhi, sinPhi * sinTheta},
+                {(GLfloat)j / slices, (GLfloat)i / stacks},
+            };
+            vertices.push_back(vertex);
+        }
+    }
+    indexGrid(indices, base, stacks, slices);
+}
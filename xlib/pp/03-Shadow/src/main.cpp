@@ -0,0 +1,1257 @@
+/**
+ * @file      main.cpp
+ * @brief     Shadow and Reflection with instanced spheres
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ *
+ *  Programmable pipeline port of xlib/ffp/shadow. Every mesh is drawn through
+ *  InstancedMesh so the orbiting spheres cost one draw call per pass no matter
+ *  how many of them are in the scene. Torus and ground are still described by
+ *  the immediate mode code of the original sample, captured by ImmediateBatch.
+ *
+ *  usage: ./shadow [nSpheres]
+ *      nSpheres - number of additional orbiting spheres for stress testing
+ *
+ *  VRAM_BUDGET_MB - warn when buffers and textures together exceed this many MiB
+ */
+
+// clang-format off
+#include <GL/glew.h>
+#include <GL/gl.h>
+#include <GL/glext.h>
+#include <GL/glx.h>
+// clang-format on
+
+#include <X11/X.h>
+#include <X11/XKBlib.h>
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
+#include <X11/keysymdef.h>
+
+#include "bvh.h"
+#include "frustum.h"
+#include "immediate.h"
+#include "instancing.h"
+#include "programcache.h"
+#include "renderqueue.h"
+#include "resourceregistry.h"
+#include "ringbuffer.h"
+#include "shader.h"
+#include "shadermanager.h"
+#include "shadervariant.h"
+#include "statecache.h"
+#include "texturepool.h"
+#include "vmath.h"
+#include "../../../benchmark/benchmark.h"
+#include "../../../benchmark/gldebug.h"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <vector>
+
+#define gpFILE stdout
+
+#define WIN_WIDTH  800
+#define WIN_HEIGHT 600
+
+#define MAX_STRESS_SPHERES 1000000
+
+#define FAR_PLANE 100.0f
+
+/* passes in order of execution */
+#define PASS_STENCIL    0U
+#define PASS_REFLECTION 1U
+#define PASS_GROUND     2U
+#define PASS_SHADOW     3U
+#define PASS_SCENE      4U
+
+/* mesh ids for sort key */
+#define MESH_TORUS  1U
+#define MESH_SPHERE 2U
+#define MESH_GROUND 3U
+
+/* bounding sphere radii */
+#define SPHERE_RADIUS 0.2f
+#define TORUS_RADIUS  1.0f
+
+/* directory of program binaries, relative to working directory */
+#define PROGRAM_CACHE_DIR "shadercache"
+
+/* uniform buffer binding point of PassData */
+#define PASS_DATA_BINDING 0U
+
+/* room in every frame region for PassData copies of all passes */
+#define PASS_DATA_BUDGET (64 * 1024)
+
+/* procedural sphere textures, all in one array texture */
+#define TEXTURE_SIZE     64
+#define TEXTURE_LAYERS   8
+#define TEXTURE_PATTERNS 4
+
+void        display();
+void        update();
+int         initialize();
+void        uninitialize();
+void        resize(int32_t width, int32_t height);
+static void toggleFullscreen(Display *display, Window window);
+static void drawScene(uint32_t pass);
+static void drawSurface(ImmediateBatch &batch);
+static void doughnut(ImmediateBatch &batch, GLfloat r, GLfloat R, GLint nsides, GLint rings);
+static void setShadowMatrix(vmath::mat4 &destMat, const vmath::vec4 &lightPos, const vmath::vec4 &plane);
+static void printReport();
+static void generatePattern(int pattern, std::vector<unsigned char> &rgba);
+static void onProgramLinked(GLuint linked);
+static void beginStencilPass(StateCache &state);
+static void endStencilPass(StateCache &state);
+static void beginReflectionPass(StateCache &state);
+static void endReflectionPass(StateCache &state);
+static void beginGroundPass(StateCache &state);
+static void endGroundPass(StateCache &state);
+static void beginShadowPass(StateCache &state);
+static void endShadowPass(StateCache &state);
+static void beginScenePass(StateCache &state);
+static void endScenePass(StateCache &state);
+
+/* Windowing related variables */
+Display             *dpy              = nullptr; // connection to server
+Window               root             = 0UL;     // handle of root window [Desktop]
+Window               w                = 0UL;     // handle of current window
+int                  scr              = 0;       // handle to DefaultScreen
+XVisualInfo         *vi               = nullptr; // Pointer to current visual info
+XSetWindowAttributes xattr            = {};      // structure for windows attributes
+bool                 gbAbortFlag      = false;   // Global abort flag
+GLint                result           = 0;       // variable to get value returned by APIS
+GLXContext           glCtxt           = nullptr; // handle to OpenGL context
+static Atom          wm_delete_window = 0;       // atomic variable to detect close button click
+XRectangle           rect             = {0};     // window dimentions rectangle
+bool                 gbFullscreen     = false;   // should display in fullscreen mode
+
+/* Variables related to current program */
+GLboolean shouldDraw = false; // decide to render or not
+GLuint    program    = 0; // fallback drawn while scene variants compile
+
+/**
+ * @brief Uniforms shared by all draws of a pass, mirrors std140 block PassData in shaders
+ */
+struct PassData
+{
+    vmath::mat4 view;
+    vmath::mat4 projection;
+    vmath::mat4 pre;           // world space pre-transform [mirror or shadow projection]
+    vmath::vec4 lightPosition; // world space
+    vmath::vec4 clipPlane;     // world space, applied before pre-transform
+};
+static_assert(sizeof(PassData) == 224, "PassData must match std140 layout of shader block");
+
+PassData passData;
+GLint    uniformAlignment = 256; // GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+
+/* transformation matrices */
+vmath::mat4 Projection;
+vmath::mat4 View;
+vmath::mat4 shadowMatrix;
+
+/* camera position */
+GLfloat xPos = 0.0f;
+GLfloat yPos = 2.1f;
+GLfloat zPos = 8.0f;
+
+/*--- State of effects and objects in the scene ---*/
+bool isReflectionEnabled = false;
+bool isClippingEnabled   = false;
+bool isShadowEnabled     = false;
+bool isStencilEnabled    = false;
+bool isTorusVisible      = true;
+bool isGreenVisible      = true;
+bool isYellowVisible     = true;
+bool isCyanVisible       = true;
+bool isBlueVisible       = true;
+
+/* Equation of ground plane [used for shadow & clipping planes] */
+const vmath::vec4 planeEquation(0.0f, 1.0f, 0.0f, 0.0f);
+const vmath::vec4 noClipPlane(0.0f, 0.0f, 0.0f, 1.0f);
+
+/* light properties */
+vmath::vec4 lightPosition(-4.0f, 3.3f, -2.0f, 1.0f);
+
+/* material properties */
+const vmath::vec4 colorBlack(0.0f, 0.0f, 0.0f, 1.0f);
+const vmath::vec4 materialRed(1.0f, 0.0f, 0.0f, 1.0f);
+const vmath::vec4 materialBlue(0.0f, 0.0f, 1.0f, 1.0f);
+const vmath::vec4 materialGreen(0.0f, 1.0f, 0.0f, 1.0f);
+const vmath::vec4 materialYellow(1.0f, 1.0f, 0.0f, 1.0f);
+const vmath::vec4 materialCyan(0.0f, 1.0f, 1.0f, 1.0f);
+const vmath::vec4 floorDiffuse(1.0f, 1.0f, 1.0f, 0.5f);
+
+/* meshes */
+InstancedMesh torusMesh("torus");
+InstancedMesh groundMesh("ground");
+InstancedMesh sphereMesh("spheres");
+
+/* textures, every mesh samples the pool so all draws share one material */
+TexturePool texturePool("scene textures");
+uint32_t    textureMaterial = 0U;           // render queue id of pool
+GLfloat     sphereLayers[TEXTURE_PATTERNS]; // pool layer of each pattern
+
+/* submission */
+RenderQueue    renderQueue;
+StateCache     stateCache;
+StreamBuffer   frameRing("frame ring"); // per-frame instances and pass data
+ProgramCache   programCache;
+ShaderManager  shaderManager;
+ShaderVariants sceneVariants;          // permutations of vertex.glsl + fragment.glsl
+uint32_t       featureShadow   = 0U;   // key bit of SHADOW variant
+uint32_t       fallbackProgram = 0U;   // shader manager handle
+uint32_t       programId       = 0U;   // render queue id of lit variant
+uint32_t       shadowProgramId = 0U;   // render queue id of shadow variant
+double         programStart    = 0.0;  // timestamp of program submission
+
+/* scene variant replaced the fallback, its load time was reported */
+bool isSceneProgramReady = false;
+
+/**
+ * @brief circular orbit of a stress test sphere around the torus
+ */
+struct Orbit
+{
+    vmath::vec3 u;     // first basis vector of orbital plane, scaled by radius
+    vmath::vec3 v;     // second basis vector of orbital plane, scaled by radius
+    GLfloat     phase; // starting angle in radians
+    GLfloat     speed; // angular speed relative to sphereAngle
+    vmath::vec4 color; // emission color
+    GLfloat     layer; // texture pool layer
+};
+
+GLsizei            nStressSpheres = 0;
+std::vector<Orbit> orbits;
+
+/* culling, spheres 0 - 3 are the named spheres, stress spheres follow */
+Bvh                      sphereBvh;
+std::vector<vmath::vec4> sphereBounds;
+std::vector<uint32_t>    visibleSpheres;
+CullStats                cullStats     = {0U, 0U, 0U, 0U};
+bool                     isTorusInView = true;
+
+/* animation state */
+float lightAngle  = 0.0f;
+float sphereAngle = 0.0f;
+
+/* frame statistics */
+struct FrameStats
+{
+    uint32_t nFrames;    // frames since last report
+    double   totalMs;    // accumulated frame time since last report
+    double   minMs;      // fastest frame since last report
+    double   maxMs;      // slowest frame since last report
+    double   lastReport; // timestamp of last report in milliseconds
+} frameStats = {0U, 0.0, 1e9, 0.0, 0.0};
+
+static double now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 1)
+    {
+        nStressSpheres = atoi(argv[1]);
+        if (nStressSpheres < 0)
+            nStressSpheres = 0;
+        if (nStressSpheres > MAX_STRESS_SPHERES)
+            nStressSpheres = MAX_STRESS_SPHERES;
+    }
+
+    dpy = XOpenDisplay(nullptr);
+
+    if (dpy == nullptr)
+    {
+        fprintf(stderr, "Error: Could not open X display\n");
+        exit(1);
+    }
+
+    scr  = DefaultScreen(dpy);
+    root = XDefaultRootWindow(dpy); // default window [Desktop]
+
+    // clang-format off
+    GLint glxAttriutes[] = {
+        GLX_RGBA,
+        GLX_DOUBLEBUFFER,
+        GLX_DEPTH_SIZE, 24,
+        GLX_STENCIL_SIZE, 8,
+        GLX_RED_SIZE, 8,
+        GLX_GREEN_SIZE, 8,
+        GLX_BLUE_SIZE, 8,
+        GLX_SAMPLE_BUFFERS, 0,
+        GLX_SAMPLES, 0,
+        None
+    };
+    // clang-format on
+
+    vi = glXChooseVisual(dpy, scr, glxAttriutes);
+    if (vi == nullptr)
+    {
+        fprintf(stderr, "Error: No appropriate visual found\n");
+        exit(1);
+    }
+
+    xattr.border_pixel      = BlackPixel(dpy, scr);
+    xattr.background_pixel  = WhitePixel(dpy, scr);
+    xattr.override_redirect = true;
+    xattr.colormap          = XCreateColormap(dpy, root, vi->visual, AllocNone);
+    xattr.event_mask        = ExposureMask | KeyPressMask | StructureNotifyMask;
+
+    /* create window */
+    w = XCreateWindow(dpy, root, 0, 0, WIN_WIDTH, WIN_HEIGHT, 0, vi->depth, InputOutput, vi->visual, CWBackPixel | CWColormap | CWBorderPixel | CWEventMask, &xattr);
+    XStoreName(dpy, w, "Rohit Nimkar: Instanced Reflection");
+
+    /* register for window close event */
+    wm_delete_window = XInternAtom(dpy, "WM_DELETE_WINDOW", False);
+    XSetWMProtocols(dpy, w, &wm_delete_window, 1);
+
+    /* make window visible */
+    XMapWindow(dpy, w);
+
+    /* debug context reporting performance warnings when GL_DEBUG is set */
+    struct DebugOutput debug;
+    glCtxt = debugOutputCreateContext(&debug, dpy, vi);
+    glXMakeCurrent(dpy, w, glCtxt);
+    /* initialize glew */
+    glewExperimental = true;
+    if (glewInit() != GLEW_OK)
+    {
+        std::cerr << "Failed to initialize glew\n";
+        XFree(vi);
+        XFreeColormap(dpy, xattr.colormap);
+        glXDestroyContext(dpy, glCtxt);
+        XDestroyWindow(dpy, w);
+        XCloseDisplay(dpy);
+        return -1;
+    }
+
+    debugOutputInstall(&debug);
+
+    if (0 != initialize())
+    {
+        uninitialize();
+        XFree(vi);
+        XFreeColormap(dpy, xattr.colormap);
+        glXMakeCurrent(dpy, None, nullptr);
+        glXDestroyContext(dpy, glCtxt);
+        XDestroyWindow(dpy, w);
+        XCloseDisplay(dpy);
+        return -1;
+    }
+
+    shouldDraw = false;
+    /* fixed workload with timing report when BENCHMARK_FRAMES is set */
+    struct Benchmark bench;
+    benchmarkInit(&bench, "pp/03-Shadow");
+
+    while (!gbAbortFlag)
+    {
+        XEvent event;
+        if (XPending(dpy))
+        {
+            XNextEvent(dpy, &event);
+            switch (event.type)
+            {
+                case Expose:
+                {
+                    if (!shouldDraw)
+                        shouldDraw = true;
+                    break;
+                }
+                case ClientMessage:
+                {
+                    if (event.xclient.data.l[0] == wm_delete_window)
+                    {
+                        gbAbortFlag = true;
+                    }
+
+                    break;
+                }
+                case KeyPress:
+                {
+                    KeySym sym = XkbKeycodeToKeysym(dpy, event.xkey.keycode, 0, 0);
+
+                    switch (sym)
+                    {
+                        case XK_x:
+                        {
+                            xPos += (event.xkey.state & ShiftMask) ? 0.1f : -0.1f;
+                            break;
+                        }
+                        case XK_y:
+                        {
+                            yPos += (event.xkey.state & ShiftMask) ? 0.1f : -0.1f;
+                            break;
+                        }
+                        case XK_z:
+                        {
+                            zPos += (event.xkey.state & ShiftMask) ? 0.1f : -0.1f;
+                            break;
+                        }
+                        case XK_f:
+                        {
+                            toggleFullscreen(dpy, w);
+                            gbFullscreen = !gbFullscreen;
+                            break;
+                        }
+                        case XK_m:
+                        {
+                            isStencilEnabled = !isStencilEnabled;
+                            break;
+                        }
+                        case XK_c:
+                        {
+                            isClippingEnabled = !isClippingEnabled;
+                            break;
+                        }
+                        case XK_s:
+                        {
+                            isShadowEnabled = !isShadowEnabled;
+                            break;
+                        }
+                        case XK_r:
+                        {
+                            isReflectionEnabled = !isReflectionEnabled;
+                            break;
+                        }
+                        case XK_p:
+                        {
+                            printReport();
+                            break;
+                        }
+                        case XK_Escape:
+                        {
+                            gbAbortFlag = true;
+                            break;
+                        }
+                        case '0':
+                        {
+                            isTorusVisible = !isTorusVisible;
+                            break;
+                        }
+                        case '1':
+                        {
+                            isGreenVisible = !isGreenVisible;
+                            break;
+                        }
+                        case '2':
+                        {
+                            isYellowVisible = !isYellowVisible;
+                            break;
+                        }
+                        case '3':
+                        {
+                            isBlueVisible = !isBlueVisible;
+                            break;
+                        }
+                        case '4':
+                        {
+                            isCyanVisible = !isCyanVisible;
+                            break;
+                        }
+                    }
+                    break;
+                }
+                case ConfigureNotify:
+                {
+                    if (rect.width != event.xconfigure.width || rect.height != event.xconfigure.height)
+                    {
+                        resize(event.xconfigure.width, event.xconfigure.height);
+                        rect.width  = event.xconfigure.width;
+                        rect.height = event.xconfigure.height;
+                    }
+                    break;
+                }
+            }
+        }
+
+        if (!shouldDraw)
+            continue;
+
+        double frameStart = now();
+        benchmarkBeginFrame(&bench);
+        benchmarkPhase(&bench, "update");
+        update();
+        benchmarkPhase(&bench, "render");
+        display();
+        benchmarkPhase(&bench, "swap");
+        glXSwapBuffers(dpy, w);
+        if (benchmarkEndFrame(&bench))
+            gbAbortFlag = true;
+
+        /* frame time includes swap, so it reflects the time the driver needed to catch up */
+        double frameMs = now() - frameStart;
+        frameStats.nFrames++;
+        frameStats.totalMs += frameMs;
+        if (frameMs < frameStats.minMs)
+            frameStats.minMs = frameMs;
+        if (frameMs > frameStats.maxMs)
+            frameStats.maxMs = frameMs;
+        if (frameStart - frameStats.lastReport >= 1000.0)
+        {
+            printReport();
+            frameStats.nFrames    = 0U;
+            frameStats.totalMs    = 0.0;
+            frameStats.minMs      = 1e9;
+            frameStats.maxMs      = 0.0;
+            frameStats.lastReport = frameStart;
+        }
+    }
+
+    uninitialize();
+    debugOutputReport(&debug, stderr);
+    glXMakeCurrent(dpy, None, nullptr);
+    glXDestroyContext(dpy, glCtxt);
+    XFree(vi);
+    XFreeColormap(dpy, xattr.colormap);
+    XDestroyWindow(dpy, w);
+    XCloseDisplay(dpy);
+    return (0);
+}
+
+static GLfloat randomFloat(GLfloat min, GLfloat max)
+{
+    return min + (max - min) * (static_cast<float>(rand()) / static_cast<float>(RAND_MAX));
+}
+
+int initialize()
+{
+    std::vector<MeshVertex> vertices;
+    std::vector<GLuint>     indices;
+    ImmediateBatch          batch;
+
+    fprintf(gpFILE, "%-20s:%s\n", "GPU Vendor", glGetString(GL_VENDOR));
+    fprintf(gpFILE, "%-20s:%s\n", "Version String", glGetString(GL_VERSION));
+    fprintf(gpFILE, "%-20s:%s\n", "Graphics Renderer", glGetString(GL_RENDERER));
+    fprintf(gpFILE, "%-20s:%s\n", "GL Shading Language", glGetString(GL_SHADING_LANGUAGE_VERSION));
+
+    const char *budget = getenv("VRAM_BUDGET_MB");
+    if (nullptr != budget)
+    {
+        resourceRegistry.setBudget((GLsizeiptr)(atof(budget) * 1024.0 * 1024.0));
+        fprintf(gpFILE, "%-20s:%s MiB\n", "VRAM budget", budget);
+    }
+
+    /*
+     * Programs build in the background, binaries from last run are reused when nothing changed.
+     * Only the small fallback program is waited for, the scene is drawn with it until the
+     * variant it needs is ready. Variants are built on first use.
+     */
+    std::string              fallbackSources[2];
+    std::string              fallbackNames[2] = {"fallback_vertex.glsl", "fallback_fragment.glsl"};
+    std::vector<std::string> included;
+    programStart = now();
+    programCache.initialize(PROGRAM_CACHE_DIR);
+    shaderManager.initialize(&programCache, onProgramLinked);
+    if (!preprocessShader(fallbackNames[0], std::vector<std::string>(), fallbackSources[0], included) ||
+        !preprocessShader(fallbackNames[1], std::vector<std::string>(), fallbackSources[1], included))
+    {
+        fprintf(gpFILE, "[%s] Failed to read fallback program\n", __func__);
+        return -1;
+    }
+    fallbackProgram = shaderManager.submit(fallbackSources, fallbackNames, 0U);
+    shaderManager.finish(fallbackProgram);
+    program = shaderManager.program(fallbackProgram);
+    if (PROGRAM_READY != shaderManager.state(fallbackProgram))
+    {
+        fprintf(gpFILE, "[%s] Failed to link program\n", __func__);
+        return -1;
+    }
+    sceneVariants.initialize(&shaderManager, "vertex.glsl", "fragment.glsl", program);
+    featureShadow = sceneVariants.feature("SHADOW");
+    fprintf(gpFILE, "%-20s:%s\n", "Shader compilation", shaderManager.isParallel() ? "parallel" : "blocking");
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniformAlignment);
+
+    /* every frame streams all sphere instances and a few copies of pass data */
+    if (0 != frameRing.initialize((nStressSpheres + 16) * sizeof(Instance) + PASS_DATA_BUDGET))
+    {
+        fprintf(gpFILE, "[%s] Failed to create frame ring buffer\n", __func__);
+        return -1;
+    }
+
+    /* passes of the frame, in the order of the original fixed function display() */
+    RenderPass stencilPass    = {beginStencilPass, endStencilPass, false};
+    RenderPass reflectionPass = {beginReflectionPass, endReflectionPass, false};
+    RenderPass groundPass     = {beginGroundPass, endGroundPass, true};
+    RenderPass shadowPass     = {beginShadowPass, endShadowPass, false};
+    RenderPass scenePass      = {beginScenePass, endScenePass, false};
+    programId                 = renderQueue.addProgram(program);
+    shadowProgramId           = renderQueue.addProgram(program);
+    renderQueue.setPass(PASS_STENCIL, stencilPass);
+    renderQueue.setPass(PASS_REFLECTION, reflectionPass);
+    renderQueue.setPass(PASS_GROUND, groundPass);
+    renderQueue.setPass(PASS_SHADOW, shadowPass);
+    renderQueue.setPass(PASS_SCENE, scenePass);
+
+    /* one array texture holds every pattern, instances pick theirs by layer */
+    if (0 != texturePool.initialize(TEXTURE_SIZE, TEXTURE_SIZE, TEXTURE_LAYERS))
+    {
+        fprintf(gpFILE, "[%s] Failed to create texture pool\n", __func__);
+        return -1;
+    }
+    std::vector<unsigned char> pattern;
+    for (int idx = 0; idx < TEXTURE_PATTERNS; ++idx)
+    {
+        generatePattern(idx, pattern);
+        sphereLayers[idx] = (GLfloat)texturePool.addLayer(pattern.data(), TEXTURE_SIZE, TEXTURE_SIZE);
+    }
+    texturePool.generateMipmaps();
+    textureMaterial = renderQueue.addMaterial(texturePool.texture(), GL_TEXTURE_2D_ARRAY);
+    fprintf(gpFILE, "%-20s:%d of %d layers, %dx%d\n", "Texture pool", texturePool.layerCount(), TEXTURE_LAYERS, TEXTURE_SIZE, TEXTURE_SIZE);
+
+    /* torus, a single instance at the center of the scene */
+    doughnut(batch, 0.25f, 0.75f, 50, 50);
+    if (0 > batch.compile(torusMesh))
+    {
+        fprintf(gpFILE, "[%s] Failed to create torus mesh\n", __func__);
+        return -1;
+    }
+    fprintf(gpFILE, "%-20s:%d vertices, %d indices\n", "Torus", batch.vertexCount(), batch.indexCount());
+    Instance torus = {vmath::translate(0.0f, 1.0f, 0.0f), materialRed, colorBlack, TEXTURE_LAYER_WHITE};
+    torusMesh.setInstances(&torus, 1);
+
+    /* ground */
+    batch.reset();
+    drawSurface(batch);
+    if (0 > batch.compile(groundMesh))
+    {
+        fprintf(gpFILE, "[%s] Failed to create ground mesh\n", __func__);
+        return -1;
+    }
+    fprintf(gpFILE, "%-20s:%d vertices, %d indices\n", "Ground", batch.vertexCount(), batch.indexCount());
+    Instance ground = {vmath::mat4::identity(), floorDiffuse, colorBlack, TEXTURE_LAYER_WHITE};
+    groundMesh.setInstances(&ground, 1);
+
+    /* sphere, fewer tessellation steps in stress mode to keep the test vertex bound at a sane level */
+    if (0 == nStressSpheres)
+        generateSphere(vertices, indices, 0.2f, 50, 50);
+    else
+        generateSphere(vertices, indices, 0.2f, 12, 8);
+    if (0 != sphereMesh.initialize(vertices.data(), vertices.size(), indices.data(), indices.size()))
+    {
+        fprintf(gpFILE, "[%s] Failed to create sphere mesh\n", __func__);
+        return -1;
+    }
+
+    /* random orbits for stress test */
+    const vmath::vec4 palette[] = {materialYellow, materialGreen, materialCyan, materialBlue};
+    orbits.resize(nStressSpheres);
+    for (GLsizei idx = 0; idx < nStressSpheres; ++idx)
+    {
+        vmath::vec3 axis   = vmath::normalize(vmath::vec3(randomFloat(-1.0f, 1.0f), randomFloat(0.2f, 1.0f), randomFloat(-1.0f, 1.0f)));
+        vmath::vec3 u      = vmath::normalize(vmath::cross(axis, vmath::vec3(0.0f, 0.0f, 1.0f)));
+        vmath::vec3 v      = vmath::cross(axis, u);
+        GLfloat     radius = randomFloat(1.2f, 4.0f);
+
+        orbits[idx].u     = u * radius;
+        orbits[idx].v     = v * radius;
+        orbits[idx].phase = randomFloat(0.0f, 2.0f * M_PI);
+        orbits[idx].speed = randomFloat(0.2f, 1.5f);
+        orbits[idx].color = palette[idx % 4];
+        orbits[idx].layer = sphereLayers[idx % TEXTURE_PATTERNS];
+    }
+    fprintf(gpFILE, "%-20s:%d\n", "Stress spheres", nStressSpheres);
+    fprintf(gpFILE, "%-20s:%.2f MiB in %u objects\n", "GPU memory", resourceRegistry.liveBytes() / (1024.0 * 1024.0), (unsigned)resourceRegistry.liveCount());
+    resourceRegistry.printRecords(gpFILE);
+    sphereBounds.resize(4 + nStressSpheres);
+
+    glClearColor(0.0f, 0.0f, 0.2f, 1.0f);
+    glClearDepth(1.0f);      // this bit will be set in depth buffer after calling glClear()
+    glEnable(GL_DEPTH_TEST); // Hidden surface removal
+    glFrontFace(GL_CCW);     // Counterclockwise Winding
+    glEnable(GL_CULL_FACE);  // Do not calculate inside of objects
+
+    View = vmath::lookat(vmath::vec3(xPos, yPos, zPos), vmath::vec3(0.0f, 0.0f, 0.0f), vmath::vec3(0.0f, 1.0f, 0.0f));
+    resize(WIN_WIDTH, WIN_HEIGHT);
+    return (0);
+}
+
+void uninitialize()
+{
+    sphereMesh.uninitialize();
+    groundMesh.uninitialize();
+    torusMesh.uninitialize();
+    texturePool.uninitialize();
+    frameRing.uninitialize();
+    shaderManager.uninitialize();
+    program = 0U;
+
+    /* every owner above released its storage, anything left was leaked */
+    resourceRegistry.reportLeaks(gpFILE);
+}
+
+void resize(int32_t width, int32_t height)
+{
+    if (height <= 0)
+        height = 1;
+
+    Projection = vmath::perspective(45.0f, (float)width / (float)height, 0.1f, FAR_PLANE);
+    glViewport(0, 0, (GLsizei)width, (GLsizei)height);
+}
+
+/* connect PassData block of a freshly linked program to its binding point */
+static void onProgramLinked(GLuint linked)
+{
+    GLuint blockIndex = glGetUniformBlockIndex(linked, "PassData");
+    if (GL_INVALID_INDEX == blockIndex)
+    {
+        fprintf(gpFILE, "[%s] PassData block not found in program\n", __func__);
+        return;
+    }
+    glUniformBlockBinding(linked, blockIndex, PASS_DATA_BINDING);
+}
+
+static void reportProgramLoad()
+{
+    const ProgramCacheStats &cacheStats = programCache.stats;
+
+    fprintf(gpFILE, "%-20s:%u\n", "Scene variants", sceneVariants.variantCount());
+
+    /* cold start compiles, warm start restores binaries, the cold time of those binaries is shown for comparison */
+    if (0U < cacheStats.hits)
+        fprintf(gpFILE, "%-20s:warm %.3f ms [binary %.3f ms], cold %.3f ms\n", "Program load", now() - programStart, cacheStats.loadMs, cacheStats.coldMs);
+    else
+        fprintf(gpFILE, "%-20s:cold %.3f ms [compile %.3f ms], %u stale binaries\n", "Program load", now() - programStart, cacheStats.compileMs, cacheStats.rejected);
+}
+
+/* copy current pass data to the frame ring and bind it, draws issued before keep their copy */
+static void commitPassData()
+{
+    GLintptr offset = 0;
+    void    *dst    = frameRing.allocate(sizeof(PassData), uniformAlignment, &offset);
+
+    if (nullptr == dst)
+        return;
+
+    memcpy(dst, &passData, sizeof(PassData));
+    glBindBufferRange(GL_UNIFORM_BUFFER, PASS_DATA_BINDING, frameRing.buffer(), offset, sizeof(PassData));
+}
+
+static void enableClipping()
+{
+    if (true == isClippingEnabled)
+    {
+        glEnable(GL_CLIP_DISTANCE0);
+        passData.clipPlane = planeEquation;
+    }
+}
+
+static void disableClipping()
+{
+    if (true == isClippingEnabled)
+    {
+        glDisable(GL_CLIP_DISTANCE0);
+        passData.clipPlane = noClipPlane;
+    }
+}
+
+/* create stencil */
+static void beginStencilPass(StateCache &state)
+{
+    (void)state;
+    glDisable(GL_DEPTH_TEST);
+    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+
+    glEnable(GL_STENCIL_TEST);
+    glStencilOp(GL_REPLACE, GL_REPLACE, GL_REPLACE);
+    glStencilFunc(GL_ALWAYS, 1, 0xffffffff);
+}
+
+static void endStencilPass(StateCache &state)
+{
+    (void)state;
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    glEnable(GL_DEPTH_TEST);
+    glStencilFunc(GL_EQUAL, 1, 0xffffffff);
+    glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+}
+
+/* draw reflection */
+static void beginReflectionPass(StateCache &state)
+{
+    (void)state;
+    passData.pre = vmath::scale(1.0f, -1.0f, 1.0f);
+    enableClipping();
+    commitPassData();
+    glFrontFace(GL_CW);
+}
+
+static void endReflectionPass(StateCache &state)
+{
+    (void)state;
+    glFrontFace(GL_CCW);
+    disableClipping();
+    passData.pre = vmath::mat4::identity();
+    commitPassData();
+}
+
+/* draw real ground */
+static void beginGroundPass(StateCache &state)
+{
+    (void)state;
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+}
+
+static void endGroundPass(StateCache &state)
+{
+    (void)state;
+    glDisable(GL_BLEND);
+    if (true == isStencilEnabled)
+    {
+        glStencilOp(GL_KEEP, GL_KEEP, GL_INCR);
+    }
+}
+
+/* draw shadow */
+static void beginShadowPass(StateCache &state)
+{
+    (void)state;
+    glDisable(GL_DEPTH_TEST);
+    passData.pre = shadowMatrix;
+    commitPassData();
+}
+
+static void endShadowPass(StateCache &state)
+{
+    (void)state;
+    passData.pre = vmath::mat4::identity();
+    commitPassData();
+    glEnable(GL_DEPTH_TEST);
+}
+
+/* draw original scene */
+static void beginScenePass(StateCache &state)
+{
+    (void)state;
+    if (true == isStencilEnabled)
+    {
+        glDisable(GL_STENCIL_TEST);
+    }
+    enableClipping();
+    commitPassData();
+}
+
+static void endScenePass(StateCache &state)
+{
+    (void)state;
+    disableClipping();
+    commitPassData();
+}
+
+/* normalized distance from camera, used for the depth bits of sort key */
+static float viewDepth(const vmath::vec3 &position)
+{
+    return vmath::distance(position, vmath::vec3(xPos, yPos, zPos)) / FAR_PLANE;
+}
+
+void display()
+{
+    /* variants are requested the first time a pass needs them, fallback is drawn until they are linked */
+    uint32_t nCompleted    = shaderManager.poll();
+    GLuint   sceneProgram  = sceneVariants.program(0U);
+    GLuint   shadowProgram = 0U;
+
+    /* binaries restored from the cache are ready on submission and never complete in poll() */
+    if (0U < nCompleted || (false == isSceneProgramReady && program != sceneProgram))
+    {
+        reportProgramLoad();
+    }
+    isSceneProgramReady = program != sceneProgram;
+
+    renderQueue.setProgram(programId, sceneProgram);
+    if (true == isShadowEnabled)
+    {
+        shadowProgram = sceneVariants.program(featureShadow);
+        renderQueue.setProgram(shadowProgramId, shadowProgram);
+    }
+
+    stateCache.invalidate();
+    stateCache.resetStats();
+
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+    passData.view          = View;
+    passData.projection    = Projection;
+    passData.pre           = vmath::mat4::identity();
+    passData.lightPosition = lightPosition;
+    passData.clipPlane     = noClipPlane;
+    commitPassData();
+
+    if (true == isStencilEnabled)
+    {
+        renderQueue.submit(PASS_STENCIL, programId, textureMaterial, MESH_GROUND, viewDepth(vmath::vec3(0.0f, 0.0f, 0.0f)), &groundMesh);
+    }
+
+    if (true == isReflectionEnabled)
+    {
+        drawScene(PASS_REFLECTION);
+    }
+
+    renderQueue.submit(PASS_GROUND, programId, textureMaterial, MESH_GROUND, viewDepth(vmath::vec3(0.0f, 0.0f, 0.0f)), &groundMesh);
+
+    /* the fallback has no unlit path, shadows are left out until their variant is linked */
+    if (true == isShadowEnabled && program != shadowProgram)
+    {
+        drawScene(PASS_SHADOW);
+    }
+
+    drawScene(PASS_SCENE);
+
+    renderQueue.flush(stateCache);
+    frameRing.endFrame();
+    stateCache.bindVertexArray(0U);
+    stateCache.useProgram(0U);
+}
+
+static void drawScene(uint32_t pass)
+{
+    /* shadows use the unlit SHADOW variant */
+    uint32_t id = PASS_SHADOW == pass ? shadowProgramId : programId;
+
+    if (true == isTorusVisible && true == isTorusInView)
+    {
+        renderQueue.submit(pass, id, textureMaterial, MESH_TORUS, viewDepth(vmath::vec3(0.0f, 1.0f, 0.0f)), &torusMesh);
+    }
+
+    /* every sphere, named or stress, goes out in a single instanced draw */
+    renderQueue.submit(pass, id, textureMaterial, MESH_SPHERE, viewDepth(vmath::vec3(0.0f, 1.0f, 0.0f)), &sphereMesh);
+}
+
+/* clip volumes of every enabled pass, objects seen by none of them are culled */
+static uint32_t buildFrusta(Frustum frusta[3])
+{
+    const vmath::mat4 viewProjection = Projection * View;
+    uint32_t          nFrusta        = 0U;
+
+    frusta[nFrusta++].extract(viewProjection);
+    if (true == isReflectionEnabled)
+    {
+        frusta[nFrusta++].extract(viewProjection * vmath::scale(1.0f, -1.0f, 1.0f));
+    }
+    if (true == isShadowEnabled)
+    {
+        frusta[nFrusta++].extract(viewProjection * shadowMatrix);
+    }
+    return nFrusta;
+}
+
+void update()
+{
+    const vmath::mat4 center  = vmath::translate(0.0f, 1.0f, 0.0f);
+    const vmath::mat4 offset  = vmath::translate(0.0f, 0.0f, 1.0f);
+    const bool        shown[] = {isYellowVisible, isGreenVisible, isCyanVisible, isBlueVisible};
+    int               r       = 3;
+    Instance          named[4];
+    Instance         *spheres = nullptr;
+    Frustum           frusta[3];
+    uint32_t          nFrusta = 0U;
+
+    /* waits only if the GPU has not finished with the region written three frames ago */
+    frameRing.beginFrame();
+
+    lightAngle += 0.01;
+    if (lightAngle >= 360.0f)
+    {
+        lightAngle -= 360.0f;
+    }
+
+    sphereAngle += 0.5;
+    if (sphereAngle >= 360.0f)
+    {
+        sphereAngle -= 360.0f;
+    }
+
+    lightPosition[0] = r * sinf(lightAngle);
+    lightPosition[2] = r * cosf(lightAngle);
+    setShadowMatrix(shadowMatrix, lightPosition, planeEquation);
+    View = vmath::lookat(vmath::vec3(xPos, yPos, zPos), vmath::vec3(0.0f, 0.0f, 0.0f), vmath::vec3(0.0f, 1.0f, 0.0f));
+
+    /* the four spheres of the original scene */
+    named[0] = {center * vmath::translate(0.0f, 1.0f, 0.0f) * vmath::rotate(-sphereAngle + 90.0f, 1.0f, 0.0f, 0.0f) * offset, colorBlack, materialYellow, sphereLayers[0]};
+    named[1] = {center * vmath::translate(1.0f, 0.0f, 0.0f) * vmath::rotate(sphereAngle, 0.0f, 1.0f, 0.0f) * offset, colorBlack, materialGreen, sphereLayers[1]};
+    named[2] = {center * vmath::translate(0.0f, -1.0f, 0.0f) * vmath::rotate(sphereAngle + 180.0f, 1.0f, 0.0f, 0.0f) * offset, colorBlack, materialCyan, sphereLayers[2]};
+    named[3] = {center * vmath::translate(-1.0f, 0.0f, 0.0f) * vmath::rotate(-sphereAngle + 270.0f, 0.0f, 1.0f, 0.0f) * offset, colorBlack, materialBlue, sphereLayers[3]};
+    for (int idx = 0; idx < 4; ++idx)
+    {
+        sphereBounds[idx] = vmath::vec4(named[idx].model[3][0], named[idx].model[3][1], named[idx].model[3][2], SPHERE_RADIUS);
+    }
+
+    /* stress spheres move along their orbits */
+    const GLfloat theta = vmath::radians(sphereAngle);
+    for (GLsizei idx = 0; idx < nStressSpheres; ++idx)
+    {
+        const Orbit &orbit = orbits[idx];
+        GLfloat      angle = orbit.phase + theta * orbit.speed;
+        vmath::vec3  pos   = orbit.u * cosf(angle) + orbit.v * sinf(angle);
+
+        sphereBounds[4 + idx] = vmath::vec4(pos[0], pos[1] + 1.0f, pos[2], SPHERE_RADIUS);
+    }
+
+    /* spheres only move a little per frame, refitting is enough until boxes get too loose */
+    if (sphereBvh.objectCount() != sphereBounds.size() || true == sphereBvh.refit(sphereBounds.data()))
+    {
+        sphereBvh.build(sphereBounds.data(), sphereBounds.size());
+    }
+
+    memset(&cullStats, 0, sizeof(cullStats));
+    nFrusta = buildFrusta(frusta);
+    sphereBvh.cull(frusta, nFrusta, sphereBounds.data(), visibleSpheres, &cullStats);
+
+    isTorusInView = false;
+    for (uint32_t f = 0U; f < nFrusta && false == isTorusInView; ++f)
+    {
+        isTorusInView = frusta[f].testSphere(0.0f, 1.0f, 0.0f, TORUS_RADIUS);
+    }
+    cullStats.objects++;
+    if (true == isTorusInView)
+        cullStats.visible++;
+    else
+        cullStats.culled++;
+
+    /* drop named spheres switched off from keyboard */
+    size_t nVisible = 0U;
+    for (size_t idx = 0U; idx < visibleSpheres.size(); ++idx)
+    {
+        uint32_t object = visibleSpheres[idx];
+        if (object >= 4U || true == shown[object])
+            visibleSpheres[nVisible++] = object;
+    }
+    visibleSpheres.resize(nVisible);
+
+    /* only visible instances are written, straight into mapped memory */
+    spheres = sphereMesh.streamInstances(frameRing, nVisible);
+    if (nullptr == spheres)
+    {
+        return;
+    }
+
+    for (size_t idx = 0U; idx < nVisible; ++idx)
+    {
+        uint32_t object = visibleSpheres[idx];
+        if (object < 4U)
+        {
+            *spheres++ = named[object];
+            continue;
+        }
+
+        /* stress spheres, only a translation so build the matrix directly */
+        const vmath::vec4 &bounds = sphereBounds[object];
+        spheres->model            = vmath::translate(bounds[0], bounds[1], bounds[2]);
+        spheres->diffuse          = colorBlack;
+        spheres->emission         = orbits[object - 4U].color;
+        spheres->layer            = orbits[object - 4U].layer;
+        spheres++;
+    }
+}
+
+static void quadloop(ImmediateBatch &batch, GLfloat r, GLfloat R, GLint nsides, GLfloat sideDelta, GLfloat cosTheta, GLfloat sinTheta, GLfloat cosTheta1, GLfloat sinTheta1)
+{
+    GLfloat dist;
+    GLfloat phi;
+    int     j;
+
+    batch.begin(GL_QUAD_STRIP);
+
+    dist = R + r;
+    batch.normal3f(cosTheta1, -sinTheta1, 0);
+    batch.vertex3f(cosTheta1 * dist, -sinTheta1 * dist, 0);
+    batch.normal3f(cosTheta, -sinTheta, 0);
+    batch.vertex3f(cosTheta * dist, -sinTheta * dist, 0);
+
+    phi = sideDelta;
+    for (j = nsides - 2; j >= 0; j--)
+    {
+        GLfloat cosPhi, sinPhi;
+
+        cosPhi = cos(phi);
+        sinPhi = sin(phi);
+        dist   = R + r * cosPhi;
+
+        batch.normal3f(cosTheta1 * cosPhi, -sinTheta1 * cosPhi, sinPhi);
+        batch.vertex3f(cosTheta1 * dist, -sinTheta1 * dist, r * sinPhi);
+        batch.normal3f(cosTheta * cosPhi, -sinTheta * cosPhi, sinPhi);
+        batch.vertex3f(cosTheta * dist, -sinTheta * dist, r * sinPhi);
+        phi += sideDelta;
+    }
+
+    /* Repeat first two vertices to seam up each quad strip loop so no cracks. */
+    dist = R + r;
+    batch.normal3f(cosTheta1, -sinTheta1, 0);
+    batch.vertex3f(cosTheta1 * dist, -sinTheta1 * dist, 0);
+    batch.normal3f(cosTheta, -sinTheta, 0);
+    batch.vertex3f(cosTheta * dist, -sinTheta * dist, 0);
+
+    batch.end();
+}
+
+static void doughnut(ImmediateBatch &batch, GLfloat r, GLfloat R, GLint nsides, GLint rings)
+{
+    const GLfloat ringDelta = 2.0 * M_PI / rings;
+    const GLfloat sideDelta = 2.0 * M_PI / nsides;
+
+    GLfloat theta, theta1;
+    GLfloat cosTheta, sinTheta;
+    GLfloat cosTheta1, sinTheta1;
+    int     i;
+
+    theta    = 0.0;
+    cosTheta = 1.0;
+    sinTheta = 0.0;
+    for (i = rings - 2; i >= 0; i--)
+    {
+        theta1    = theta + ringDelta;
+        cosTheta1 = cos(theta1);
+        sinTheta1 = sin(theta1);
+
+        quadloop(batch, r, R, nsides, sideDelta, cosTheta, sinTheta, cosTheta1, sinTheta1);
+
+        theta    = theta1;
+        cosTheta = cosTheta1;
+        sinTheta = sinTheta1;
+    }
+
+    cosTheta1 = 1.0;
+    sinTheta1 = 0.0;
+    quadloop(batch, r, R, nsides, sideDelta, cosTheta, sinTheta, cosTheta1, sinTheta1);
+}
+
+static void drawSurface(ImmediateBatch &batch)
+{
+    GLfloat fExtent = 4.0f;
+    GLfloat fStep   = 0.5f;
+    GLfloat y       = 0.0f;
+    GLfloat iStrip, iRun;
+
+    for (iStrip = -fExtent; iStrip <= fExtent; iStrip += fStep)
+    {
+        batch.begin(GL_TRIANGLE_STRIP);
+        batch.normal3f(0.0f, 1.0f, 0.0f);
+        for (iRun = fExtent; iRun >= -fExtent; iRun -= fStep)
+        {
+            batch.texCoord2f(iStrip * 0.5f, iRun * 0.5f);
+            batch.vertex3f(iStrip, y, iRun);
+            batch.texCoord2f((iStrip + fStep) * 0.5f, iRun * 0.5f);
+            batch.vertex3f(iStrip + fStep, y, iRun);
+        }
+        batch.end();
+    }
+}
+
+static void toggleFullscreen(Display *display, Window window)
+{
+    XEvent event;
+
+    Atom wm_state   = XInternAtom(display, "_NET_WM_STATE", False);
+    Atom fullscreen = XInternAtom(display, "_NET_WM_STATE_FULLSCREEN", False);
+
+    event.xclient.type         = ClientMessage;
+    event.xclient.serial       = 0;
+    event.xclient.send_event   = True;
+    event.xclient.message_type = wm_state;
+    event.xclient.format       = 32;
+    event.xclient.window       = window;
+    event.xclient.data.l[0]    = 2; // _NET_WM_STATE_TOGGLE
+    event.xclient.data.l[1]    = fullscreen;
+    event.xclient.data.l[2]    = 0;
+
+    XSendEvent(display, DefaultRootWindow(display), False, SubstructureRedirectMask | SubstructureNotifyMask, &event);
+}
+
+static void setShadowMatrix(vmath::mat4 &destMat, const vmath::vec4 &lightPos, const vmath::vec4 &plane)
+{
+    GLfloat dot;
+
+    // dot product of plane and light position
+    dot = plane[0] * lightPos[0] + plane[1] * lightPos[1] + plane[2] * lightPos[2];
+
+    // first row
+    destMat[0][0] = dot - plane[0] * lightPos[0];
+    destMat[1][0] = 0.0f - lightPos[0] * plane[1];
+    destMat[2][0] = 0.0f - lightPos[0] * plane[2];
+    destMat[3][0] = 0.0f - lightPos[0] * plane[3];
+
+    // second row
+    destMat[0][1] = 0.0f - lightPos[1] * plane[0];
+    destMat[1][1] = dot - lightPos[1] * plane[1];
+    destMat[2][1] = 0.0f - lightPos[1] * plane[2];
+    destMat[3][1] = 0.0f - lightPos[1] * plane[3];
+
+    // third row
+    destMat[0][2] = 0.0f - lightPos[2] * plane[0];
+    destMat[1][2] = 0.0f - lightPos[2] * plane[1];
+    destMat[2][2] = dot - lightPos[2] * plane[2];
+    destMat[3][2] = 0.0f - lightPos[2] * plane[3];
+
+    // fourth row
+    destMat[0][3] = 0.0f - lightPos[3] * plane[0];
+    destMat[1][3] = 0.0f - lightPos[3] * plane[1];
+    destMat[2][3] = 0.0f - lightPos[3] * plane[2];
+    destMat[3][3] = dot - lightPos[3] * plane[3];
+}
+
+static void printReport()
+{
+    const RenderStats &stats   = stateCache.stats;
+    double             avgMs   = frameStats.nFrames ? frameStats.totalMs / frameStats.nFrames : 0.0;
+    uint32_t           issued  = stats.programChanges + stats.textureChanges + stats.vertexArrayChanges;
+    uint32_t           avoided = stats.programSkipped + stats.textureSkipped + stats.vertexArraySkipped;
+
+    fprintf(gpFILE, "spheres: %7d | draw calls: %2u | frame: avg %7.3f ms min %7.3f ms max %7.3f ms\n", sphereMesh.instanceCount(), stats.drawCalls, avgMs, frameStats.nFrames ? frameStats.minMs : 0.0,
+            frameStats.maxMs);
+    fprintf(gpFILE, "    packets: %u | passes: %u | binds issued: %u [program %u, vao %u, texture %u] | avoided: %u [program %u, vao %u, texture %u]\n", stats.packets, stats.passChanges, issued, stats.programChanges,
+            stats.vertexArrayChanges, stats.textureChanges, avoided, stats.programSkipped, stats.vertexArraySkipped, stats.textureSkipped);
+    fprintf(gpFILE, "    ring: %ld of %ld bytes | stalls: %u\n", (long)frameRing.used(), (long)frameRing.capacity(), frameRing.stalls());
+    fprintf(gpFILE, "    objects: %u | visible: %u | culled: %u | bvh nodes tested: %u\n", cullStats.objects, cullStats.visible, cullStats.culled, cullStats.nodesVisited);
+    resourceRegistry.printSummary(gpFILE);
+}
+
+/* grey scale patterns, bright enough that tinted colors stay recognizable */
+static void generatePattern(int pattern, std::vector<unsigned char> &rgba)
+{
+    rgba.resize(TEXTURE_SIZE * TEXTURE_SIZE * 4);
+    for (int y = 0; y < TEXTURE_SIZE; ++y)
+    {
+        for (int x = 0; x < TEXTURE_SIZE; ++x)
+        {
+            int  dx = x % 16 - 8, dy = y % 16 - 8;
+            bool on = false;
+            switch (pattern)
+            {
+                case 0: // checker board
+                    on = ((x / 8) + (y / 8)) & 1;
+                    break;
+                case 1: // stripes along u
+                    on = (x / 4) & 1;
+                    break;
+                case 2: // dots
+                    on = dx * dx + dy * dy < 20;
+                    break;
+                default: // stripes along v
+                    on = (y / 8) & 1;
+                    break;
+            }
+
+            unsigned char *texel = &rgba[(y * TEXTURE_SIZE + x) * 4];
+            texel[0] = texel[1] = texel[2] = on ? 0xff : 0x60;
+            texel[3]                       = 0xff;
+        }
+    }
+}
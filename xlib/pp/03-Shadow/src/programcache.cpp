@@ -0,0 +1,197 @@
+/**
+ * @file      programcache.cpp
+ * @brief     On-disk cache of linked program binaries
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <sys/stat.h>
+#include <vector>
+
+#include "programcache.h"
+
+/* "PBIN" */
+#define PROGRAM_CACHE_MAGIC   0x4e494250U
+#define PROGRAM_CACHE_VERSION 1U
+
+/**
+ * @brief Header in front of the binary in every cache file
+ */
+struct ProgramCacheHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;       // guards against hash collisions in file names
+    uint32_t format;    // binary format returned by the driver
+    uint32_t length;    // bytes of binary following the header
+    double   compileMs; // cold build time of this program
+};
+
+/* 64 bit FNV-1a */
+static uint64_t hashBytes(const void *data, size_t size, uint64_t hash = 14695981039346656037ULL)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+    for (size_t idx = 0U; idx < size; ++idx)
+    {
+        hash ^= bytes[idx];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static double now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+ProgramCache::ProgramCache() : isEnabled(false)
+{
+    memset(&stats, 0, sizeof(stats));
+}
+
+int ProgramCache::initialize(const char *directory)
+{
+    GLint nFormats = 0;
+
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &nFormats);
+    if (0 >= nFormats)
+    {
+        fprintf(stderr, "[%s] driver offers no program binary formats, cache disabled\n", __func__);
+        return -1;
+    }
+
+    if (0 != mkdir(directory, 0755) && EEXIST != errno)
+    {
+        fprintf(stderr, "[%s] failed to create %s: %s\n", __func__, directory, strerror(errno));
+        return -1;
+    }
+
+    this->directory = directory;
+    driver          = std::string((const char *)glGetString(GL_VENDOR)) + "|" + (const char *)glGetString(GL_RENDERER) + "|" + (const char *)glGetString(GL_VERSION);
+    isEnabled       = true;
+    return 0;
+}
+
+uint64_t ProgramCache::key(const std::string *sources, uint32_t nSources) const
+{
+    uint64_t hash = hashBytes(driver.data(), driver.size());
+
+    /* length first so that moving text between stages changes the key */
+    for (uint32_t idx = 0U; idx < nSources; ++idx)
+    {
+        uint64_t length = sources[idx].size();
+        hash            = hashBytes(&length, sizeof(length), hash);
+        hash            = hashBytes(sources[idx].data(), sources[idx].size(), hash);
+    }
+    return hash;
+}
+
+std::string ProgramCache::path(uint64_t key) const
+{
+    char name[32];
+    snprintf(name, sizeof(name), "/%016llx.bin", (unsigned long long)key);
+    return directory + name;
+}
+
+GLuint ProgramCache::load(uint64_t key)
+{
+    ProgramCacheHeader header;
+    std::vector<char>  binary;
+    GLuint             program = 0U;
+    GLint              status  = GL_FALSE;
+    double             start   = now();
+
+    if (false == isEnabled)
+        return 0U;
+
+    std::string filename = path(key);
+    FILE       *file     = fopen(filename.c_str(), "rb");
+    if (nullptr == file)
+        return 0U;
+
+    bool valid = 1U == fread(&header, sizeof(header), 1U, file) && PROGRAM_CACHE_MAGIC == header.magic && PROGRAM_CACHE_VERSION == header.version && key == header.key && 0U < header.length;
+    if (true == valid)
+    {
+        binary.resize(header.length);
+        valid = 1U == fread(binary.data(), header.length, 1U, file);
+    }
+    fclose(file);
+
+    if (true == valid)
+    {
+        program = glCreateProgram();
+        glProgramBinary(program, header.format, binary.data(), header.length);
+        glGetProgramiv(program, GL_LINK_STATUS, &status);
+    }
+
+    if (GL_TRUE != status)
+    {
+        /* stale or corrupt entry, compiled again and overwritten by the caller */
+        if (program)
+            glDeleteProgram(program);
+        remove(filename.c_str());
+        stats.rejected++;
+        return 0U;
+    }
+
+    stats.hits++;
+    stats.loadMs += now() - start;
+    stats.coldMs += header.compileMs;
+    return program;
+}
+
+void ProgramCache::store(uint64_t key, GLuint program, double compileMs)
+{
+    ProgramCacheHeader header;
+    std::vector<char>  binary;
+    GLint              length = 0;
+    GLenum             format = 0;
+
+    stats.misses++;
+    stats.compileMs += compileMs;
+    if (false == isEnabled)
+        return;
+
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (0 >= length)
+        return;
+
+    binary.resize(length);
+    glGetProgramBinary(program, length, &length, &format, binary.data());
+
+    header.magic     = PROGRAM_CACHE_MAGIC;
+    header.version   = PROGRAM_CACHE_VERSION;
+    header.key       = key;
+    header.format    = format;
+    header.length    = length;
+    header.compileMs = compileMs;
+
+    std::string filename  = path(key);
+    std::string temporary = filename + ".tmp";
+    FILE       *file      = fopen(temporary.c_str(), "wb");
+    if (nullptr == file)
+    {
+        fprintf(stderr, "[%s] failed to open %s\n", __func__, temporary.c_str());
+        return;
+    }
+
+    bool written = 1U == fwrite(&header, sizeof(header), 1U, file) && 1U == fwrite(binary.data(), length, 1U, file);
+    if (0 != fclose(file) || false == written || 0 != rename(temporary.c_str(), filename.c_str()))
+    {
+        fprintf(stderr, "[%s] failed to write %s\n", __func__, filename.c_str());
+        remove(temporary.c_str());
+    }
+}
@@ -0,0 +1,176 @@
+/**
+ * @file      renderqueue.cpp
+ * @brief     Sorted queue of draw packets
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <cstdio>
+#include <cstring>
+
+#include "renderqueue.h"
+
+#define RADIX_BITS    8
+#define RADIX_BUCKETS (1U << RADIX_BITS)
+
+RenderQueue::RenderQueue()
+{
+    memset(passes, 0, sizeof(passes));
+
+    /* material 0 is untextured */
+    Material none = {GL_TEXTURE_2D, 0U};
+    materials.push_back(none);
+}
+
+uint32_t RenderQueue::addProgram(GLuint program)
+{
+    if (programs.size() >= MAX_PROGRAMS)
+    {
+        fprintf(stderr, "[%s] too many programs\n", __func__);
+        return 0U;
+    }
+    programs.push_back(program);
+    return programs.size() - 1U;
+}
+
+void RenderQueue::setProgram(uint32_t id, GLuint program)
+{
+    if (id < programs.size())
+    {
+        programs[id] = program;
+    }
+}
+
+uint32_t RenderQueue::addMaterial(GLuint texture, GLenum target)
+{
+    if (materials.size() >= MAX_MATERIALS)
+    {
+        fprintf(stderr, "[%s] too many materials\n", __func__);
+        return 0U;
+    }
+    Material material = {target, texture};
+    materials.push_back(material);
+    return materials.size() - 1U;
+}
+
+void RenderQueue::setPass(uint32_t pass, const RenderPass &renderPass)
+{
+    if (pass < MAX_PASSES)
+    {
+        passes[pass] = renderPass;
+    }
+}
+
+uint64_t RenderQueue::makeKey(uint32_t pass, uint32_t program, uint32_t material, uint32_t meshId, uint32_t depth)
+{
+    return ((uint64_t)(pass & ((1U << KEY_PASS_BITS) - 1U)) << KEY_PASS_SHIFT) |         //
+           ((uint64_t)(program & ((1U << KEY_PROGRAM_BITS) - 1U)) << KEY_PROGRAM_SHIFT) | //
+           ((uint64_t)(material & ((1U << KEY_MATERIAL_BITS) - 1U)) << KEY_MATERIAL_SHIFT) | //
+           ((uint64_t)(meshId & ((1U << KEY_MESH_BITS) - 1U)) << KEY_MESH_SHIFT) |        //
+           ((uint64_t)(depth & ((1U << KEY_DEPTH_BITS) - 1U)) << KEY_DEPTH_SHIFT);
+}
+
+void RenderQueue::submit(uint32_t pass, uint32_t program, uint32_t material, uint32_t meshId, float depth, const InstancedMesh *mesh)
+{
+    const uint32_t maxDepth = (1U << KEY_DEPTH_BITS) - 1U;
+    uint32_t       quantized;
+
+    if (pass >= MAX_PASSES || program >= programs.size() || material >= materials.size() || nullptr == mesh)
+    {
+        fprintf(stderr, "[%s] invalid packet dropped\n", __func__);
+        return;
+    }
+
+    if (depth < 0.0f)
+        depth = 0.0f;
+    if (depth > 1.0f)
+        depth = 1.0f;
+    quantized = (uint32_t)(depth * maxDepth);
+
+    /* translucent passes draw far to near */
+    if (passes[pass].backToFront)
+        quantized = maxDepth - quantized;
+
+    DrawPacket packet = {makeKey(pass, program, material, meshId, quantized), mesh};
+    packets.push_back(packet);
+}
+
+/* least significant digit radix sort, digits on which all keys agree are skipped */
+void RenderQueue::sort()
+{
+    const size_t n = packets.size();
+    size_t       histogram[RADIX_BUCKETS];
+
+    scratch.resize(n);
+    for (uint32_t shift = 0U; shift < 64U; shift += RADIX_BITS)
+    {
+        memset(histogram, 0, sizeof(histogram));
+        for (size_t idx = 0U; idx < n; ++idx)
+            histogram[(packets[idx].key >> shift) & (RADIX_BUCKETS - 1U)]++;
+
+        if (histogram[(packets[0].key >> shift) & (RADIX_BUCKETS - 1U)] == n)
+            continue;
+
+        /* exclusive prefix sum gives the first slot of each bucket */
+        size_t offset = 0U;
+        for (uint32_t bucket = 0U; bucket < RADIX_BUCKETS; ++bucket)
+        {
+            size_t count      = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += count;
+        }
+
+        for (size_t idx = 0U; idx < n; ++idx)
+            scratch[histogram[(packets[idx].key >> shift) & (RADIX_BUCKETS - 1U)]++] = packets[idx];
+
+        packets.swap(scratch);
+    }
+}
+
+void RenderQueue::flush(StateCache &state)
+{
+    uint32_t currentPass = MAX_PASSES;
+
+    if (packets.empty())
+        return;
+
+    sort();
+    state.stats.packets += packets.size();
+
+    for (size_t idx = 0U; idx < packets.size(); ++idx)
+    {
+        const DrawPacket &packet   = packets[idx];
+        uint32_t          pass     = (packet.key >> KEY_PASS_SHIFT) & ((1U << KEY_PASS_BITS) - 1U);
+        uint32_t          program  = (packet.key >> KEY_PROGRAM_SHIFT) & ((1U << KEY_PROGRAM_BITS) - 1U);
+        uint32_t          material = (packet.key >> KEY_MATERIAL_SHIFT) & ((1U << KEY_MATERIAL_BITS) - 1U);
+
+        if (pass != currentPass)
+        {
+            if (currentPass < MAX_PASSES && passes[currentPass].end)
+                passes[currentPass].end(state);
+
+            currentPass = pass;
+            state.stats.passChanges++;
+            if (passes[currentPass].begin)
+                passes[currentPass].begin(state);
+        }
+
+        state.useProgram(programs[program]);
+        if (0U != material)
+            state.bindTexture(0U, materials[material].target, materials[material].texture);
+
+        state.stats.drawCalls += packet.mesh->draw(state);
+    }
+
+    if (passes[currentPass].end)
+        passes[currentPass].end(state);
+
+    packets.clear();
+}
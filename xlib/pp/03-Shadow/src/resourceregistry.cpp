@@ -0,0 +1,191 @@
+/**
+ * @file      resourceregistry.cpp
+ * @brief     Bookkeeping of GPU memory held by buffers and textures
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include "resourceregistry.h"
+
+#define MIB(bytes) ((double)(bytes) / (1024.0 * 1024.0))
+
+ResourceRegistry resourceRegistry;
+
+ResourceRegistry::ResourceRegistry() : live(0), peak(0), budget(0), isOverBudget(false)
+{
+    for (int category = 0; category < RESOURCE_CATEGORIES; ++category)
+        perCategory[category] = 0;
+}
+
+void ResourceRegistry::setBudget(GLsizeiptr bytes)
+{
+    budget       = bytes;
+    isOverBudget = false;
+    checkBudget();
+}
+
+void ResourceRegistry::trackBuffer(GLuint name, ResourceCategory category, const char *owner, GLsizeiptr bytes)
+{
+    ResourceRecord record = {GL_BUFFER, name, category, owner, 0U, 0, 0, 0, 0, bytes};
+    add(record);
+}
+
+void ResourceRegistry::trackTexture(GLuint name, ResourceCategory category, const char *owner, GLenum format, GLsizei width, GLsizei height, GLsizei layers, GLint levels)
+{
+    ResourceRecord record = {GL_TEXTURE, name, category, owner, format, width, height, layers, levels, textureBytes(format, width, height, layers, levels)};
+    add(record);
+}
+
+void ResourceRegistry::release(GLenum kind, GLuint name)
+{
+    for (size_t idx = 0; idx < records.size(); ++idx)
+    {
+        if (records[idx].kind == kind && records[idx].name == name)
+        {
+            remove(idx);
+            return;
+        }
+    }
+}
+
+void ResourceRegistry::add(const ResourceRecord &record)
+{
+    /* re-specified storage replaces the old record */
+    release(record.kind, record.name);
+
+    records.push_back(record);
+    perCategory[record.category] += record.bytes;
+    live += record.bytes;
+    if (live > peak)
+        peak = live;
+    checkBudget();
+}
+
+void ResourceRegistry::remove(size_t idx)
+{
+    perCategory[records[idx].category] -= records[idx].bytes;
+    live -= records[idx].bytes;
+    records[idx] = records.back();
+    records.pop_back();
+    checkBudget();
+}
+
+void ResourceRegistry::checkBudget()
+{
+    if (0 == budget)
+        return;
+
+    if (!isOverBudget && live > budget)
+    {
+        const ResourceRecord &last = records.back();
+        fprintf(stderr, "[%s] %.2f MiB exceeds budget of %.2f MiB after %.2f MiB of %s for %s\n", __func__, MIB(live), MIB(budget), MIB(last.bytes), categoryName(last.category), last.owner);
+        isOverBudget = true;
+    }
+    else if (isOverBudget && live <= budget)
+    {
+        isOverBudget = false;
+    }
+}
+
+void ResourceRegistry::printSummary(FILE *pFile) const
+{
+    fprintf(pFile, "    gpu memory: %.2f MiB in %u objects | peak: %.2f MiB", MIB(live), (unsigned)records.size(), MIB(peak));
+    if (budget)
+        fprintf(pFile, " | budget: %.2f MiB%s", MIB(budget), live > budget ? " EXCEEDED" : "");
+    fprintf(pFile, " | KiB:");
+    for (int category = 0; category < RESOURCE_CATEGORIES; ++category)
+        fprintf(pFile, " %s %.1f", categoryName((ResourceCategory)category), perCategory[category] / 1024.0);
+    fprintf(pFile, "\n");
+}
+
+void ResourceRegistry::printRecords(FILE *pFile) const
+{
+    for (const ResourceRecord &record : records)
+    {
+        if (GL_BUFFER == record.kind)
+        {
+            fprintf(pFile, "    buffer  %4u %-8s %10ld bytes  %s\n", record.name, categoryName(record.category), (long)record.bytes, record.owner);
+        }
+        else
+        {
+            fprintf(pFile, "    texture %4u %-8s %10ld bytes  %s, %dx%dx%d, %d levels, format 0x%04x\n", record.name, categoryName(record.category), (long)record.bytes, record.owner, record.width, record.height,
+                    record.layers, record.levels, record.format);
+        }
+    }
+}
+
+size_t ResourceRegistry::reportLeaks(FILE *pFile) const
+{
+    if (records.empty())
+        return 0;
+
+    fprintf(pFile, "[%s] %u objects holding %.2f MiB were not released\n", __func__, (unsigned)records.size(), MIB(live));
+    printRecords(pFile);
+    return records.size();
+}
+
+/* bytes of one texel, 4 x 4 block for compressed formats */
+static GLsizeiptr formatBytes(GLenum format, bool *isCompressed)
+{
+    *isCompressed = false;
+    switch (format)
+    {
+        case GL_R8:
+            return 1;
+        case GL_RG8:
+        case GL_R16F:
+        case GL_DEPTH_COMPONENT16:
+            return 2;
+        case GL_RGB16F:
+        case GL_RGBA16F:
+        case GL_RG32F:
+            return 8;
+        case GL_RGB32F:
+        case GL_RGBA32F:
+            return 16;
+        case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_RED_RGTC1:
+            *isCompressed = true;
+            return 8;
+        case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
+        case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+        case GL_COMPRESSED_RG_RGTC2:
+            *isCompressed = true;
+            return 16;
+        default:
+            /* RGBA8, RGB8 padded by the driver, 32 bit depth and depth stencil formats */
+            return 4;
+    }
+}
+
+GLsizeiptr ResourceRegistry::textureBytes(GLenum format, GLsizei width, GLsizei height, GLsizei layers, GLint levels)
+{
+    bool       isCompressed = false;
+    GLsizeiptr texel        = formatBytes(format, &isCompressed);
+    GLsizeiptr bytes        = 0;
+
+    for (GLint level = 0; level < levels; ++level)
+    {
+        if (isCompressed)
+            bytes += (GLsizeiptr)((width + 3) / 4) * ((height + 3) / 4) * layers * texel;
+        else
+            bytes += (GLsizeiptr)width * height * layers * texel;
+        width  = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+    return bytes;
+}
+
+const char *ResourceRegistry::categoryName(ResourceCategory category)
+{
+    static const char *names[RESOURCE_CATEGORIES] = {"vertex", "index", "instance", "stream", "texture"};
+    return names[category];
+}
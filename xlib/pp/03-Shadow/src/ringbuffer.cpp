@@ -0,0 +1,146 @@
+/**
+ * @file      ringbuffer.cpp
+ * @brief     Persistently mapped ring buffer for per-frame data
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <cstdio>
+
+#include "resourceregistry.h"
+#include "ringbuffer.h"
+
+#define STREAM_MAP_FLAGS (GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT)
+
+/* 1 second */
+#define STREAM_WAIT_TIMEOUT 1000000000ULL
+
+StreamBuffer::StreamBuffer(const char *owner) : name(0U), mapped(nullptr), regionSize(0), nRegions(0U), region(0U), head(0), nStalls(0U), owner(owner)
+{
+    for (GLuint idx = 0U; idx < STREAM_MAX_REGIONS; ++idx)
+        fences[idx] = nullptr;
+}
+
+int StreamBuffer::initialize(GLsizeiptr regionSize, GLuint nRegions)
+{
+    if (!GLEW_VERSION_4_4 && !GLEW_ARB_buffer_storage)
+    {
+        fprintf(stderr, "[%s] GL_ARB_buffer_storage is not supported\n", __func__);
+        return -1;
+    }
+
+    if (nRegions < 2U || nRegions > STREAM_MAX_REGIONS || regionSize <= 0)
+    {
+        fprintf(stderr, "[%s] invalid size %ld x %u\n", __func__, (long)regionSize, nRegions);
+        return -1;
+    }
+
+    this->regionSize = regionSize;
+    this->nRegions   = nRegions;
+
+    glGenBuffers(1, &name);
+    glBindBuffer(GL_ARRAY_BUFFER, name);
+    glBufferStorage(GL_ARRAY_BUFFER, regionSize * nRegions, nullptr, STREAM_MAP_FLAGS);
+    resourceRegistry.trackBuffer(name, RESOURCE_STREAM, owner, regionSize * nRegions);
+    mapped = (uint8_t *)glMapBufferRange(GL_ARRAY_BUFFER, 0, regionSize * nRegions, STREAM_MAP_FLAGS);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    if (nullptr == mapped)
+    {
+        fprintf(stderr, "[%s] failed to map %ld bytes\n", __func__, (long)(regionSize * nRegions));
+        uninitialize();
+        return -1;
+    }
+
+    /* first beginFrame() moves to region 0 */
+    region = nRegions - 1U;
+    head   = 0;
+    return 0;
+}
+
+void StreamBuffer::uninitialize()
+{
+    for (GLuint idx = 0U; idx < STREAM_MAX_REGIONS; ++idx)
+    {
+        if (fences[idx])
+        {
+            glDeleteSync(fences[idx]);
+            fences[idx] = nullptr;
+        }
+    }
+
+    if (name)
+    {
+        if (mapped)
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, name);
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            mapped = nullptr;
+        }
+        resourceRegistry.release(GL_BUFFER, name);
+        glDeleteBuffers(1, &name);
+        name = 0U;
+    }
+}
+
+void StreamBuffer::beginFrame()
+{
+    region = (region + 1U) % nRegions;
+    head   = 0;
+
+    GLsync fence = fences[region];
+    if (nullptr == fence)
+        return;
+
+    /* poll first, only count it as a stall when the GPU is actually behind */
+    GLenum status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    if (GL_TIMEOUT_EXPIRED == status)
+    {
+        nStalls++;
+        do
+        {
+            status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, STREAM_WAIT_TIMEOUT);
+        } while (GL_TIMEOUT_EXPIRED == status);
+    }
+
+    if (GL_WAIT_FAILED == status)
+    {
+        fprintf(stderr, "[%s] wait on region %u failed\n", __func__, region);
+    }
+    glDeleteSync(fence);
+    fences[region] = nullptr;
+}
+
+void *StreamBuffer::allocate(GLsizeiptr size, GLsizeiptr alignment, GLintptr *pOffset)
+{
+    GLsizeiptr base   = (GLsizeiptr)region * regionSize;
+    GLsizeiptr offset = base + head;
+
+    if (alignment > 1)
+    {
+        offset = ((offset + alignment - 1) / alignment) * alignment;
+    }
+
+    if (offset + size > base + regionSize)
+    {
+        fprintf(stderr, "[%s] region exhausted, %ld of %ld bytes used\n", __func__, (long)head, (long)regionSize);
+        return nullptr;
+    }
+
+    head     = offset + size - base;
+    *pOffset = offset;
+    return mapped + offset;
+}
+
+void StreamBuffer::endFrame()
+{
+    fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
@@ -0,0 +1,159 @@
+/**
+ * @file      shader.cpp
+ * @brief     shader compilation
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2023-12-19
+ * @copyright Copyright 2023 Rohit Nimkar
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+#include <string>
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <sstream>
+#include <ctime>
+#include "shader.h"
+#include <GL/gl.h>
+
+static double now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+GLuint LoadShaders(const char* vertex_file_path, const char* fragment_file_path, GLuint* pProgram, ProgramCache* cache)
+{
+    std::string sources[2];
+    uint64_t key   = 0U;
+    double   start = now();
+
+    if (!readShaderSource(vertex_file_path, sources[0]) || !readShaderSource(fragment_file_path, sources[1])) { return (GL_FALSE); }
+
+    if (nullptr != cache)
+    {
+        key       = cache->key(sources, 2U);
+        *pProgram = cache->load(key);
+        if (0U != *pProgram)
+        {
+            std::cout << "Loaded cached program: " << vertex_file_path << ", " << fragment_file_path << std::endl;
+            return (GL_TRUE);
+        }
+    }
+
+    // Create the shaders
+    GLuint vertexShader   = glCreateShader(GL_VERTEX_SHADER);
+    GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+
+    GLint result;
+
+    result = compileShader(vertexShader, sources[0], vertex_file_path);
+    if (GL_TRUE != result)
+    {
+        glDeleteShader(vertexShader);
+        glDeleteShader(fragmentShader);
+        return (result);
+    }
+    result = compileShader(fragmentShader, sources[1], fragment_file_path);
+    if (GL_TRUE != result)
+    {
+        std::cout << "Deleting vertex shader\n";
+        glDeleteShader(vertexShader);
+        glDeleteShader(fragmentShader);
+        return (result);
+    }
+
+    // Link the program
+    std::cout << "Linking program\n";
+    *pProgram = glCreateProgram();
+    if (nullptr != cache) { glProgramParameteri(*pProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE); }
+    glAttachShader(*pProgram, vertexShader);
+    glAttachShader(*pProgram, fragmentShader);
+    glLinkProgram(*pProgram);
+
+    // Check the program
+    glGetProgramiv(*pProgram, GL_LINK_STATUS, &result);
+    if (GL_TRUE != result)
+    {
+        // linking Failed
+        int infoLogLen = 0;
+        std::cerr << "Failed to link program\n";
+        glGetProgramiv(*pProgram, GL_INFO_LOG_LENGTH, &infoLogLen);
+        if (infoLogLen > 0)
+        {
+            char msg[infoLogLen + 1];
+            glGetProgramInfoLog(*pProgram, infoLogLen, nullptr, msg);
+            std::cerr << msg << std::endl;
+        }
+        glDeleteShader(vertexShader);
+        glDeleteShader(fragmentShader);
+        return (result);
+    }
+
+    glDetachShader(*pProgram, vertexShader);
+    glDetachShader(*pProgram, fragmentShader);
+
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    if (nullptr != cache) { cache->store(key, *pProgram, now() - start); }
+    return (result);
+}
+
+bool readShaderSource(const char* pFilename, std::string& source)
+{
+    std::ifstream sourceInputStream(pFilename, std::ios::in);
+
+    if (!sourceInputStream.is_open())
+    {
+        std::cerr << "failed to read shader" << pFilename << std::endl;
+        return (false);
+    }
+
+    std::stringstream sstr;
+    sstr << sourceInputStream.rdbuf();
+    source = sstr.str();
+    sourceInputStream.close();
+    return (true);
+}
+
+GLint loadShader(GLuint shaderId, const char* pFilename)
+{
+    std::string sourceString;
+
+    if (!readShaderSource(pFilename, sourceString)) { return (GL_FALSE); }
+    return (compileShader(shaderId, sourceString, pFilename));
+}
+
+GLint compileShader(GLuint shaderId, const std::string& source, const char* pName)
+{
+    GLint result = GL_FALSE;
+
+    // Compile shader
+    std::cout << "Compiling shader: " << pName << std::endl;
+    char const* pSourceCode = source.c_str();
+    glShaderSource(shaderId, 1, &pSourceCode, NULL);
+    glCompileShader(shaderId);
+
+    // validate compilation status
+    glGetShaderiv(shaderId, GL_COMPILE_STATUS, &result);
+    if (GL_TRUE != result)
+    {
+        int infoLogLen = 0;
+        std::cerr << "Failed to compile shader: " << pName << std::endl;
+
+        glGetShaderiv(shaderId, GL_INFO_LOG_LENGTH, &infoLogLen);
+        if (infoLogLen > 0)
+        {
+            char msg[infoLogLen];
+            glGetShaderInfoLog(shaderId, infoLogLen, NULL, msg);
+            std::cerr << msg << std::endl;
+        }
+    }
+    return (result);
+}
@@ -0,0 +1,247 @@
+/**
+ * @file      shadermanager.cpp
+ * @brief     Asynchronous program compilation
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <cstdio>
+#include <ctime>
+
+#include "shader.h"
+#include "shadermanager.h"
+
+/* let the driver pick the number of compiler threads */
+#define COMPILER_THREADS_MAX 0xffffffffU
+
+static double now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static void printInfoLog(GLuint object, bool isProgram, const std::string &name)
+{
+    GLint length = 0;
+
+    if (isProgram)
+        glGetProgramiv(object, GL_INFO_LOG_LENGTH, &length);
+    else
+        glGetShaderiv(object, GL_INFO_LOG_LENGTH, &length);
+
+    if (length <= 0)
+        return;
+
+    std::vector<char> log(length + 1);
+    if (isProgram)
+        glGetProgramInfoLog(object, length, nullptr, log.data());
+    else
+        glGetShaderInfoLog(object, length, nullptr, log.data());
+    fprintf(stderr, "%s:\n%s\n", name.c_str(), log.data());
+}
+
+ShaderManager::ShaderManager() : cache(nullptr), onLinked(nullptr), parallel(false)
+{
+}
+
+void ShaderManager::initialize(ProgramCache *cache, void (*onLinked)(GLuint program))
+{
+    this->cache    = cache;
+    this->onLinked = onLinked;
+
+    if (GLEW_KHR_parallel_shader_compile)
+    {
+        glMaxShaderCompilerThreadsKHR(COMPILER_THREADS_MAX);
+        parallel = true;
+    }
+    else if (GLEW_ARB_parallel_shader_compile)
+    {
+        glMaxShaderCompilerThreadsARB(COMPILER_THREADS_MAX);
+        parallel = true;
+    }
+}
+
+void ShaderManager::uninitialize()
+{
+    for (size_t idx = 0U; idx < requests.size(); ++idx)
+    {
+        ProgramRequest &request = requests[idx];
+        for (int stage = 0; stage < 2; ++stage)
+        {
+            if (request.shaders[stage])
+                glDeleteShader(request.shaders[stage]);
+        }
+        if (request.program)
+            glDeleteProgram(request.program);
+    }
+    requests.clear();
+}
+
+uint32_t ShaderManager::submit(const char *vertexFile, const char *fragmentFile, GLuint fallback)
+{
+    std::string sources[2];
+    std::string names[2] = {vertexFile, fragmentFile};
+
+    if (!readShaderSource(vertexFile, sources[0]) || !readShaderSource(fragmentFile, sources[1]))
+    {
+        ProgramRequest request;
+        request.files[0]   = names[0];
+        request.files[1]   = names[1];
+        request.shaders[0] = 0U;
+        request.shaders[1] = 0U;
+        request.program    = 0U;
+        request.fallback   = fallback;
+        request.state      = PROGRAM_FAILED;
+        request.key        = 0U;
+        request.submitted  = now();
+        request.readyMs    = 0.0;
+        requests.push_back(request);
+        return requests.size() - 1U;
+    }
+    return submit(sources, names, fallback);
+}
+
+uint32_t ShaderManager::submit(const std::string sources[2], const std::string names[2], GLuint fallback)
+{
+    const GLenum   types[2] = {GL_VERTEX_SHADER, GL_FRAGMENT_SHADER};
+    ProgramRequest request;
+
+    request.files[0]   = names[0];
+    request.files[1]   = names[1];
+    request.shaders[0] = 0U;
+    request.shaders[1] = 0U;
+    request.program    = 0U;
+    request.fallback   = fallback;
+    request.state      = PROGRAM_PENDING;
+    request.key        = 0U;
+    request.submitted  = now();
+    request.readyMs    = 0.0;
+
+    if (nullptr != cache)
+    {
+        request.key     = cache->key(sources, 2U);
+        request.program = cache->load(request.key);
+        if (0U != request.program)
+        {
+            request.state   = PROGRAM_READY;
+            request.readyMs = now() - request.submitted;
+            if (nullptr != onLinked)
+                onLinked(request.program);
+            requests.push_back(request);
+            return requests.size() - 1U;
+        }
+    }
+
+    /* no status queries in between, the driver may build all of it in the background */
+    request.program = glCreateProgram();
+    if (nullptr != cache)
+        glProgramParameteri(request.program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
+    for (int stage = 0; stage < 2; ++stage)
+    {
+        const char *source      = sources[stage].c_str();
+        request.shaders[stage] = glCreateShader(types[stage]);
+        glShaderSource(request.shaders[stage], 1, &source, nullptr);
+        glCompileShader(request.shaders[stage]);
+        glAttachShader(request.program, request.shaders[stage]);
+    }
+    glLinkProgram(request.program);
+
+    requests.push_back(request);
+    return requests.size() - 1U;
+}
+
+/* link finished, check the outcome and release shaders */
+void ShaderManager::complete(ProgramRequest &request)
+{
+    GLint status = GL_FALSE;
+
+    glGetProgramiv(request.program, GL_LINK_STATUS, &status);
+    request.readyMs = now() - request.submitted;
+
+    if (GL_TRUE == status)
+    {
+        request.state = PROGRAM_READY;
+        if (nullptr != cache)
+            cache->store(request.key, request.program, request.readyMs);
+        if (nullptr != onLinked)
+            onLinked(request.program);
+    }
+    else
+    {
+        fprintf(stderr, "[%s] failed to build %s + %s\n", __func__, request.files[0].c_str(), request.files[1].c_str());
+        for (int stage = 0; stage < 2; ++stage)
+        {
+            glGetShaderiv(request.shaders[stage], GL_COMPILE_STATUS, &status);
+            if (GL_TRUE != status)
+                printInfoLog(request.shaders[stage], false, request.files[stage]);
+        }
+        printInfoLog(request.program, true, "link");
+
+        request.state = PROGRAM_FAILED;
+        glDeleteProgram(request.program);
+        request.program = 0U;
+    }
+
+    for (int stage = 0; stage < 2; ++stage)
+    {
+        if (request.program)
+            glDetachShader(request.program, request.shaders[stage]);
+        glDeleteShader(request.shaders[stage]);
+        request.shaders[stage] = 0U;
+    }
+}
+
+uint32_t ShaderManager::poll()
+{
+    uint32_t nCompleted = 0U;
+
+    for (size_t idx = 0U; idx < requests.size(); ++idx)
+    {
+        ProgramRequest &request = requests[idx];
+        if (PROGRAM_PENDING != request.state)
+            continue;
+
+        if (true == parallel)
+        {
+            GLint done = GL_FALSE;
+            glGetProgramiv(request.program, GL_COMPLETION_STATUS_KHR, &done);
+            if (GL_TRUE != done)
+                continue;
+        }
+
+        complete(request);
+        nCompleted++;
+    }
+    return nCompleted;
+}
+
+void ShaderManager::finish(uint32_t handle)
+{
+    if (handle < requests.size() && PROGRAM_PENDING == requests[handle].state)
+    {
+        complete(requests[handle]);
+    }
+}
+
+GLuint ShaderManager::program(uint32_t handle) const
+{
+    if (handle >= requests.size())
+        return 0U;
+
+    const ProgramRequest &request = requests[handle];
+    return PROGRAM_READY == request.state ? request.program : request.fallback;
+}
+
+ProgramState ShaderManager::state(uint32_t handle) const
+{
+    return handle < requests.size() ? requests[handle].state : PROGRAM_FAILED;
+}
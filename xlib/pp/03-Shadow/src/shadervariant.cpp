@@ -0,0 +1,165 @@
+/**
+ * @file      shadervariant.cpp
+ * @brief     GLSL preprocessing and lazily built shader permutations
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <cstdio>
+#include <sstream>
+
+#include "shader.h"
+#include "shadervariant.h"
+
+/* handle of a variant whose sources could not be preprocessed */
+#define VARIANT_FAILED 0xffffffffU
+
+static bool expand(const std::string &path, const std::vector<std::string> &defines, std::string &out, std::vector<std::string> &files, uint32_t depth)
+{
+    std::string text;
+    std::string line;
+    uint32_t    lineNo = 0U;
+
+    if (depth > MAX_INCLUDE_DEPTH)
+    {
+        fprintf(stderr, "[%s] includes nested too deep at %s\n", __func__, path.c_str());
+        return false;
+    }
+
+    /* include once */
+    for (size_t idx = 0U; idx < files.size(); ++idx)
+    {
+        if (files[idx] == path)
+            return true;
+    }
+
+    if (!readShaderSource(path.c_str(), text))
+        return false;
+
+    const size_t      fileIndex = files.size();
+    const size_t      slash     = path.rfind('/');
+    const std::string directory = std::string::npos == slash ? std::string() : path.substr(0U, slash + 1U);
+    files.push_back(path);
+
+    if (0U < depth)
+        out += "#line 1 " + std::to_string(fileIndex) + "\n";
+
+    std::istringstream stream(text);
+    while (std::getline(stream, line))
+    {
+        size_t start = line.find_first_not_of(" \t");
+        lineNo++;
+
+        if (std::string::npos != start && 0 == line.compare(start, 8, "#include"))
+        {
+            size_t open  = line.find('"', start + 8U);
+            size_t close = std::string::npos == open ? open : line.find('"', open + 1U);
+            if (std::string::npos == close)
+            {
+                fprintf(stderr, "%s:%u: malformed #include\n", path.c_str(), lineNo);
+                return false;
+            }
+
+            if (!expand(directory + line.substr(open + 1U, close - open - 1U), defines, out, files, depth + 1U))
+            {
+                fprintf(stderr, "%s:%u: included from here\n", path.c_str(), lineNo);
+                return false;
+            }
+            out += "#line " + std::to_string(lineNo + 1U) + " " + std::to_string(fileIndex) + "\n";
+            continue;
+        }
+
+        out += line;
+        out += "\n";
+
+        /* #version has to stay the first statement, features follow it */
+        if (0U == depth && std::string::npos != start && 0 == line.compare(start, 8, "#version"))
+        {
+            for (size_t idx = 0U; idx < defines.size(); ++idx)
+                out += "#define " + defines[idx] + "\n";
+            out += "#line " + std::to_string(lineNo + 1U) + " 0\n";
+        }
+    }
+    return true;
+}
+
+bool preprocessShader(const std::string &path, const std::vector<std::string> &defines, std::string &source, std::vector<std::string> &files)
+{
+    source.clear();
+    files.clear();
+    return expand(path, defines, source, files, 0U);
+}
+
+ShaderVariants::ShaderVariants() : manager(nullptr), fallback(0U)
+{
+}
+
+void ShaderVariants::initialize(ShaderManager *manager, const char *vertexFile, const char *fragmentFile, GLuint fallback)
+{
+    this->manager  = manager;
+    this->fallback = fallback;
+    files[0]       = vertexFile;
+    files[1]       = fragmentFile;
+}
+
+uint32_t ShaderVariants::feature(const char *name)
+{
+    for (size_t idx = 0U; idx < features.size(); ++idx)
+    {
+        if (features[idx] == name)
+            return 1U << idx;
+    }
+
+    if (features.size() >= MAX_SHADER_FEATURES)
+    {
+        fprintf(stderr, "[%s] no key bit left for %s\n", __func__, name);
+        return 0U;
+    }
+    features.push_back(name);
+    return 1U << (features.size() - 1U);
+}
+
+GLuint ShaderVariants::program(uint32_t key)
+{
+    std::map<uint32_t, uint32_t>::const_iterator it = variants.find(key);
+    if (variants.end() != it)
+        return VARIANT_FAILED == it->second ? fallback : manager->program(it->second);
+
+    std::vector<std::string> defines;
+    std::vector<std::string> included;
+    std::string              sources[2];
+    std::string              names[2];
+    std::string              suffix;
+
+    for (size_t bit = 0U; bit < features.size(); ++bit)
+    {
+        if (key & (1U << bit))
+        {
+            defines.push_back(features[bit]);
+            suffix += (suffix.empty() ? " [" : ", ") + features[bit];
+        }
+    }
+    if (!suffix.empty())
+        suffix += "]";
+
+    for (int stage = 0; stage < 2; ++stage)
+    {
+        names[stage] = files[stage] + suffix;
+        if (!preprocessShader(files[stage], defines, sources[stage], included))
+        {
+            /* remembered as failed so that the fallback is used without retrying every frame */
+            variants[key] = VARIANT_FAILED;
+            return fallback;
+        }
+    }
+
+    variants[key] = manager->submit(sources, names, fallback);
+    return manager->program(variants[key]);
+}
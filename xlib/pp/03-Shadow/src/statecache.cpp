@@ -0,0 +1,91 @@
+/**
+ * @file      statecache.cpp
+ * @brief     Shadow copy of GL bindings to drop redundant state changes
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <cstring>
+
+#include "statecache.h"
+
+#define UNKNOWN_BINDING (~0U)
+
+StateCache::StateCache()
+{
+    invalidate();
+    resetStats();
+}
+
+void StateCache::useProgram(GLuint program)
+{
+    if (this->program == program)
+    {
+        stats.programSkipped++;
+        return;
+    }
+    glUseProgram(program);
+    this->program = program;
+    stats.programChanges++;
+}
+
+void StateCache::bindTexture(GLuint unit, GLenum target, GLuint texture)
+{
+    if (unit >= STATE_TEXTURE_UNITS)
+    {
+        /* not tracked */
+        glActiveTexture(GL_TEXTURE0 + unit);
+        glBindTexture(target, texture);
+        activeUnit = unit;
+        stats.textureChanges++;
+        return;
+    }
+
+    if (textures[unit] == texture)
+    {
+        stats.textureSkipped++;
+        return;
+    }
+
+    if (activeUnit != unit)
+    {
+        glActiveTexture(GL_TEXTURE0 + unit);
+        activeUnit = unit;
+    }
+    glBindTexture(target, texture);
+    textures[unit] = texture;
+    stats.textureChanges++;
+}
+
+void StateCache::bindVertexArray(GLuint vao)
+{
+    if (vertexArray == vao)
+    {
+        stats.vertexArraySkipped++;
+        return;
+    }
+    glBindVertexArray(vao);
+    vertexArray = vao;
+    stats.vertexArrayChanges++;
+}
+
+void StateCache::invalidate()
+{
+    program     = UNKNOWN_BINDING;
+    vertexArray = UNKNOWN_BINDING;
+    activeUnit  = UNKNOWN_BINDING;
+    for (GLuint unit = 0U; unit < STATE_TEXTURE_UNITS; ++unit)
+        textures[unit] = UNKNOWN_BINDING;
+}
+
+void StateCache::resetStats()
+{
+    memset(&stats, 0, sizeof(stats));
+}
@@ -0,0 +1,101 @@
+/**
+ * @file      texturepool.cpp
+ * @brief     Textures of one size and format packed into layers of an array texture
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <cstdio>
+#include <vector>
+
+#include "resourceregistry.h"
+#include "texturepool.h"
+
+TexturePool::TexturePool(const char *owner) : arrayTexture(0U), width(0), height(0), maxLayers(0), nLayers(0), owner(owner)
+{
+}
+
+int TexturePool::initialize(GLsizei width, GLsizei height, GLsizei maxLayers)
+{
+    GLint limit = 0;
+
+    glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &limit);
+    if (0 >= width || 0 >= height || 0 >= maxLayers || maxLayers > limit)
+    {
+        fprintf(stderr, "[%s] invalid pool %dx%d with %d layers, driver supports %d\n", __func__, width, height, maxLayers, limit);
+        return -1;
+    }
+
+    this->width     = width;
+    this->height    = height;
+    this->maxLayers = maxLayers;
+    nLayers         = 0;
+
+    glGenTextures(1, &arrayTexture);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, arrayTexture);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    /* whole chain allocated up front, layers are filled in later */
+    GLint levels = 0;
+    for (GLint w = width, h = height;; w = w > 1 ? w / 2 : 1, h = h > 1 ? h / 2 : 1)
+    {
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, levels++, GL_RGBA8, w, h, maxLayers, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        if (1 == w && 1 == h)
+            break;
+    }
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0U);
+    resourceRegistry.trackTexture(arrayTexture, RESOURCE_TEXTURE, owner, GL_RGBA8, width, height, maxLayers, levels);
+
+    std::vector<unsigned char> white((size_t)width * height * 4U, 0xff);
+    addLayer(white.data(), width, height);
+    return 0;
+}
+
+void TexturePool::uninitialize()
+{
+    if (arrayTexture)
+    {
+        resourceRegistry.release(GL_TEXTURE, arrayTexture);
+        glDeleteTextures(1, &arrayTexture);
+        arrayTexture = 0U;
+    }
+    nLayers = 0;
+}
+
+GLint TexturePool::addLayer(const unsigned char *rgba, GLsizei width, GLsizei height)
+{
+    if (width != this->width || height != this->height)
+    {
+        fprintf(stderr, "[%s] %dx%d image does not fit %dx%d pool\n", __func__, width, height, this->width, this->height);
+        return -1;
+    }
+
+    if (nLayers >= maxLayers)
+    {
+        fprintf(stderr, "[%s] pool is full\n", __func__);
+        return -1;
+    }
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, arrayTexture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, nLayers, width, height, 1, GL_RGBA, GL_UNSIGNED_BYTE, rgba);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0U);
+    return nLayers++;
+}
+
+void TexturePool::generateMipmaps()
+{
+    glBindTexture(GL_TEXTURE_2D_ARRAY, arrayTexture);
+    glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0U);
+}
@@ -0,0 +1,38 @@
+#version 330 core
+
+// Per-vertex attributes
+layout(location = 0) in vec3 vertexPosition_modelspace;
+layout(location = 1) in vec3 vertexNormal_modelspace;
+layout(location = 8) in vec2 vertexTexCoord;
+
+// Per-instance attributes, advanced once per instance
+layout(location = 2) in vec4 instanceDiffuse;
+layout(location = 3) in vec4 instanceEmission;
+layout(location = 4) in mat4 instanceModel;
+layout(location = 9) in float instanceLayer;
+
+#include "passdata.glsl"
+
+out vec3 viewPosition;
+out vec3 viewNormal;
+out vec3 viewLight;
+out vec4 diffuse;
+out vec4 emission;
+out vec3 texCoord; // layer of texture pool in z
+
+void main()
+{
+    vec4 worldPosition = instanceModel * vec4(vertexPosition_modelspace, 1.0);
+    mat4 modelView     = uView * uPre * instanceModel;
+    vec4 eyePosition   = uView * uPre * worldPosition;
+
+    gl_ClipDistance[0] = dot(worldPosition, uClipPlane);
+    gl_Position        = uProjection * eyePosition;
+
+    viewPosition = eyePosition.xyz;
+    viewNormal   = mat3(modelView) * vertexNormal_modelspace;
+    viewLight    = (uView * uPre * uLightPosition).xyz;
+    diffuse      = instanceDiffuse;
+    emission     = instanceEmission;
+    texCoord     = vec3(vertexTexCoord, instanceLayer);
+}
@@ -27,6 +27,7 @@
 #include <X11/keysymdef.h>
 #include "X11/XKBlib.h"
 #include "shader.h"
+#include "../../benchmark/benchmark.h"
 
 #define GLX_MAJOR_MIN 1
 #define GLX_MINOR_MIN 2
@@ -129,6 +130,10 @@ int main()
     glClearColor(0.0f, 0.0f, 0.4f, 0.0f);
     glMatrixMode(GL_MODELVIEW);
     glLoadIdentity();
+    /* fixed workload with timing report when BENCHMARK_FRAMES is set */
+    struct Benchmark bench;
+    benchmarkInit(&bench, "triangle-shader");
+
     while (!globalAbortFlag)
     {
         XEvent evt;
@@ -166,10 +171,13 @@ int main()
             }
         }
         if (!shouldDraw) continue;
+        benchmarkBeginFrame(&bench);
+        benchmarkPhase(&bench, "update");
         static GLfloat angle = 0.0f;
         angle += 0.5;
         /* redraw frame */
-        std::cout << "redrawing frame" << std::endl;
+        // std::cout << "redrawing frame" << std::endl;
+        benchmarkPhase(&bench, "render");
         glClear(GL_COLOR_BUFFER_BIT);
         glLoadIdentity();
         glTranslatef(0.0f, 0.0f, -5.0f);
@@ -183,7 +191,10 @@ int main()
         glVertex2f(1.0, -1.0);
         glEnd();
 
+        benchmarkPhase(&bench, "swap");
         glXSwapBuffers(dpy, w);
+        if (benchmarkEndFrame(&bench))
+            globalAbortFlag = true;
     }
 
     /* resource cleanup */
@@ -27,6 +27,8 @@
 #include <cstdlib>
 #include <iostream>
 #include "stb_image.h"
+#include "../../benchmark/benchmark.h"
+#include "../../benchmark/gldebug.h"
 
 #define GLX_MAJOR_MIN 1
 #define GLX_MINOR_MIN 2
@@ -116,8 +118,11 @@ int main()
     w = XCreateWindow(dpy, root, 0, 0, 1024, 768, 0, vi->depth, InputOutput, vi->visual, CWBackPixel | CWColormap | CWBorderPixel | CWEventMask, &xattr);
     XStoreName(dpy, w, "Rohit Nimkar: OpenGL demo with X11");
 
+    /* debug context reporting performance warnings when GL_DEBUG is set */
+    struct DebugOutput debug;
+
     /* create opengl context */
-    ctxt = glXCreateContext(dpy, vi, nullptr, GL_TRUE);
+    ctxt = debugOutputCreateContext(&debug, dpy, vi);
     glXMakeCurrent(dpy, w, ctxt);
 
     /* initialize glew */
@@ -133,6 +138,8 @@ int main()
         return -1;
     }
 
+    debugOutputInstall(&debug);
+
     /* free XVisual as it is not required */
     XFree(vi);
     vi = nullptr;
@@ -195,48 +202,61 @@ int main()
     else { std::cout << "Failed to load texture" << std::endl; }
     stbi_image_free(data);
 
+    /* fixed workload with timing report when BENCHMARK_FRAMES is set */
+    struct Benchmark bench;
+    benchmarkInit(&bench, "triangle-texture");
+
     while (!globalAbortFlag)
     {
         XEvent evt;
-        XNextEvent(dpy, &evt);
-        switch (evt.type)
-        {
-        case Expose:
-        {
-            if (!shouldDraw) shouldDraw = true;
-            break;
-        }
-        case ClientMessage:
-        {
-            if (evt.xclient.data.l[0] == wm_delete_window) { globalAbortFlag = true; }
 
-            break;
-        }
-        case KeyPress:
+        /* benchmark mode renders back to back instead of waiting for events */
+        if (!bench.enabled || XPending(dpy))
         {
-            KeySym sym = XkbKeycodeToKeysym(dpy, evt.xkey.keycode, 0, 0);
-            if (XK_Escape == sym) { globalAbortFlag = true; }
-            break;
-        }
-        case MapNotify:
-        {
-            std::cout << "GL Vendor: " << glGetString(GL_VENDOR) << "\n";
-            std::cout << "GL Renderer: " << glGetString(GL_RENDERER) << "\n";
-            std::cout << "GL Version: " << glGetString(GL_VERSION) << "\n";
-            std::cout << "GL Shading Language: " << glGetString(GL_SHADING_LANGUAGE_VERSION) << "\n";
-            break;
-        }
-        default:
-        {
-            std::cout << "Default event: " << evt.type << std::endl;
-            break;
-        }
+            XNextEvent(dpy, &evt);
+            switch (evt.type)
+            {
+            case Expose:
+            {
+                if (!shouldDraw) shouldDraw = true;
+                break;
+            }
+            case ClientMessage:
+            {
+                if (evt.xclient.data.l[0] == wm_delete_window) { globalAbortFlag = true; }
+
+                break;
+            }
+            case KeyPress:
+            {
+                KeySym sym = XkbKeycodeToKeysym(dpy, evt.xkey.keycode, 0, 0);
+                if (XK_Escape == sym) { globalAbortFlag = true; }
+                break;
+            }
+            case MapNotify:
+            {
+                std::cout << "GL Vendor: " << glGetString(GL_VENDOR) << "\n";
+                std::cout << "GL Renderer: " << glGetString(GL_RENDERER) << "\n";
+                std::cout << "GL Version: " << glGetString(GL_VERSION) << "\n";
+                std::cout << "GL Shading Language: " << glGetString(GL_SHADING_LANGUAGE_VERSION) << "\n";
+                break;
+            }
+            default:
+            {
+                std::cout << "Default event: " << evt.type << std::endl;
+                break;
+            }
+            }
         }
+
         if (!shouldDraw) continue;
+        benchmarkBeginFrame(&bench);
+        benchmarkPhase(&bench, "update");
 
         /* redraw frame */
-        std::cout << "redrawing frame" << std::endl;
+        // std::cout << "redrawing frame" << std::endl;
 
+        benchmarkPhase(&bench, "render");
         glClear(GL_COLOR_BUFFER_BIT);
         glBindTexture(GL_TEXTURE_2D, texture);
         glUseProgram(program);
@@ -244,7 +264,10 @@ int main()
         glBindVertexArray(vertexArrayBuffer);
         // bind Texture
         glDrawElements(GL_TRIANGLES, 3, GL_UNSIGNED_INT, 0);
+        benchmarkPhase(&bench, "swap");
         glXSwapBuffers(dpy, w);
+        if (benchmarkEndFrame(&bench))
+            globalAbortFlag = true;
     }
 
     /* resource cleanup */
@@ -252,6 +275,7 @@ int main()
     glDeleteBuffers(1, &vertexBuffer);
     glDeleteBuffers(1, &indexBuffer);
     glDeleteProgram(program);
+    debugOutputReport(&debug, stderr);
     glXDestroyContext(dpy, ctxt);
     XFreeColormap(dpy, xattr.colormap);
     XDestroyWindow(dpy, w);
@@ -29,6 +29,8 @@
 
 /* Project level header files */
 #include "shader.h"
+#include "../../benchmark/benchmark.h"
+#include "../../benchmark/gldebug.h"
 
 /* For mathematical operations */
 #include <vmath.h>
@@ -180,8 +182,11 @@ int main()
     wm_delete_window = XInternAtom(dpy, "WM_DELETE_WINDOW", False);
     XSetWMProtocols(dpy, w, &wm_delete_window, 1);
 
+    /* debug context reporting performance warnings when GL_DEBUG is set */
+    struct DebugOutput debug;
+
     /* create opengl context */
-    ctxt = glXCreateContext(dpy, vi, nullptr, GL_TRUE);
+    ctxt = debugOutputCreateContext(&debug, dpy, vi);
     glXMakeCurrent(dpy, w, ctxt);
 
     /* initialize glew */
@@ -197,6 +202,8 @@ int main()
         return -1;
     }
 
+    debugOutputInstall(&debug);
+
     /* free XVisual as it is not required */
     XFree(vi);
     vi = nullptr;
@@ -242,6 +249,10 @@ int main()
     vmath::mat4    Projection = vmath::perspective(45.0f, 4.0f / 3.0f, 0.1f, 100.0f);
     vmath::mat4    MVP        = Projection * View * Model;
 
+    /* fixed workload with timing report when BENCHMARK_FRAMES is set */
+    struct Benchmark bench;
+    benchmarkInit(&bench, "vmath-cube");
+
     while (!globalAbortFlag)
     {
         XEvent evt;
@@ -287,11 +298,14 @@ int main()
         }
 
         if (!shouldDraw) continue;
+        benchmarkBeginFrame(&bench);
+        benchmarkPhase(&bench, "update");
         // static GLfloat x, y = 3.0, z;
         theta += 0.5;
         Model = vmath::translate(vmath::vec3(0.0f, 0.0f, 0.0f)) * vmath::rotate(theta, 0.0f, 0.0f, 1.0f) * vmath::scale(1.0f, 1.0f, 1.0f);
         MVP   = Projection * View * Model;
 
+        benchmarkPhase(&bench, "render");
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
         glUseProgram(program);
@@ -299,7 +313,10 @@ int main()
         glBindVertexArray(vertexArrayBuffer);
 
         glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, 0);
+        benchmarkPhase(&bench, "swap");
         glXSwapBuffers(dpy, w);
+        if (benchmarkEndFrame(&bench))
+            globalAbortFlag = true;
     }
 
     /* resource cleanup */
@@ -309,6 +326,7 @@ int main()
     glDeleteBuffers(1, &vertexBuffer);
     glDeleteVertexArrays(1, &vertexArrayBuffer);
     glDeleteProgram(program);
+    debugOutputReport(&debug, stderr);
     glXDestroyContext(dpy, ctxt);
     XFreeColormap(dpy, xattr.colormap);
     XDestroyWindow(dpy, w);
@@ -0,0 +1,421 @@
+/**
+ * @file      cook-texture.c
+ * @brief     Convert an image into a KTX file holding its full mip chain
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * Usage: cook-texture [-f rgba8|bc1|bc3] input output.ktx
+ *
+ * Mip levels are filtered with a 2x2 box in linear light, colour channels
+ * are converted from sRGB before averaging and back afterwards, alpha is
+ * averaged as is. Texture data is kept sRGB encoded, samples that sample it
+ * as plain RGB look the same as before.
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <GL/gl.h>
+#include <GL/glext.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+#define KTX_ENDIANNESS 0x04030201U
+
+/* resolution of the linear to sRGB table */
+#define ENCODE_STEPS 4096
+
+enum Format
+{
+    FORMAT_RGBA8 = 0,
+    FORMAT_BC1,
+    FORMAT_BC3
+};
+
+struct Image
+{
+    uint32_t width;
+    uint32_t height;
+    float   *texels; // linear RGBA
+};
+
+static const unsigned char ktxIdentifier[12] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31, 0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+
+static float         decodeTable[256];
+static unsigned char encodeTable[ENCODE_STEPS + 1];
+
+static void buildTables(void)
+{
+    for (int idx = 0; idx < 256; ++idx)
+    {
+        float c          = idx / 255.0f;
+        decodeTable[idx] = c <= 0.04045f ? c / 12.92f : powf((c + 0.055f) / 1.055f, 2.4f);
+    }
+
+    for (int idx = 0; idx <= ENCODE_STEPS; ++idx)
+    {
+        float l          = (float)idx / ENCODE_STEPS;
+        float c          = l <= 0.0031308f ? l * 12.92f : 1.055f * powf(l, 1.0f / 2.4f) - 0.055f;
+        encodeTable[idx] = (unsigned char)(c * 255.0f + 0.5f);
+    }
+}
+
+/* next level, each texel is the average of up to 2x2 texels of the previous one */
+static void downsample(const struct Image *src, struct Image *dst)
+{
+    dst->width  = src->width > 1U ? src->width / 2U : 1U;
+    dst->height = src->height > 1U ? src->height / 2U : 1U;
+    dst->texels = (float *)malloc(sizeof(float) * 4U * dst->width * dst->height);
+
+    for (uint32_t y = 0U; y < dst->height; ++y)
+    {
+        /* odd sizes and 1 texel wide levels repeat the last row or column */
+        const float *row0 = src->texels + 4U * src->width * (2U * y < src->height ? 2U * y : src->height - 1U);
+        const float *row1 = src->texels + 4U * src->width * (2U * y + 1U < src->height ? 2U * y + 1U : src->height - 1U);
+        float       *out  = dst->texels + 4U * dst->width * y;
+
+        for (uint32_t x = 0U; x < dst->width; ++x)
+        {
+            uint32_t x0 = 4U * (2U * x < src->width ? 2U * x : src->width - 1U);
+            uint32_t x1 = 4U * (2U * x + 1U < src->width ? 2U * x + 1U : src->width - 1U);
+#if defined(__SSE2__)
+            __m128 sum = _mm_add_ps(_mm_add_ps(_mm_loadu_ps(row0 + x0), _mm_loadu_ps(row0 + x1)), _mm_add_ps(_mm_loadu_ps(row1 + x0), _mm_loadu_ps(row1 + x1)));
+            _mm_storeu_ps(out + 4U * x, _mm_mul_ps(sum, _mm_set1_ps(0.25f)));
+#else
+            for (int c = 0; c < 4; ++c)
+                out[4U * x + c] = 0.25f * (row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c]);
+#endif
+        }
+    }
+}
+
+/* back to 8 bit sRGB colour and linear alpha */
+static void encode(const struct Image *image, unsigned char *rgba)
+{
+    const size_t nTexels = (size_t)image->width * image->height;
+
+#if defined(__SSE2__)
+    const __m128 scale = _mm_set_ps(255.0f, ENCODE_STEPS, ENCODE_STEPS, ENCODE_STEPS);
+    const __m128 zero  = _mm_setzero_ps();
+    const __m128 one   = _mm_set1_ps(1.0f);
+    for (size_t idx = 0U; idx < nTexels; ++idx)
+    {
+        int32_t index[4];
+        __m128  v = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(image->texels + 4U * idx), zero), one);
+        _mm_storeu_si128((__m128i *)index, _mm_cvtps_epi32(_mm_mul_ps(v, scale)));
+        rgba[4U * idx + 0U] = encodeTable[index[0]];
+        rgba[4U * idx + 1U] = encodeTable[index[1]];
+        rgba[4U * idx + 2U] = encodeTable[index[2]];
+        rgba[4U * idx + 3U] = (unsigned char)index[3];
+    }
+#else
+    for (size_t idx = 0U; idx < nTexels; ++idx)
+    {
+        for (int c = 0; c < 4; ++c)
+        {
+            float v = image->texels[4U * idx + c];
+            v       = v < 0.0f ? 0.0f : (v > 1.0f ? 1.0f : v);
+            rgba[4U * idx + c] = 3 == c ? (unsigned char)(v * 255.0f + 0.5f) : encodeTable[(int)(v * ENCODE_STEPS + 0.5f)];
+        }
+    }
+#endif
+}
+
+static uint16_t pack565(const unsigned char *c)
+{
+    return (uint16_t)(((c[0] * 31 + 127) / 255) << 11 | ((c[1] * 63 + 127) / 255) << 5 | ((c[2] * 31 + 127) / 255));
+}
+
+static void unpack565(uint16_t v, int *c)
+{
+    c[0] = ((v >> 11) & 31) * 255 / 31;
+    c[1] = ((v >> 5) & 63) * 255 / 63;
+    c[2] = (v & 31) * 255 / 31;
+}
+
+/* endpoints are the texels with lowest and highest luma, fast and good enough for photos */
+static void compressColorBlock(const unsigned char block[16][4], unsigned char *out)
+{
+    int      lo = 0, hi = 0, loLuma = 1 << 30, hiLuma = -1;
+    int      palette[4][3];
+    uint32_t indices = 0U;
+
+    for (int idx = 0; idx < 16; ++idx)
+    {
+        int luma = 2 * block[idx][0] + 4 * block[idx][1] + block[idx][2];
+        if (luma < loLuma)
+        {
+            loLuma = luma;
+            lo     = idx;
+        }
+        if (luma > hiLuma)
+        {
+            hiLuma = luma;
+            hi     = idx;
+        }
+    }
+
+    uint16_t c0 = pack565(block[hi]);
+    uint16_t c1 = pack565(block[lo]);
+
+    /* c0 > c1 selects four colour mode, equal endpoints encode a flat block */
+    if (c0 < c1)
+    {
+        uint16_t t = c0;
+        c0         = c1;
+        c1         = t;
+    }
+    unpack565(c0, palette[0]);
+    unpack565(c1, palette[1]);
+    for (int c = 0; c < 3; ++c)
+    {
+        palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+        palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+    }
+
+    for (int idx = 0; c0 != c1 && idx < 16; ++idx)
+    {
+        int best = 0, bestError = 1 << 30;
+        for (int p = 0; p < 4; ++p)
+        {
+            int dr = palette[p][0] - block[idx][0], dg = palette[p][1] - block[idx][1], db = palette[p][2] - block[idx][2];
+            int error = dr * dr + dg * dg + db * db;
+            if (error < bestError)
+            {
+                bestError = error;
+                best      = p;
+            }
+        }
+        indices |= (uint32_t)best << (2 * idx);
+    }
+
+    out[0] = c0 & 0xff;
+    out[1] = c0 >> 8;
+    out[2] = c1 & 0xff;
+    out[3] = c1 >> 8;
+    memcpy(out + 4, &indices, 4);
+}
+
+static void compressAlphaBlock(const unsigned char block[16][4], unsigned char *out)
+{
+    int      a0 = 0, a1 = 255, palette[8];
+    uint64_t indices = 0U;
+
+    for (int idx = 0; idx < 16; ++idx)
+    {
+        a0 = block[idx][3] > a0 ? block[idx][3] : a0;
+        a1 = block[idx][3] < a1 ? block[idx][3] : a1;
+    }
+
+    /* a0 > a1 selects eight interpolated values */
+    palette[0] = a0;
+    palette[1] = a1;
+    for (int p = 1; p < 7; ++p)
+        palette[p + 1] = ((7 - p) * a0 + p * a1) / 7;
+
+    for (int idx = 0; a0 != a1 && idx < 16; ++idx)
+    {
+        int best = 0, bestError = 256;
+        for (int p = 0; p < 8; ++p)
+        {
+            int error = abs(palette[p] - block[idx][3]);
+            if (error < bestError)
+            {
+                bestError = error;
+                best      = p;
+            }
+        }
+        indices |= (uint64_t)best << (3 * idx);
+    }
+
+    out[0] = (unsigned char)a0;
+    out[1] = (unsigned char)a1;
+    for (int idx = 0; idx < 6; ++idx)
+        out[2 + idx] = (unsigned char)(indices >> (8 * idx));
+}
+
+static size_t levelSize(enum Format format, uint32_t width, uint32_t height)
+{
+    size_t nBlocks = (size_t)((width + 3U) / 4U) * ((height + 3U) / 4U);
+    switch (format)
+    {
+        case FORMAT_BC1:
+            return nBlocks * 8U;
+        case FORMAT_BC3:
+            return nBlocks * 16U;
+        default:
+            return (size_t)width * height * 4U;
+    }
+}
+
+static void compress(enum Format format, const unsigned char *rgba, uint32_t width, uint32_t height, unsigned char *out)
+{
+    unsigned char block[16][4];
+
+    for (uint32_t by = 0U; by < height; by += 4U)
+    {
+        for (uint32_t bx = 0U; bx < width; bx += 4U)
+        {
+            /* partial blocks at the edge repeat the last texel */
+            for (uint32_t idx = 0U; idx < 16U; ++idx)
+            {
+                uint32_t x = bx + idx % 4U < width ? bx + idx % 4U : width - 1U;
+                uint32_t y = by + idx / 4U < height ? by + idx / 4U : height - 1U;
+                memcpy(block[idx], rgba + 4U * ((size_t)y * width + x), 4);
+            }
+
+            if (FORMAT_BC3 == format)
+            {
+                compressAlphaBlock(block, out);
+                out += 8;
+            }
+            compressColorBlock(block, out);
+            out += 8;
+        }
+    }
+}
+
+static int writeHeader(FILE *pFile, enum Format format, uint32_t width, uint32_t height, uint32_t nLevels)
+{
+    uint32_t header[13] = {KTX_ENDIANNESS, GL_UNSIGNED_BYTE, 1U, GL_RGBA, GL_RGBA8, GL_RGBA, width, height, 0U, 0U, 1U, nLevels, 0U};
+
+    if (FORMAT_RGBA8 != format)
+    {
+        header[1] = 0U; /* glType */
+        header[2] = 1U; /* glTypeSize */
+        header[3] = 0U; /* glFormat */
+        header[4] = FORMAT_BC1 == format ? GL_COMPRESSED_RGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        header[5] = FORMAT_BC1 == format ? GL_RGB : GL_RGBA;
+    }
+
+    return 1 == fwrite(ktxIdentifier, sizeof(ktxIdentifier), 1, pFile) && 1 == fwrite(header, sizeof(header), 1, pFile) ? 0 : -1;
+}
+
+int main(int argc, char *argv[])
+{
+    enum Format    format     = FORMAT_RGBA8;
+    const char    *input      = NULL;
+    const char    *output     = NULL;
+    FILE          *pFile      = NULL;
+    struct Image   level      = {0U, 0U, NULL};
+    struct Image   next       = {0U, 0U, NULL};
+    unsigned char *rgba       = NULL;
+    unsigned char *compressed = NULL;
+    uint32_t       nLevels    = 1U;
+    size_t         nBytes     = 0U;
+    int            width, height, nChannels;
+
+    for (int idx = 1; idx < argc; ++idx)
+    {
+        if (0 == strcmp(argv[idx], "-f") && idx + 1 < argc)
+        {
+            ++idx;
+            if (0 == strcmp(argv[idx], "bc1"))
+                format = FORMAT_BC1;
+            else if (0 == strcmp(argv[idx], "bc3"))
+                format = FORMAT_BC3;
+            else if (0 == strcmp(argv[idx], "rgba8"))
+                format = FORMAT_RGBA8;
+            else
+            {
+                fprintf(stderr, "unknown format %s\n", argv[idx]);
+                return EXIT_FAILURE;
+            }
+        }
+        else if (NULL == input)
+            input = argv[idx];
+        else
+            output = argv[idx];
+    }
+
+    if (NULL == input || NULL == output)
+    {
+        fprintf(stderr, "usage: %s [-f rgba8|bc1|bc3] input output.ktx\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    rgba = stbi_load(input, &width, &height, &nChannels, 4);
+    if (NULL == rgba)
+    {
+        fprintf(stderr, "failed to load %s: %s\n", input, stbi_failure_reason());
+        return EXIT_FAILURE;
+    }
+
+    buildTables();
+    level.width  = width;
+    level.height = height;
+    level.texels = (float *)malloc(sizeof(float) * 4U * width * height);
+    for (size_t idx = 0U; idx < (size_t)width * height; ++idx)
+    {
+        level.texels[4U * idx + 0U] = decodeTable[rgba[4U * idx + 0U]];
+        level.texels[4U * idx + 1U] = decodeTable[rgba[4U * idx + 1U]];
+        level.texels[4U * idx + 2U] = decodeTable[rgba[4U * idx + 2U]];
+        level.texels[4U * idx + 3U] = rgba[4U * idx + 3U] / 255.0f;
+    }
+    stbi_image_free(rgba);
+
+    for (uint32_t w = width, h = height; w > 1U || h > 1U; w = w > 1U ? w / 2U : 1U, h = h > 1U ? h / 2U : 1U)
+        nLevels++;
+
+    pFile = fopen(output, "wb");
+    if (NULL == pFile || 0 != writeHeader(pFile, format, width, height, nLevels))
+    {
+        fprintf(stderr, "failed to write %s\n", output);
+        return EXIT_FAILURE;
+    }
+
+    rgba       = (unsigned char *)malloc(levelSize(FORMAT_RGBA8, width, height));
+    compressed = (unsigned char *)malloc(levelSize(FORMAT_BC3, width, height));
+    for (uint32_t idx = 0U; idx < nLevels; ++idx)
+    {
+        const unsigned char  padding[4] = {0};
+        const unsigned char *data       = rgba;
+        uint32_t             size       = levelSize(format, level.width, level.height);
+
+        encode(&level, rgba);
+        if (FORMAT_RGBA8 != format)
+        {
+            compress(format, rgba, level.width, level.height, compressed);
+            data = compressed;
+        }
+
+        /* image size, image and padding to the next multiple of 4 */
+        fwrite(&size, sizeof(size), 1, pFile);
+        fwrite(data, size, 1, pFile);
+        fwrite(padding, (4U - size % 4U) % 4U, 1, pFile);
+        nBytes += size;
+
+        if (idx + 1U < nLevels)
+        {
+            downsample(&level, &next);
+            free(level.texels);
+            level = next;
+        }
+    }
+
+    free(level.texels);
+    free(rgba);
+    free(compressed);
+    if (0 != fclose(pFile))
+    {
+        fprintf(stderr, "failed to write %s\n", output);
+        return EXIT_FAILURE;
+    }
+
+    printf("%s: %dx%d, %u levels, %zu bytes of texture data\n", output, width, height, nLevels, nBytes);
+    return EXIT_SUCCESS;
+}
@@ -6,8 +6,11 @@ in vec2 TexCoord;
 // texture sampler
 uniform sampler2D texture1;
 
+// Kd and d of the material
+uniform vec4 uDiffuse = vec4(1.0);
+
 void main()
 {
-	FragColor = texture(texture1, TexCoord);
+	FragColor = texture(texture1, TexCoord) * uDiffuse;
 }
 
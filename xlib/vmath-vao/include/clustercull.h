@@ -0,0 +1,66 @@
+#ifndef CLUSTERCULL_H
+#define CLUSTERCULL_H
+/**
+ * @file      clustercull.h
+ * @brief     Frustum and backface culling of model clusters into indirect draws
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <GL/glew.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "model.h"
+#include "vmath.h"
+
+/**
+ * @brief Layout of one draw read by glMultiDrawElementsIndirect
+ */
+struct DrawElementsCommand
+{
+    GLuint count;
+    GLuint instanceCount;
+    GLuint firstIndex;
+    GLint  baseVertex;
+    GLuint baseInstance;
+};
+
+/**
+ * @brief Bounds of all clusters of a model, stored component wise
+ *
+ * Four clusters are tested per SSE instruction, a scalar fallback is used
+ * where SSE is not available.
+ */
+class ClusterCuller
+{
+  public:
+    void initialize(const struct ModelCluster *clusters, uint32_t nClusters);
+    void uninitialize();
+
+    /**
+     * @brief append a draw for every visible cluster of a range
+     *
+     * @param clip     projection * view * model, planes come out in model space
+     * @param eye      eye position in model space
+     * @param commands receives at most count draws
+     * @return number of draws written
+     */
+    uint32_t cull(const vmath::mat4 &clip, const float eye[3], uint32_t first, uint32_t count, DrawElementsCommand *commands) const;
+
+  private:
+    /* padded by three so the last group of four can be loaded whole */
+    std::vector<float>  x, y, z, radius;
+    std::vector<float>  axisX, axisY, axisZ, cutoff;
+    std::vector<GLuint> firstIndex, nIndices;
+};
+
+#endif
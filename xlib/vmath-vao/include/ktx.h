@@ -0,0 +1,76 @@
+#ifndef KTX_H
+#define KTX_H
+/**
+ * @file      ktx.h
+ * @brief     Memory mapped KTX textures with precomputed mip chains
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <cstdint>
+
+/* enough for a 65536x65536 texture */
+#define KTX_MAX_LEVELS 17
+
+/**
+ * @brief One level of the mip chain
+ */
+struct KtxLevel
+{
+    uint32_t width;
+    uint32_t height;
+    uint32_t size;   // bytes of image data
+    size_t   offset; // of image data from KtxFile::data
+};
+
+/**
+ * @brief KTX 1.1 file mapped into memory
+ *
+ * Only 2D textures without array layers or cube faces are accepted, which is
+ * all cook-texture writes.
+ */
+struct KtxFile
+{
+    void                *mapping;
+    size_t               mappingSize;
+    const unsigned char *data;     // first level, image size fields and padding included
+    size_t               dataSize; // bytes from data to end of file
+    GLenum               type;     // 0 for compressed formats
+    GLenum               format;   // 0 for compressed formats
+    GLenum               internalFormat;
+    uint32_t             nLevels;
+    KtxLevel             levels[KTX_MAX_LEVELS];
+};
+
+/**
+ * @brief map a KTX file and validate its level table
+ *
+ * The file is populated on mapping so that the caller, possibly a worker
+ * thread, takes the page faults instead of whoever uploads it.
+ *
+ * @return 0 on success, -1 otherwise
+ */
+int ktxOpen(const char *path, KtxFile *file);
+
+void ktxClose(KtxFile *file);
+
+/**
+ * @brief specify every level of the texture bound to GL_TEXTURE_2D
+ *
+ * @param base file->data to upload from client memory, or the offset at which
+ *             file->data was copied into the bound GL_PIXEL_UNPACK_BUFFER
+ * @return 0 on success, -1 when the format is not supported by the driver
+ */
+int ktxUpload(const KtxFile *file, const unsigned char *base);
+
+#endif
@@ -0,0 +1,139 @@
+#ifndef TEXTURESTREAM_H
+#define TEXTURESTREAM_H
+/**
+ * @file      texturestream.h
+ * @brief     Decode textures on worker threads and upload them through pixel buffer objects
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <GL/glew.h>
+
+#include "ktx.h"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* pixel buffers in flight, an upload waits only when all of them are still read by the GPU */
+#define STREAM_PBO_COUNT 3
+
+/* upper bound of bytes copied into pixel buffers per update() */
+#define STREAM_UPLOAD_BUDGET (4U * 1024U * 1024U)
+
+/**
+ * @brief Image decoded by a worker, waiting for upload
+ */
+struct DecodedImage
+{
+    GLuint         texture;
+    std::string    path;
+    unsigned char *pixels; // RGBA8, owned until uploaded
+    int            width;
+    int            height;
+    KtxFile        ktx;    // cooked texture with its mip chain, mapped when pixels is null
+};
+
+/**
+ * @brief Pixel buffer of the upload ring
+ */
+struct UploadSlot
+{
+    GLuint     buffer;
+    GLsizeiptr size;  // current storage size
+    GLsync     fence; // signalled once the texture copy out of buffer completed
+};
+
+/**
+ * @brief Asynchronous texture loader
+ *
+ * request() hands out a texture name right away, filled with a 1x1 grey
+ * placeholder, and queues the file for decoding on a pool of worker threads.
+ * Files ending in .ktx are cooked offline with every mip level present, the
+ * worker only maps them and the levels are uploaded as stored.
+ *
+ * update() runs on the GL thread once per frame: decoded images are copied
+ * into the next free pixel buffer of a small ring and the texture is
+ * specified from it, so the copy into video memory is performed by the
+ * driver asynchronously. A pixel buffer is reused only after the fence placed
+ * behind its last upload has signalled, the GL thread never waits for it.
+ *
+ * initialize() and prefetch() make no GL calls, decoding can start on any
+ * thread while the context is still being created. A later request() of a
+ * prefetched path takes over its decode instead of queueing another one.
+ */
+class TextureStreamer
+{
+  public:
+    TextureStreamer();
+
+    /**
+     * @brief start the decoder threads, pixel buffers are created with the first upload
+     *
+     * @param nThreads decoder threads, 0 picks one less than the number of cores
+     * @return 0 on success, -1 otherwise
+     */
+    int initialize(uint32_t nThreads = 0U);
+
+    void uninitialize();
+
+    /**
+     * @brief queue a texture for loading
+     *
+     * @return texture name, shows the placeholder until the image is resident
+     */
+    GLuint request(const char *path);
+
+    /**
+     * @brief start decoding a file that will be requested once GL is up, callable from any thread
+     *
+     * The decoded image waits until request() is called with the same path.
+     */
+    void prefetch(const char *path);
+
+    /**
+     * @brief upload images decoded since the last call
+     *
+     * @return number of textures that became resident
+     */
+    uint32_t update();
+
+    /**
+     * @return true when no request is waiting for decode or upload
+     */
+    bool isIdle();
+
+  private:
+    void worker();
+    bool upload(DecodedImage &image);
+    bool adopt(const std::string &path, GLuint texture);
+    static void release(DecodedImage &image);
+
+    std::vector<std::thread> workers;
+    std::mutex               lock;
+    std::condition_variable  wake;
+    std::deque<DecodedImage> decodeQueue; // guarded by lock
+    std::deque<DecodedImage> uploadQueue; // guarded by lock
+    bool                     quit;        // guarded by lock
+    uint32_t                 nDecoding;   // guarded by lock
+
+    /* prefetched images carry texture 0 until request() names them, all guarded by lock */
+    std::vector<std::string>                   inFlight;  // prefetched paths being decoded
+    std::vector<std::pair<std::string, GLuint>> claims;   // names for in flight paths, taken by the worker
+    std::deque<DecodedImage>                   unclaimed; // decoded, not requested yet
+
+    UploadSlot slots[STREAM_PBO_COUNT];
+    uint32_t   nextSlot;
+};
+
+#endif
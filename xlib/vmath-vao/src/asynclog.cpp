@@ -0,0 +1,2 @@
+#define ASYNCLOG_IMPLEMENTATION
+#include "../../benchmark/asynclog.h"
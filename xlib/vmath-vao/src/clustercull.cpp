@@ -0,0 +1,152 @@
+/**
+ * @file      clustercull.cpp
+ * @brief     Frustum and backface culling of model clusters into indirect draws
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <cmath>
+
+#include "clustercull.h"
+
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+
+/* left, right, bottom, top, near, far planes as (a, b, c, d), pointing inwards */
+static void extractPlanes(const vmath::mat4 &clip, float planes[6][4])
+{
+    /* matrix is column major, element [col][row] */
+    for (int plane = 0; plane < 6; ++plane)
+    {
+        int   row  = plane / 2;
+        float sign = (plane & 1) ? -1.0f : 1.0f;
+
+        for (int col = 0; col < 4; ++col)
+            planes[plane][col] = clip[col][3] + sign * clip[col][row];
+
+        float length = sqrtf(planes[plane][0] * planes[plane][0] + planes[plane][1] * planes[plane][1] + planes[plane][2] * planes[plane][2]);
+        for (int col = 0; length > 1e-6f && col < 4; ++col)
+            planes[plane][col] /= length;
+    }
+}
+
+void ClusterCuller::initialize(const struct ModelCluster *clusters, uint32_t nClusters)
+{
+    uninitialize();
+
+    for (uint32_t idx = 0; idx < nClusters + 3U; ++idx)
+    {
+        /* padding clusters are empty and never drawn */
+        static const struct ModelCluster empty = {};
+        const struct ModelCluster       *c     = idx < nClusters ? &clusters[idx] : &empty;
+
+        x.push_back(c->center[0]);
+        y.push_back(c->center[1]);
+        z.push_back(c->center[2]);
+        radius.push_back(c->radius);
+        axisX.push_back(c->coneAxis[0]);
+        axisY.push_back(c->coneAxis[1]);
+        axisZ.push_back(c->coneAxis[2]);
+        cutoff.push_back(idx < nClusters ? c->coneCutoff : 1.0f);
+        firstIndex.push_back(c->firstIndex);
+        nIndices.push_back(c->nIndices);
+    }
+}
+
+void ClusterCuller::uninitialize()
+{
+    x.clear();
+    y.clear();
+    z.clear();
+    radius.clear();
+    axisX.clear();
+    axisY.clear();
+    axisZ.clear();
+    cutoff.clear();
+    firstIndex.clear();
+    nIndices.clear();
+}
+
+#if defined(__SSE__)
+
+uint32_t ClusterCuller::cull(const vmath::mat4 &clip, const float eye[3], uint32_t first, uint32_t count, DrawElementsCommand *commands) const
+{
+    float    planes[6][4];
+    uint32_t nCommands = 0;
+
+    extractPlanes(clip, planes);
+
+    const __m128 ex = _mm_set1_ps(eye[0]);
+    const __m128 ey = _mm_set1_ps(eye[1]);
+    const __m128 ez = _mm_set1_ps(eye[2]);
+
+    for (uint32_t base = first; base < first + count; base += 4)
+    {
+        __m128 cx = _mm_loadu_ps(&x[base]);
+        __m128 cy = _mm_loadu_ps(&y[base]);
+        __m128 cz = _mm_loadu_ps(&z[base]);
+        __m128 r  = _mm_loadu_ps(&radius[base]);
+        __m128 nr = _mm_sub_ps(_mm_setzero_ps(), r);
+        int    culled = 0;
+
+        /* sphere completely behind any plane */
+        for (int plane = 0; plane < 6; ++plane)
+        {
+            __m128 dist = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(planes[plane][0]), cx), _mm_set1_ps(planes[plane][3]));
+            dist        = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(planes[plane][1]), cy));
+            dist        = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(planes[plane][2]), cz));
+            culled |= _mm_movemask_ps(_mm_cmplt_ps(dist, nr));
+        }
+
+        /* every triangle facing away: dot(center - eye, axis) >= cutoff * |center - eye| + radius */
+        __m128 dx  = _mm_sub_ps(cx, ex);
+        __m128 dy  = _mm_sub_ps(cy, ey);
+        __m128 dz  = _mm_sub_ps(cz, ez);
+        __m128 len = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)));
+        __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, _mm_loadu_ps(&axisX[base])), _mm_mul_ps(dy, _mm_loadu_ps(&axisY[base]))), _mm_mul_ps(dz, _mm_loadu_ps(&axisZ[base])));
+        culled |= _mm_movemask_ps(_mm_cmpge_ps(dot, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&cutoff[base]), len), r)));
+
+        for (uint32_t lane = 0; lane < 4 && base + lane < first + count; ++lane)
+        {
+            if (culled & (1 << lane))
+                continue;
+            commands[nCommands++] = {nIndices[base + lane], 1U, firstIndex[base + lane], 0, 0U};
+        }
+    }
+    return nCommands;
+}
+
+#else
+
+uint32_t ClusterCuller::cull(const vmath::mat4 &clip, const float eye[3], uint32_t first, uint32_t count, DrawElementsCommand *commands) const
+{
+    float    planes[6][4];
+    uint32_t nCommands = 0;
+
+    extractPlanes(clip, planes);
+
+    for (uint32_t idx = first; idx < first + count; ++idx)
+    {
+        bool culled = false;
+        for (int plane = 0; plane < 6 && !culled; ++plane)
+            culled = planes[plane][0] * x[idx] + planes[plane][1] * y[idx] + planes[plane][2] * z[idx] + planes[plane][3] < -radius[idx];
+
+        float dx = x[idx] - eye[0], dy = y[idx] - eye[1], dz = z[idx] - eye[2];
+        float len = sqrtf(dx * dx + dy * dy + dz * dz);
+        culled = culled || dx * axisX[idx] + dy * axisY[idx] + dz * axisZ[idx] >= cutoff[idx] * len + radius[idx];
+
+        if (!culled)
+            commands[nCommands++] = {nIndices[idx], 1U, firstIndex[idx], 0, 0U};
+    }
+    return nCommands;
+}
+
+#endif
@@ -0,0 +1,175 @@
+/**
+ * @file      ktx.cpp
+ * @brief     Memory mapped KTX textures with precomputed mip chains
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "ktx.h"
+#include "../../benchmark/asynclog.h"
+
+#define KTX_ENDIANNESS 0x04030201U
+
+static const unsigned char ktxIdentifier[12] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31, 0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+
+/**
+ * @brief header following the identifier, every field little endian
+ */
+struct KtxHeader
+{
+    uint32_t endianness;
+    uint32_t glType;
+    uint32_t glTypeSize;
+    uint32_t glFormat;
+    uint32_t glInternalFormat;
+    uint32_t glBaseInternalFormat;
+    uint32_t pixelWidth;
+    uint32_t pixelHeight;
+    uint32_t pixelDepth;
+    uint32_t numberOfArrayElements;
+    uint32_t numberOfFaces;
+    uint32_t numberOfMipmapLevels;
+    uint32_t bytesOfKeyValueData;
+};
+
+int ktxOpen(const char *path, KtxFile *file)
+{
+    struct stat info;
+    KtxHeader   header;
+
+    memset(file, 0, sizeof(*file));
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        LOG_ERROR("Failed to open %s: %s", path, strerror(errno));
+        return -1;
+    }
+
+    if (0 != fstat(fd, &info) || (size_t)info.st_size < sizeof(ktxIdentifier) + sizeof(header))
+    {
+        LOG_ERROR("Not a KTX file: %s", path);
+        close(fd);
+        return -1;
+    }
+
+    file->mappingSize = info.st_size;
+    file->mapping     = mmap(nullptr, file->mappingSize, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+    close(fd);
+    if (MAP_FAILED == file->mapping)
+    {
+        LOG_ERROR("Failed to map %s: %s", path, strerror(errno));
+        file->mapping = nullptr;
+        return -1;
+    }
+
+    const unsigned char *bytes = (const unsigned char *)file->mapping;
+    memcpy(&header, bytes + sizeof(ktxIdentifier), sizeof(header));
+    if (0 != memcmp(bytes, ktxIdentifier, sizeof(ktxIdentifier)) || KTX_ENDIANNESS != header.endianness)
+    {
+        LOG_ERROR("Not a little endian KTX file: %s", path);
+        ktxClose(file);
+        return -1;
+    }
+
+    if (header.pixelDepth > 1U || header.numberOfArrayElements > 0U || header.numberOfFaces != 1U || 0U == header.pixelHeight)
+    {
+        LOG_ERROR("Only 2D KTX textures are supported: %s", path);
+        ktxClose(file);
+        return -1;
+    }
+
+    file->type           = header.glType;
+    file->format         = header.glFormat;
+    file->internalFormat = header.glInternalFormat;
+    file->nLevels        = header.numberOfMipmapLevels ? header.numberOfMipmapLevels : 1U;
+    if (file->nLevels > KTX_MAX_LEVELS)
+    {
+        LOG_ERROR("Too many mip levels in %s", path);
+        ktxClose(file);
+        return -1;
+    }
+
+    size_t offset = sizeof(ktxIdentifier) + sizeof(header) + header.bytesOfKeyValueData;
+    if (offset > file->mappingSize)
+    {
+        LOG_ERROR("Truncated KTX file: %s", path);
+        ktxClose(file);
+        return -1;
+    }
+    file->data     = bytes + offset;
+    file->dataSize = file->mappingSize - offset;
+
+    /* every level is its 32 bit size followed by the image, padded to 4 bytes */
+    size_t position = 0U;
+    for (uint32_t level = 0U; level < file->nLevels; ++level)
+    {
+        uint32_t size = 0U;
+        if (position + sizeof(size) > file->dataSize)
+            break;
+        memcpy(&size, file->data + position, sizeof(size));
+        position += sizeof(size);
+        if (position + size > file->dataSize)
+            break;
+
+        file->levels[level].width  = header.pixelWidth >> level ? header.pixelWidth >> level : 1U;
+        file->levels[level].height = header.pixelHeight >> level ? header.pixelHeight >> level : 1U;
+        file->levels[level].size   = size;
+        file->levels[level].offset = position;
+        position += (size + 3U) & ~3U;
+
+        if (level + 1U == file->nLevels)
+            return 0;
+    }
+
+    LOG_ERROR("Truncated KTX file: %s", path);
+    ktxClose(file);
+    return -1;
+}
+
+void ktxClose(KtxFile *file)
+{
+    if (file->mapping)
+        munmap(file->mapping, file->mappingSize);
+    memset(file, 0, sizeof(*file));
+}
+
+int ktxUpload(const KtxFile *file, const unsigned char *base)
+{
+    const bool isCompressed = 0U == file->type;
+
+    if (isCompressed && !GLEW_EXT_texture_compression_s3tc)
+    {
+        LOG_ERROR("S3TC compressed textures are not supported by the driver");
+        return -1;
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    for (uint32_t level = 0U; level < file->nLevels; ++level)
+    {
+        const KtxLevel &l = file->levels[level];
+        if (isCompressed)
+            glCompressedTexImage2D(GL_TEXTURE_2D, level, file->internalFormat, l.width, l.height, 0, l.size, base + l.offset);
+        else
+            glTexImage2D(GL_TEXTURE_2D, level, file->internalFormat, l.width, l.height, 0, file->format, file->type, base + l.offset);
+    }
+
+    /* chain may stop short of 1x1, sampling must not reach for missing levels */
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, file->nLevels - 1U);
+    return 0;
+}
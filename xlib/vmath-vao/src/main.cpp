@@ -22,6 +22,13 @@
 #include <cstdio>
 #include <cstdlib>
 #include <iostream>
+#include <unistd.h>
+#include <cmath>
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
 #include "X11/Xlib.h"
 #include "cstdlib"
 #include <GL/glx.h>
@@ -31,58 +38,154 @@
 #include "shader.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include "vmath.h"
-#include "stb_image.h"
+#include "texturestream.h"
+#include "model.h"
+#include "clustercull.h"
+#include "../../benchmark/benchmark.h"
+#include "../../benchmark/gldebug.h"
+#include "../../benchmark/asynclog.h"
+#include "../../benchmark/startup.h"
 
 #define GLX_MAJOR_MIN 1
 #define GLX_MINOR_MIN 2
 
+/* largest acceptable LOD error on screen, in pixels */
+#define LOD_ERROR_PIXELS 1.0f
+
 /**
- * @class Header
- * @brief Header of the Mode hex file
+ * @brief find the diffuse map of a material
+ *
+ * Exporters often write absolute paths of the machine the model was made on,
+ * those fall back to the file name in the working directory. A cooked .ktx
+ * next to the image is preferred.
  *
+ * @return path to load, empty when the material has no usable texture
  */
-struct Header
+static std::string resolveTexture(const char* diffuseMap)
 {
-    /**
-     * @brief total number of vertices in the model
-     */
-    int nVertices;
-
-    /**
-     * @brief total number of indices in the model
-     */
-    int nIndices;
-};
+    if ('\0' == diffuseMap[0])
+        return std::string();
+
+    const char* slash = strrchr(diffuseMap, '/');
+    std::string candidates[2] = {diffuseMap, std::string("./") + (slash ? slash + 1 : diffuseMap)};
+
+    for (const std::string& path : candidates)
+    {
+        std::string cooked = path.substr(0, path.rfind('.')) + ".ktx";
+        if (0 == access(cooked.c_str(), R_OK))
+            return cooked;
+        if (0 == access(path.c_str(), R_OK))
+            return path;
+    }
+    return std::string();
+}
 
 /**
- * @class Vertex
- * @brief Describes the properties of a vertex loaded from model
+ * @brief everything the first frame needs from disk, filled by the loader thread
  */
-struct Vertex
+struct Assets
 {
-    /**
-     * @brief X Co-ordinate of position
-     */
-    float x;
-    /**
-     * @brief Y Co-ordinate of position
-     */
-    float y;
-    /**
-     * @brief Z Co-ordinate of position
-     */
-    float z;
-    /**
-     * @brief U Co-ordinate of texture
-     */
-    float u;
-    /**
-     * @brief V Co-ordinate of texture
-     */
-    float v;
+    struct ModelHeader       header;
+    struct ModelLod          lods[MODEL_MAX_LODS];
+    struct ModelVertex*      vertices;
+    uint32_t*                indices;
+    struct ModelMaterial*    materials;
+    struct ModelSubmesh*     submeshes;
+    struct ModelCluster*     clusters;
+    std::string              defaultTexture;   // shown by materials without a diffuse map
+    std::vector<std::string> materialTextures; // resolved diffuse map per material, empty for none
+    int                      result;           // 0 once everything was read
 };
 
-int main()
+/**
+ * @brief read the model and start decoding its textures
+ *
+ * Runs on a worker while the main thread connects to the display and creates
+ * the context, nothing here may touch Xlib or GL.
+ */
+static void loadAssets(const char* modelFile, Assets* assets, TextureStreamer* streamer, StartupTrace* startup)
+{
+    uint32_t span = startupBegin(startup, "loader", "read model");
+
+    assets->vertices  = NULL;
+    assets->indices   = NULL;
+    assets->materials = NULL;
+    assets->submeshes = NULL;
+    assets->clusters  = NULL;
+    assets->result    = -1;
+
+    FILE* pFile = fopen(modelFile, "rb");
+    if (NULL == pFile)
+    {
+        LOG_ERROR("Failed to read file %s", modelFile);
+        startupEnd(startup, span);
+        return;
+    }
+
+    struct ModelHeader& header = assets->header;
+    if (1 != fread(&header, sizeof(header), 1, pFile) || MODEL_MAGIC != header.magic || MODEL_VERSION != header.version || 0 == header.nLods || MODEL_MAX_LODS < header.nLods)
+    {
+        LOG_ERROR("%s is not a model file, convert it with load-model", modelFile);
+        fclose(pFile);
+        startupEnd(startup, span);
+        return;
+    }
+
+    assets->vertices  = (struct ModelVertex*)malloc(sizeof(struct ModelVertex) * header.nVertices);
+    assets->indices   = (uint32_t*)malloc(sizeof(uint32_t) * header.nIndices);
+    assets->materials = (struct ModelMaterial*)malloc(sizeof(struct ModelMaterial) * header.nMaterials);
+    assets->submeshes = (struct ModelSubmesh*)malloc(sizeof(struct ModelSubmesh) * header.nSubmeshes);
+    assets->clusters  = (struct ModelCluster*)malloc(sizeof(struct ModelCluster) * header.nClusters);
+    if (header.nMaterials != fread(assets->materials, sizeof(struct ModelMaterial), header.nMaterials, pFile) || header.nLods != fread(assets->lods, sizeof(struct ModelLod), header.nLods, pFile) ||
+        header.nSubmeshes != fread(assets->submeshes, sizeof(struct ModelSubmesh), header.nSubmeshes, pFile) || header.nClusters != fread(assets->clusters, sizeof(struct ModelCluster), header.nClusters, pFile) ||
+        header.nVertices != fread(assets->vertices, sizeof(struct ModelVertex), header.nVertices, pFile) || header.nIndices != fread(assets->indices, sizeof(uint32_t), header.nIndices, pFile))
+    {
+        LOG_ERROR("%s is truncated", modelFile);
+        fclose(pFile);
+        startupEnd(startup, span);
+        return;
+    }
+    fclose(pFile);
+    startupEnd(startup, span);
+
+    LOG_INFO("number of vertices: %u", header.nVertices);
+    for (uint32_t lod = 0; lod < header.nLods; ++lod) { LOG_INFO("LOD %u: %u triangles in %u materials, error %f", lod, assets->lods[lod].nIndices / 3, assets->lods[lod].nSubmeshes, assets->lods[lod].error); }
+
+    /* decoding starts now, request() on the GL thread takes over each image later */
+    span = startupBegin(startup, "loader", "resolve textures");
+    assets->defaultTexture = 0 == access("./wall.ktx", R_OK) ? "./wall.ktx" : "./wall.jpg";
+    streamer->prefetch(assets->defaultTexture.c_str());
+
+    std::vector<std::string> prefetched;
+    assets->materialTextures.resize(header.nMaterials);
+    for (uint32_t m = 0; m < header.nMaterials; ++m)
+    {
+        assets->materialTextures[m] = resolveTexture(assets->materials[m].diffuseMap);
+        if (assets->materialTextures[m].empty() || std::find(prefetched.begin(), prefetched.end(), assets->materialTextures[m]) != prefetched.end())
+            continue;
+        prefetched.push_back(assets->materialTextures[m]);
+        streamer->prefetch(assets->materialTextures[m].c_str());
+    }
+    startupEnd(startup, span);
+
+    assets->result = 0;
+}
+
+/**
+ * @brief wait for the loader and release what it read, before returning from a failed startup
+ */
+static void abandonAssets(std::thread& loader, Assets* assets, TextureStreamer* streamer)
+{
+    loader.join();
+    streamer->uninitialize();
+    free(assets->vertices);
+    free(assets->indices);
+    free(assets->materials);
+    free(assets->submeshes);
+    free(assets->clusters);
+}
+
+int main(int argc, char* argv[])
 {
     /* Windowing related variables */
     Display*             dpy              = nullptr; // connection to server
@@ -103,44 +206,60 @@ int main()
     GLint     result       = 0;     // variable to get value returned by APIS
     GLuint    program      = 0U;    // handle of shader program
     GLuint    vertexBuffer = 0U;    // handle of vertex buffer
-    GLuint    texture      = 0U;    // handle to texture
+    GLuint    indexBuffer  = 0U;    // handle of index buffer holding all LODs
+    GLuint    drawBuffer   = 0U;    // handle of indirect buffer with draws of visible clusters
+    GLuint    texture      = 0U;    // handle to texture of materials without their own
     GLboolean shouldDraw   = false; // decide to render or not
 
     /* Variables related to texture */
-    GLint width      = 0; // width of texture
-    GLint height     = 0; // height of texture
-    GLint nrChannels = 0; // number of color channels in image
-
-    struct Vertex* vertices = NULL;
-    struct Header  header;
-    FILE*          pFile = fopen("./model.hex", "rb");
-    if (NULL == pFile)
-    {
-        printf("Failed to read file\n");
-        return EXIT_FAILURE;
-    }
-
-    fread(&header, sizeof(header), 1, pFile);
-    printf("number of vertices: %d\n", header.nVertices);
-    vertices = (struct Vertex*)malloc(sizeof(struct Vertex) * header.nVertices);
-    fread(vertices, sizeof(struct Vertex), header.nVertices, pFile);
-
-    for (uint32_t idx = 0; idx < header.nVertices; ++idx) { printf("[%f %f %f : %f %f]\n", vertices[idx].x, vertices[idx].y, vertices[idx].z, vertices[idx].u, vertices[idx].v); }
-
-    fclose(pFile);
-
+    TextureStreamer streamer;                 // decodes and uploads textures in the background
+    bool            texturesResident = false; // every requested texture uploaded, logged once
+
+    /* Variables related to model */
+    const char*         modelFile = argc > 1 ? argv[1] : "./hammer.model";
+    ClusterCuller        culler;                    // picks visible clusters of the drawn LOD
+    bool                 cullClusters = true;       // toggled with C to compare
+    uint32_t            currentLod = UINT32_MAX;   // LOD drawn in the last frame
+    GLfloat             zoom       = 3.0f;         // eye distance in bounding sphere radii
+
+    /* time to first frame by phase, printed after the first swap */
+    struct StartupTrace startup;
+    startupInit(&startup);
+
+    /* decoder threads need no context, textures decode while the window is created */
+    streamer.initialize();
+
+    /* the model is read on a worker while the display connection and context are created */
+    Assets      assets;
+    std::thread loader(loadAssets, modelFile, &assets, &streamer, &startup);
+
+    struct ModelHeader&    header    = assets.header;
+    struct ModelLod*       lods      = assets.lods;
+    struct ModelVertex*&   vertices  = assets.vertices;
+    uint32_t*&             indices   = assets.indices;
+    struct ModelMaterial*& materials = assets.materials;
+    struct ModelSubmesh*&  submeshes = assets.submeshes;
+    struct ModelCluster*&  clusters  = assets.clusters;
+
+    uint32_t span = startupBegin(&startup, "main", "open display");
     dpy = XOpenDisplay(NULL);
-    if (!glXQueryVersion(dpy, &glxMajor, &glxMinor))
+    if (nullptr == dpy || !glXQueryVersion(dpy, &glxMajor, &glxMinor))
     {
-        std::cerr << "Failed to query glx version\n";
-        exit(EXIT_FAILURE);
+        LOG_ERROR("Failed to query glx version");
+        abandonAssets(loader, &assets, &streamer);
+        if (nullptr != dpy)
+            XCloseDisplay(dpy);
+        return EXIT_FAILURE;
     }
     if (glxMajor < GLX_MAJOR_MIN && glxMinor < GLX_MINOR_MIN)
     {
-        std::cerr << "GLX version >=1.2 is required\n";
-        exit(EXIT_FAILURE);
+        LOG_ERROR("GLX version >=1.2 is required");
+        abandonAssets(loader, &assets, &streamer);
+        XCloseDisplay(dpy);
+        return EXIT_FAILURE;
     }
-    std::cout << "glx version is " << glxMajor << "." << glxMinor << std::endl;
+    LOG_INFO("glx version is %d.%d", glxMajor, glxMinor);
+    startupEnd(&startup, span);
 
     scr  = DefaultScreen(dpy);
     root = XDefaultRootWindow(dpy);
@@ -160,11 +279,14 @@ int main()
     };
     // clang-format on
 
-    vi = glXChooseVisual(dpy, scr, glxAttriutes);
+    span = startupBegin(&startup, "main", "create window");
+    vi   = glXChooseVisual(dpy, scr, glxAttriutes);
     if (nullptr == vi)
     {
-        std::cerr << "Could not create required visual window\n";
-        exit(EXIT_FAILURE);
+        LOG_ERROR("Could not create required visual window");
+        abandonAssets(loader, &assets, &streamer);
+        XCloseDisplay(dpy);
+        return EXIT_FAILURE;
     }
 
     /* set window attributes */
@@ -178,15 +300,28 @@ int main()
     w = XCreateWindow(dpy, root, 0, 0, 1024, 768, 0, vi->depth, InputOutput, vi->visual, CWBackPixel | CWColormap | CWBorderPixel | CWEventMask, &xattr);
     XStoreName(dpy, w, "Rohit Nimkar: OpenGL demo with X11");
 
+    /* register for window close event, mapping now lets the window manager work while GL is set up */
+    wm_delete_window = XInternAtom(dpy, "WM_DELETE_WINDOW", False);
+    XSetWMProtocols(dpy, w, &wm_delete_window, 1);
+    XMapWindow(dpy, w);
+    startupEnd(&startup, span);
+
+    /* debug context reporting performance warnings when GL_DEBUG is set */
+    struct DebugOutput debug;
+
     /* create opengl context */
-    ctxt = glXCreateContext(dpy, vi, nullptr, GL_TRUE);
+    span = startupBegin(&startup, "main", "create context");
+    ctxt = debugOutputCreateContext(&debug, dpy, vi);
     glXMakeCurrent(dpy, w, ctxt);
+    startupEnd(&startup, span);
 
     /* initialize glew */
+    span             = startupBegin(&startup, "main", "glewInit");
     glewExperimental = true;
     if (glewInit() != GLEW_OK)
     {
-        std::cerr << "Failed to initialize glew\n";
+        LOG_ERROR("Failed to initialize glew");
+        abandonAssets(loader, &assets, &streamer);
         XFree(vi);
         XFreeColormap(dpy, xattr.colormap);
         glXDestroyContext(dpy, ctxt);
@@ -195,69 +330,139 @@ int main()
         return -1;
     }
 
+    debugOutputInstall(&debug);
+    startupEnd(&startup, span);
+
     /* free XVisual as it is not required */
     XFree(vi);
     vi = nullptr;
 
+    span = startupBegin(&startup, "main", "wait for loader");
+    loader.join();
+    startupEnd(&startup, span);
+    if (0 != assets.result)
+    {
+        streamer.uninitialize();
+        free(vertices);
+        free(indices);
+        free(materials);
+        free(submeshes);
+        free(clusters);
+        debugOutputReport(&debug, stderr);
+        glXMakeCurrent(dpy, None, nullptr);
+        glXDestroyContext(dpy, ctxt);
+        XFreeColormap(dpy, xattr.colormap);
+        XDestroyWindow(dpy, w);
+        XCloseDisplay(dpy);
+        return EXIT_FAILURE;
+    }
+
     glClearColor(0.0f, 0.0f, 0.4f, 0.0f);
     glEnable(GL_DEPTH_TEST);
     glDepthFunc(GL_LESS);
 
     /* initialize vertex buffer */
+    span = startupBegin(&startup, "main", "upload buffers");
     glGenBuffers(1, &vertexBuffer);
     glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(struct Vertex) * header.nVertices, vertices, GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(struct ModelVertex) * header.nVertices, vertices, GL_STATIC_DRAW);
     glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(struct Vertex), (void*)0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(struct ModelVertex), (void*)0);
 
-    /* load and create texture */
-    glGenTextures(1, &texture);
-    glBindTexture(GL_TEXTURE_2D, texture);
     glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(struct Vertex), (void*)(3 * sizeof(GLfloat)));
-
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(struct ModelVertex), (void*)(3 * sizeof(GLfloat)));
+
+    /* every LOD is a range of this buffer */
+    glGenBuffers(1, &indexBuffer);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint32_t) * header.nIndices, indices, GL_STATIC_DRAW);
+
+    /* one draw per visible cluster, refilled every frame */
+    culler.initialize(clusters, header.nClusters);
+    std::vector<DrawElementsCommand> commands(header.nClusters);
+    std::vector<uint32_t>            submeshDraws(header.nSubmeshes + 1);
+    if (GLEW_VERSION_4_3 || GLEW_ARB_multi_draw_indirect)
+    {
+        glGenBuffers(1, &drawBuffer);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, drawBuffer);
+        glBufferData(GL_DRAW_INDIRECT_BUFFER, sizeof(DrawElementsCommand) * header.nClusters, nullptr, GL_STREAM_DRAW);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0U);
+    }
 
-    /* set the texture wrapping parameters */
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    startupEnd(&startup, span);
 
-    /* set texture filtering parameters */
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    /* texture shows a placeholder until the image is decoded and uploaded, the loader already started decoding */
+    span    = startupBegin(&startup, "main", "create textures");
+    texture = streamer.request(assets.defaultTexture.c_str());
 
-    /* load image, create texture and generate mipmaps */
-    unsigned char* data = stbi_load("./wall.jpg", &width, &height, &nrChannels, 0);
-    if (data)
+    /* one texture per distinct diffuse map, materials without one share the default */
+    std::vector<std::string> texturePaths;
+    std::vector<GLuint>      textures;
+    std::vector<GLuint>      materialTextures(header.nMaterials, texture);
+    for (uint32_t m = 0; m < header.nMaterials; ++m)
     {
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
-        glGenerateMipmap(GL_TEXTURE_2D);
-    }
-    else
-    {
-        std::cout << "Failed to load texture" << std::endl;
+        const std::string& path = assets.materialTextures[m];
+        if (path.empty())
+            continue;
+
+        size_t idx = 0;
+        while (idx < texturePaths.size() && texturePaths[idx] != path) { ++idx; }
+        if (idx == texturePaths.size())
+        {
+            texturePaths.push_back(path);
+            textures.push_back(streamer.request(path.c_str()));
+        }
+        materialTextures[m] = textures[idx];
     }
-    stbi_image_free(data);
+
+    startupEnd(&startup, span);
 
     // Create and compile our GLSL program from the shaders
+    span   = startupBegin(&startup, "main", "compile shaders");
     result = LoadShaders("vertex.glsl", "fragment.glsl", &program);
+    startupEnd(&startup, span);
 
     if (GL_TRUE != result)
     {
-        std::cerr << "Failed to link program\n";
+        LOG_ERROR("Failed to link program");
+        culler.uninitialize();
+        streamer.uninitialize();
+        glDeleteBuffers(1, &drawBuffer);
+        glDeleteBuffers(1, &indexBuffer);
+        glDeleteBuffers(1, &vertexBuffer);
+        glDeleteTextures(1, &texture);
+        glDeleteTextures((GLsizei)textures.size(), textures.data());
+        free(vertices);
+        free(indices);
+        free(materials);
+        free(submeshes);
+        free(clusters);
+        debugOutputReport(&debug, stderr);
+        glXMakeCurrent(dpy, None, nullptr);
+        glXDestroyContext(dpy, ctxt);
+        XFreeColormap(dpy, xattr.colormap);
+        XDestroyWindow(dpy, w);
+        XCloseDisplay(dpy);
         return -1;
     }
 
-    /* register for window close event */
-    wm_delete_window = XInternAtom(dpy, "WM_DELETE_WINDOW", False);
-    XSetWMProtocols(dpy, w, &wm_delete_window, 1);
-    XMapWindow(dpy, w);
+    span = startupBegin(&startup, "main", "wait for expose");
 
     /* generate transformation matrix */
     GLuint      MatrixID   = glGetUniformLocation(program, "MVP");
+    GLint       DiffuseID  = glGetUniformLocation(program, "uDiffuse");
     vmath::mat4 Projection = vmath::perspective(45.0f, 4.0f / 3.0f, 0.1f, 100.0f);
-    vmath::mat4 View       = vmath::lookat(vmath::vec3(1.0f, 3.0f, 5.0f), vmath::vec3(0.0f, 0.0f, 0.0f), vmath::vec3(0.0f, 1.0f, 0.0f));
+    vmath::mat4 View       = vmath::mat4::identity();
     vmath::mat4 Model      = vmath::mat4::identity();
     vmath::mat4 MVP        = Projection * View * Model;
+
+    /* pixels covered by one unit at distance one, for a 768 pixel high window */
+    const GLfloat pixelsPerUnit = 768.0f / (2.0f * tanf(vmath::radians(45.0f) / 2.0f));
+    const GLfloat radius        = header.radius > 0.0f ? header.radius : 1.0f;
+    /* fixed workload with timing report when BENCHMARK_FRAMES is set */
+    struct Benchmark bench;
+    benchmarkInit(&bench, "vmath-vao");
+
     while (!globalAbortFlag)
     {
         XEvent evt;
@@ -269,7 +474,10 @@ int main()
                 case Expose:
                 {
                     if (!shouldDraw)
+                    {
                         shouldDraw = true;
+                        startupEnd(&startup, span);
+                    }
                     break;
                 }
                 case ClientMessage:
@@ -288,14 +496,27 @@ int main()
                         globalAbortFlag = true;
                         shouldDraw      = false;
                     }
+                    else if (XK_Up == sym)
+                    {
+                        zoom = zoom > 1.25f ? zoom / 1.25f : zoom;
+                    }
+                    else if (XK_Down == sym)
+                    {
+                        zoom = zoom * 1.25f;
+                    }
+                    else if (XK_c == sym)
+                    {
+                        cullClusters = !cullClusters;
+                        LOG_INFO("cluster culling %s", cullClusters ? "on" : "off");
+                    }
                     break;
                 }
                 case MapNotify:
                 {
-                    std::cout << "GL Vendor: " << glGetString(GL_VENDOR) << "\n";
-                    std::cout << "GL Renderer: " << glGetString(GL_RENDERER) << "\n";
-                    std::cout << "GL Version: " << glGetString(GL_VERSION) << "\n";
-                    std::cout << "GL Shading Language: " << glGetString(GL_SHADING_LANGUAGE_VERSION) << "\n";
+                    LOG_INFO("GL Vendor: %s", glGetString(GL_VENDOR));
+                    LOG_INFO("GL Renderer: %s", glGetString(GL_RENDERER));
+                    LOG_INFO("GL Version: %s", glGetString(GL_VERSION));
+                    LOG_INFO("GL Shading Language: %s", glGetString(GL_SHADING_LANGUAGE_VERSION));
                     break;
                 }
                 default:
@@ -306,8 +527,13 @@ int main()
             }
         }
 
+        /* upload textures decoded since the last frame */
+        streamer.update();
+
         if (!shouldDraw)
             continue;
+        benchmarkBeginFrame(&bench);
+        benchmarkPhase(&bench, "update");
 
         /* redraw frame */
         // std::cout << "redrawing frame" << std::endl;
@@ -316,27 +542,115 @@ int main()
 
         static GLfloat theta = 3;
         theta += 0.5;
-        Model = vmath::translate(0.0f, 0.0f, 0.0f) * vmath::rotate(theta, 0.0f, 1.0f, 0.0f) * vmath::scale(1.0f, 1.0f, 1.0f);
+        Model = vmath::rotate(theta, 0.0f, 1.0f, 0.0f) * vmath::translate(-header.center[0], -header.center[1], -header.center[2]);
+        View  = vmath::lookat(vmath::normalize(vmath::vec3(1.0f, 3.0f, 5.0f)) * (zoom * radius), vmath::vec3(0.0f, 0.0f, 0.0f), vmath::vec3(0.0f, 1.0f, 0.0f));
         MVP   = Projection * View * Model;
 
+        /* coarsest LOD whose error stays below a pixel at the nearest point of the bounding sphere */
+        uint32_t lod = modelSelectLod(lods, header.nLods, pixelsPerUnit, (zoom - 1.0f) * radius, LOD_ERROR_PIXELS);
+        if (lod != currentLod)
+        {
+            LOG_INFO("drawing LOD %u with %u triangles", lod, lods[lod].nIndices / 3);
+            currentLod = lod;
+        }
+
         glUseProgram(program);
         glEnableVertexAttribArray(1);
-        glBindTexture(GL_TEXTURE_2D, texture);
         glUniformMatrix4fv(MatrixID, 1, GL_FALSE, &MVP[0][0]);
 
         /* enable vertex buffer */
         glEnableVertexAttribArray(0);
         glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+
+        benchmarkPhase(&bench, "cull");
+        /* clusters outside the frustum or facing away are not submitted */
+        vmath::mat4 toModel = vmath::translate(header.center[0], header.center[1], header.center[2]) * vmath::rotate(-theta, 0.0f, 1.0f, 0.0f);
+        vmath::vec3 eye     = vmath::normalize(vmath::vec3(1.0f, 3.0f, 5.0f)) * (zoom * radius);
+        vmath::vec4 local   = toModel[0] * eye[0] + toModel[1] * eye[1] + toModel[2] * eye[2] + toModel[3];
+        const float eyeModel[3] = {local[0], local[1], local[2]};
+
+        /* draws of all submeshes back to back, submeshDraws[s] is where those of s start */
+        uint32_t nDraws = 0;
+        for (uint32_t s = 0; s < lods[lod].nSubmeshes; ++s)
+        {
+            const struct ModelSubmesh* submesh = &submeshes[lods[lod].firstSubmesh + s];
+            submeshDraws[s]                    = nDraws;
+            if (cullClusters)
+            {
+                nDraws += culler.cull(MVP, eyeModel, submesh->firstCluster, submesh->nClusters, &commands[nDraws]);
+                continue;
+            }
 
-        glDrawArrays(GL_TRIANGLES, 0, header.nVertices);
+            for (uint32_t idx = 0; idx < submesh->nClusters; ++idx)
+            {
+                const struct ModelCluster* c = &clusters[submesh->firstCluster + idx];
+                commands[nDraws++]           = {c->nIndices, 1U, c->firstIndex, 0, 0U};
+            }
+        }
+        submeshDraws[lods[lod].nSubmeshes] = nDraws;
+
+        benchmarkPhase(&bench, "render");
+        if (drawBuffer)
+        {
+            /* orphan last frame's draws instead of waiting for the GPU to finish reading them */
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, drawBuffer);
+            glBufferData(GL_DRAW_INDIRECT_BUFFER, sizeof(DrawElementsCommand) * header.nClusters, nullptr, GL_STREAM_DRAW);
+            glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, sizeof(DrawElementsCommand) * nDraws, commands.data());
+        }
+
+        /* submeshes are sorted by material, each material is bound once */
+        uint32_t boundMaterial = UINT32_MAX;
+        for (uint32_t s = 0; s < lods[lod].nSubmeshes; ++s)
+        {
+            const struct ModelSubmesh*  submesh  = &submeshes[lods[lod].firstSubmesh + s];
+            const struct ModelMaterial* material = &materials[submesh->material];
+            GLsizei                     count    = submeshDraws[s + 1] - submeshDraws[s];
+            if (0 == count)
+                continue;
+
+            if (submesh->material != boundMaterial)
+            {
+                glBindTexture(GL_TEXTURE_2D, materialTextures[submesh->material]);
+                glUniform4f(DiffuseID, material->diffuse[0], material->diffuse[1], material->diffuse[2], material->opacity);
+                boundMaterial = submesh->material;
+            }
+
+            if (drawBuffer)
+            {
+                glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, (void*)(sizeof(DrawElementsCommand) * submeshDraws[s]), count, 0);
+                continue;
+            }
+            for (uint32_t idx = submeshDraws[s]; idx < submeshDraws[s + 1]; ++idx) { glDrawElements(GL_TRIANGLES, commands[idx].count, GL_UNSIGNED_INT, (void*)(sizeof(uint32_t) * commands[idx].firstIndex)); }
+        }
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0U);
+        benchmarkPhase(&bench, "swap");
         glXSwapBuffers(dpy, w);
+        startupFirstFrame(&startup);
+        if (!texturesResident && streamer.isIdle())
+        {
+            LOG_INFO("textures resident %.1f ms after start", startupElapsedMs(&startup));
+            texturesResident = true;
+        }
+        if (benchmarkEndFrame(&bench))
+            globalAbortFlag = true;
     }
 
     free(vertices);
+    free(indices);
+    free(materials);
+    free(submeshes);
+    free(clusters);
     /* resource cleanup */
+    culler.uninitialize();
+    streamer.uninitialize();
+    glDeleteBuffers(1, &drawBuffer);
+    glDeleteBuffers(1, &indexBuffer);
     glDeleteBuffers(1, &vertexBuffer);
     glDeleteTextures(1, &texture);
+    glDeleteTextures((GLsizei)textures.size(), textures.data());
     glDeleteProgram(program);
+    debugOutputReport(&debug, stderr);
     glXDestroyContext(dpy, ctxt);
     XFreeColormap(dpy, xattr.colormap);
     XDestroyWindow(dpy, w);
@@ -1,10 +1,19 @@
 #include <string>
-#include <iostream>
 #include <fstream>
 #include <algorithm>
 #include <sstream>
+#include <cstring>
 #include "shader.h"
+#include "../../benchmark/asynclog.h"
 #include <GL/gl.h>
+
+/* one message per line, string arguments of a message are kept up to a line's length */
+static void logInfoLog(char *log)
+{
+    for (char *line = strtok(log, "\n"); NULL != line; line = strtok(NULL, "\n"))
+        LOG_ERROR("%s", line);
+}
+
 GLuint LoadShaders(const char* vertex_file_path, const char* fragment_file_path, GLuint* pProgram)
 {
     // Create the shaders
@@ -18,14 +27,13 @@ GLuint LoadShaders(const char* vertex_file_path, const char* fragment_file_path,
     result = loadShader(fragmentShader, fragment_file_path);
     if (GL_TRUE != result)
     {
-        std::cout << "Deleting vertex shader\n";
+        LOG_DEBUG("Deleting vertex shader");
         glDeleteShader(vertexShader);
-        std::cout << "Deleting vertex shader\n";
         return (result);
     }
 
     // Link the program
-    std::cout << "Linking program\n";
+    LOG_INFO("Linking program");
     *pProgram = glCreateProgram();
     glAttachShader(*pProgram, vertexShader);
     glAttachShader(*pProgram, fragmentShader);
@@ -37,13 +45,13 @@ GLuint LoadShaders(const char* vertex_file_path, const char* fragment_file_path,
     {
         // linking Failed
         int infoLogLen = 0;
-        std::cerr << "Failed to link program\nwooreogieogieroigeorni";
+        LOG_ERROR("Failed to link program");
         glGetProgramiv(*pProgram, GL_INFO_LOG_LENGTH, &infoLogLen);
         if (infoLogLen > 0)
         {
             char msg[infoLogLen + 1];
             glGetProgramInfoLog(*pProgram, infoLogLen, nullptr, msg);
-            std::cerr << msg << std::endl;
+            logInfoLog(msg);
         }
         return (result);
     }
@@ -72,12 +80,12 @@ GLint loadShader(GLuint shaderId, const char* pFilename)
     }
     else
     {
-        std::cerr << "failed to read shader" << pFilename << std::endl;
+        LOG_ERROR("failed to read shader %s", pFilename);
         return (GL_FALSE);
     }
 
     // Compile shader
-    std::cout << "Compiling shader: " << pFilename << std::endl;
+    LOG_INFO("Compiling shader: %s", pFilename);
     char const* pSourceCode = sourceString.c_str();
     glShaderSource(shaderId, 1, &pSourceCode, NULL);
     glCompileShader(shaderId);
@@ -87,14 +95,14 @@ GLint loadShader(GLuint shaderId, const char* pFilename)
     if (GL_TRUE != result)
     {
         int infoLogLen = 0;
-        std::cerr << "Failed to compile shader: " << pFilename << std::endl;
+        LOG_ERROR("Failed to compile shader: %s", pFilename);
 
         glGetShaderiv(shaderId, GL_INFO_LOG_LENGTH, &infoLogLen);
         if (infoLogLen > 0)
         {
             char msg[infoLogLen];
             glGetShaderInfoLog(shaderId, infoLogLen, NULL, msg);
-            std::cerr << msg << std::endl;
+            logInfoLog(msg);
         }
     }
     return (result);
@@ -0,0 +1,341 @@
+/**
+ * @file      texturestream.cpp
+ * @brief     Decode textures on worker threads and upload them through pixel buffer objects
+ * @author    Rohit Nimkar
+ * @version   1.0
+ * @date      2026-10-19
+ * @copyright Copyright 2026 Rohit Nimkar
+ *
+ * @attention
+ *  Use of this source code is governed by a BSD-style
+ *  license that can be found in the LICENSE file or at
+ *  opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include "stb_image.h"
+#include "texturestream.h"
+#include "../../benchmark/asynclog.h"
+
+/* decoded images are always expanded to RGBA, rows stay 4 byte aligned */
+#define STREAM_CHANNELS 4
+
+TextureStreamer::TextureStreamer() : quit(false), nDecoding(0U), nextSlot(0U)
+{
+    for (int idx = 0; idx < STREAM_PBO_COUNT; ++idx)
+    {
+        slots[idx].buffer = 0U;
+        slots[idx].size   = 0;
+        slots[idx].fence  = nullptr;
+    }
+}
+
+int TextureStreamer::initialize(uint32_t nThreads)
+{
+    if (0U == nThreads)
+    {
+        uint32_t nCores = std::thread::hardware_concurrency();
+        nThreads        = nCores > 1U ? nCores - 1U : 1U;
+    }
+
+    quit = false;
+    for (uint32_t idx = 0U; idx < nThreads; ++idx)
+        workers.push_back(std::thread(&TextureStreamer::worker, this));
+
+    LOG_INFO("Texture streamer: %u decoder threads, %d pixel buffers", nThreads, STREAM_PBO_COUNT);
+    return 0;
+}
+
+void TextureStreamer::uninitialize()
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        quit = true;
+    }
+    wake.notify_all();
+    for (size_t idx = 0U; idx < workers.size(); ++idx)
+        workers[idx].join();
+    workers.clear();
+
+    /* images decoded but never uploaded */
+    for (size_t idx = 0U; idx < uploadQueue.size(); ++idx)
+        release(uploadQueue[idx]);
+    for (size_t idx = 0U; idx < unclaimed.size(); ++idx)
+        release(unclaimed[idx]);
+    uploadQueue.clear();
+    unclaimed.clear();
+    decodeQueue.clear();
+    inFlight.clear();
+    claims.clear();
+
+    for (int idx = 0; idx < STREAM_PBO_COUNT; ++idx)
+    {
+        if (slots[idx].fence)
+        {
+            glDeleteSync(slots[idx].fence);
+            slots[idx].fence = nullptr;
+        }
+        if (slots[idx].buffer)
+        {
+            glDeleteBuffers(1, &slots[idx].buffer);
+            slots[idx].buffer = 0U;
+        }
+        slots[idx].size = 0;
+    }
+}
+
+GLuint TextureStreamer::request(const char *path)
+{
+    const unsigned char placeholder[STREAM_CHANNELS] = {0x80, 0x80, 0x80, 0xff};
+    GLuint              texture                      = 0U;
+
+    /* a 1x1 level is a complete mip chain, the texture can be sampled right away */
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, placeholder);
+    glBindTexture(GL_TEXTURE_2D, 0U);
+
+    DecodedImage image;
+    image.texture = texture;
+    image.path    = path;
+    image.pixels  = nullptr;
+    image.width   = 0;
+    image.height  = 0;
+    memset(&image.ktx, 0, sizeof(image.ktx));
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (adopt(image.path, texture))
+            return texture;
+        decodeQueue.push_back(image);
+    }
+    wake.notify_one();
+    return texture;
+}
+
+void TextureStreamer::prefetch(const char *path)
+{
+    DecodedImage image;
+    image.texture = 0U;
+    image.path    = path;
+    image.pixels  = nullptr;
+    image.width   = 0;
+    image.height  = 0;
+    memset(&image.ktx, 0, sizeof(image.ktx));
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        decodeQueue.push_back(image);
+    }
+    wake.notify_one();
+}
+
+/* name a prefetched image wherever it is, called with lock held */
+bool TextureStreamer::adopt(const std::string &path, GLuint texture)
+{
+    for (size_t idx = 0U; idx < decodeQueue.size(); ++idx)
+    {
+        if (0U == decodeQueue[idx].texture && decodeQueue[idx].path == path)
+        {
+            decodeQueue[idx].texture = texture;
+            return true;
+        }
+    }
+    for (size_t idx = 0U; idx < uploadQueue.size(); ++idx)
+    {
+        if (0U == uploadQueue[idx].texture && uploadQueue[idx].path == path)
+        {
+            uploadQueue[idx].texture = texture;
+            return true;
+        }
+    }
+    for (size_t idx = 0U; idx < unclaimed.size(); ++idx)
+    {
+        if (unclaimed[idx].path == path)
+        {
+            unclaimed[idx].texture = texture;
+            uploadQueue.push_back(unclaimed[idx]);
+            unclaimed.erase(unclaimed.begin() + idx);
+            return true;
+        }
+    }
+    for (size_t idx = 0U; idx < inFlight.size(); ++idx)
+    {
+        if (inFlight[idx] == path)
+        {
+            claims.push_back(std::make_pair(path, texture));
+            return true;
+        }
+    }
+    return false;
+}
+
+void TextureStreamer::worker()
+{
+    std::unique_lock<std::mutex> guard(lock);
+
+    while (true)
+    {
+        while (!quit && decodeQueue.empty())
+            wake.wait(guard);
+        if (quit)
+            return;
+
+        DecodedImage image = decodeQueue.front();
+        decodeQueue.pop_front();
+        nDecoding++;
+        if (0U == image.texture)
+            inFlight.push_back(image.path);
+        guard.unlock();
+
+        bool   isLoaded = false;
+        size_t length   = image.path.size();
+        if (length > 4U && 0 == image.path.compare(length - 4U, 4U, ".ktx"))
+        {
+            isLoaded = 0 == ktxOpen(image.path.c_str(), &image.ktx);
+        }
+        else
+        {
+            int nChannels = 0;
+            image.pixels  = stbi_load(image.path.c_str(), &image.width, &image.height, &nChannels, STREAM_CHANNELS);
+            isLoaded      = nullptr != image.pixels;
+            if (!isLoaded)
+                LOG_ERROR("Failed to load texture %s: %s", image.path.c_str(), stbi_failure_reason());
+        }
+
+        guard.lock();
+        nDecoding--;
+        if (0U == image.texture)
+        {
+            /* request() may have named the image while it was decoded */
+            inFlight.erase(std::find(inFlight.begin(), inFlight.end(), image.path));
+            for (size_t idx = 0U; idx < claims.size(); ++idx)
+            {
+                if (claims[idx].first == image.path)
+                {
+                    image.texture = claims[idx].second;
+                    claims.erase(claims.begin() + idx);
+                    break;
+                }
+            }
+        }
+        if (isLoaded)
+            uploadQueue.push_back(image);
+    }
+}
+
+void TextureStreamer::release(DecodedImage &image)
+{
+    if (image.pixels)
+    {
+        stbi_image_free(image.pixels);
+        image.pixels = nullptr;
+    }
+    else
+    {
+        ktxClose(&image.ktx);
+    }
+}
+
+bool TextureStreamer::upload(DecodedImage &image)
+{
+    UploadSlot      &slot = slots[nextSlot];
+    const GLsizeiptr size = image.pixels ? (GLsizeiptr)image.width * image.height * STREAM_CHANNELS : (GLsizeiptr)image.ktx.dataSize;
+
+    if (0U == slot.buffer)
+        glGenBuffers(1, &slot.buffer);
+
+    if (slot.fence)
+    {
+        /* never block, the image waits for the next frame instead */
+        GLenum status = glClientWaitSync(slot.fence, 0, 0U);
+        if (GL_TIMEOUT_EXPIRED == status)
+            return false;
+        glDeleteSync(slot.fence);
+        slot.fence = nullptr;
+    }
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.buffer);
+    if (slot.size < size)
+    {
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+        slot.size = size;
+    }
+
+    /* the fence guarantees the previous copy out of this buffer is done */
+    void *pDst = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    if (nullptr == pDst)
+    {
+        LOG_ERROR("Failed to map pixel buffer for %s", image.path.c_str());
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0U);
+        return true;
+    }
+    memcpy(pDst, image.pixels ? image.pixels : image.ktx.data, size);
+    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+    /* source is an offset into the bound pixel buffer, the call returns without waiting for the copy */
+    glBindTexture(GL_TEXTURE_2D, image.texture);
+    if (image.pixels)
+    {
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, image.width, image.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, (const void *)0);
+        glGenerateMipmap(GL_TEXTURE_2D);
+    }
+    else if (0 != ktxUpload(&image.ktx, (const unsigned char *)0))
+    {
+        LOG_ERROR("Failed to upload %s", image.path.c_str());
+    }
+    glBindTexture(GL_TEXTURE_2D, 0U);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0U);
+
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    nextSlot   = (nextSlot + 1U) % STREAM_PBO_COUNT;
+    return true;
+}
+
+uint32_t TextureStreamer::update()
+{
+    uint32_t nResident = 0U;
+    size_t   nBytes    = 0U;
+
+    while (nBytes < STREAM_UPLOAD_BUDGET)
+    {
+        DecodedImage image;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (uploadQueue.empty())
+                break;
+            image = uploadQueue.front();
+            uploadQueue.pop_front();
+
+            /* prefetched and not requested yet, kept until request() names it */
+            if (0U == image.texture)
+            {
+                unclaimed.push_back(image);
+                continue;
+            }
+        }
+
+        if (!upload(image))
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            uploadQueue.push_front(image);
+            break;
+        }
+
+        nBytes += image.pixels ? (size_t)image.width * image.height * STREAM_CHANNELS : image.ktx.dataSize;
+        release(image);
+        nResident++;
+    }
+    return nResident;
+}
+
+bool TextureStreamer::isIdle()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return decodeQueue.empty() && uploadQueue.empty() && 0U == nDecoding;
+}
@@ -32,6 +32,8 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include "vmath.h"
 #include "stb_image.h"
+#include "../../benchmark/benchmark.h"
+#include "../../benchmark/gldebug.h"
 
 #define GLX_MAJOR_MIN 1
 #define GLX_MINOR_MIN 2
@@ -222,8 +224,11 @@ int main()
     w = XCreateWindow(dpy, root, 0, 0, 1024, 768, 0, vi->depth, InputOutput, vi->visual, CWBackPixel | CWColormap | CWBorderPixel | CWEventMask, &xattr);
     XStoreName(dpy, w, "Rohit Nimkar: OpenGL demo with X11");
 
+    /* debug context reporting performance warnings when GL_DEBUG is set */
+    struct DebugOutput debug;
+
     /* create opengl context */
-    ctxt = glXCreateContext(dpy, vi, nullptr, GL_TRUE);
+    ctxt = debugOutputCreateContext(&debug, dpy, vi);
     glXMakeCurrent(dpy, w, ctxt);
 
     /* initialize glew */
@@ -239,6 +244,8 @@ int main()
         return -1;
     }
 
+    debugOutputInstall(&debug);
+
     /* free XVisual as it is not required */
     XFree(vi);
     vi = nullptr;
@@ -316,6 +323,10 @@ int main()
     //
     vmath::mat4 Model = vmath::mat4::identity();
     vmath::mat4 MVP   = Projection * View * Model;
+    /* fixed workload with timing report when BENCHMARK_FRAMES is set */
+    struct Benchmark bench;
+    benchmarkInit(&bench, "vmath");
+
     while (!globalAbortFlag)
     {
         XEvent evt;
@@ -366,10 +377,13 @@ int main()
 
         if (!shouldDraw)
             continue;
+        benchmarkBeginFrame(&bench);
+        benchmarkPhase(&bench, "update");
 
         /* redraw frame */
         // std::cout << "redrawing frame" << std::endl;
 
+        benchmarkPhase(&bench, "render");
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
         static GLfloat theta = 3;
@@ -396,13 +410,17 @@ int main()
         // glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 0, (void*)0);
 
         glDrawArrays(GL_TRIANGLES, 0, header.nVertex);
+        benchmarkPhase(&bench, "swap");
         glXSwapBuffers(dpy, w);
+        if (benchmarkEndFrame(&bench))
+            globalAbortFlag = true;
     }
 
     free(vertices);
     /* resource cleanup */
     glDeleteBuffers(1, &vertexBuffer);
     glDeleteProgram(program);
+    debugOutputReport(&debug, stderr);
     glXDestroyContext(dpy, ctxt);
     XFreeColormap(dpy, xattr.colormap);
     XDestroyWindow(dpy, w);